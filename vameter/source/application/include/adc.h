@@ -7,6 +7,15 @@
  **
  ** Revision
  **   10-Oct-2020 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Integer RMS, no libm
+ **   18-Oct-2026 (SSB) [] Single pass window statistics
+ **   18-Oct-2026 (SSB) [] Zero crossing synchronised AC mode
+ **   18-Oct-2026 (SSB) [] Power and energy metering
+ **   18-Oct-2026 (SSB) [] Runtime sample rate, boxcar decimation
+ **   18-Oct-2026 (SSB) [] DMA half selection from HAL callbacks
+ **   18-Oct-2026 (SSB) [] Save energy total every minute
+ **   18-Oct-2026 (SSB) [] RMS in mV and mA
+ **   18-Oct-2026 (SSB) [] Gain and offset calibration, auto-zero
  **/
 
 #ifndef __ADC_H__
@@ -17,23 +26,183 @@
 #include <stm32f1xx_hal.h>
 
 #define ADC_DMA_BUFF_SIZE (512)
+#define ADC_CH_NUM        (2)   /* Interleaved channels in DMA buffer */
+#define ADC_CH_I          (0)   /* Current channel, PA0 */
+#define ADC_CH_V          (1)   /* Voltage channel, PA2 */
+#define ADC_ACS71240_ZERO (2048)
+#define ADC_CREST_Q       (8)   /* Crest factor fractional bits */
+#define ADC_WIN_MAX       (65535)
+#define ADC_RATE_DEF      (2400) /* Trigger rate, samples/s per channel */
+#define ADC_RATE_MAX      (300000) /* 12 MHz ADC clock, 2 x 20 cycles scan */
+#define ADC_DEC_MAX       (3)    /* Max decimation 4^3, 3 extra bits */
+#define ADC_BENCH_RUNS    (16)   /* Half buffers timed by adc_bench() */
 
+#define ADC_DC_SAMPLES_DEF (128) /* DC mode window length */
+#define ADC_AC_PERIODS_DEF (5)   /* AC mode window length in mains periods */
+#define ADC_AC_PERIODS_MAX (50)
+#define ADC_AC_FREQ_MIN    (40)  /* Hz, longer periods close on timeout */
+#define ADC_ZC_HYST        (16)  /* Zero crossing hysteresis, ADC counts */
+#define ADC_ZC_Q           (8)   /* Crossing time fractional bits */
+
+/* Nominal front end scaling, ACS71240 30 A at 3.3 V (44 mV/A) and a 1:10
+ * voltage divider, both on a 3.3 V reference.
+ */
+#define ADC_I_SCALE_UA     (18311) /* uA per count */
+#define ADC_V_SCALE_UV     (8057)  /* uV per count */
+#define ADC_VI_SCALE_NW    ((int64_t) ADC_I_SCALE_UA * ADC_V_SCALE_UV / 1000)
+
+#define ADC_ENERGY_SAVE_S  (60)    /* Energy total flash save period */
+
+#define ADC_CAL_ZERO_Q     (4)     /* Zero point fractional bits */
+#define ADC_CAL_GAIN_Q     (16)    /* Gain fractional bits */
+#define ADC_CAL_GAIN_MIN   (1UL << ( ADC_CAL_GAIN_Q - 1 ))   /* 0.5 */
+#define ADC_CAL_GAIN_MAX   (3UL << ( ADC_CAL_GAIN_Q - 1 ))   /* 1.5 */
+#define ADC_CAL_SAMPLES    (4096)  /* Default averaging length */
+#define ADC_CAL_POINTS     (2)
+
+typedef enum
+{
+    ADC_MODE_DC = 0,        /* Fixed number of samples per window */
+    ADC_MODE_AC             /* Whole mains periods per window */
+} Adc_Mode_t;
+
+/* Measurement configuration, stored in the flash user page */
+typedef struct
+{
+    uint32_t magic;
+    uint8_t  mode;          /* Adc_Mode_t */
+    uint8_t  ref_ch;        /* Zero crossing reference channel */
+    uint16_t periods;       /* AC mode periods per window */
+    uint16_t samples;       /* DC mode samples per window */
+    uint16_t hyst;          /* Zero crossing hysteresis, ADC counts */
+    uint8_t  dec;           /* Decimation ratio is 4^dec */
+    uint8_t  reserved;
+    uint32_t rate;          /* Trigger rate, samples/s per channel */
+} Adc_Cfg_t;
+
+/* Calibration, stored in the flash user page. Zero is the raw reading at
+ * no load, gain corrects the nominal scale, see ADC_I_SCALE_UA.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint16_t zero[ADC_CH_NUM];  /* ADC counts, ADC_CAL_ZERO_Q */
+    uint32_t gain[ADC_CH_NUM];  /* ADC_CAL_GAIN_Q */
+} Adc_Cal_t;
+
+typedef enum
+{
+    ADC_CAL_IDLE = 0,
+    ADC_CAL_BUSY,           /* Averaging samples */
+    ADC_CAL_DONE,           /* Step finished, not saved yet */
+    ADC_CAL_FAILED          /* Result out of range or aborted */
+} Adc_Cal_State_t;
+
+/* Averaging run of a calibration step. The mean of point n is kept, two
+ * points of the same channel give gain and zero.
+ */
+typedef struct
+{
+    uint8_t  state;         /* Adc_Cal_State_t */
+    uint8_t  ch;
+    uint8_t  point;         /* 0 for auto-zero, 1 or 2 for a gain point */
+    uint8_t  valid;         /* Captured points, bit n - 1 for point n */
+    uint32_t samples;       /* Samples to average */
+    uint32_t left;          /* Samples still to go */
+    int32_t  ref[ADC_CAL_POINTS];   /* Reference, mV or mA */
+    int32_t  mean[ADC_CAL_POINTS];  /* Raw mean, ADC_CAL_ZERO_Q */
+} Adc_Cal_Run_t;
+
+/* Power of the last window and the energy total. Energy is kept in uJ in
+ * 64 bits, which lasts for thousands of years at full scale.
+ */
+typedef struct
+{
+    int32_t  p;             /* Real power, mW */
+    uint32_t s;             /* Apparent power, mVA */
+    int16_t  pf;            /* Power factor, per mille, negative on export */
+    int64_t  energy;        /* Real energy total, uJ */
+} Adc_Power_t;
+
+/* DMA half buffer hand over counters, times in us */
+typedef struct
+{
+    uint32_t seq;           /* Half buffers completed by DMA */
+    uint32_t processed;     /* Half buffers processed */
+    uint32_t missed;        /* Half buffers overwritten before processing */
+    uint32_t late;          /* Processing overlapped with DMA rewriting it */
+    uint32_t lat_last;      /* DMA event to processing start */
+    uint32_t lat_max;
+    uint32_t proc_last;     /* Half buffer processing time */
+    uint32_t proc_max;
+} Adc_Dma_Stats_t;
+
+/* Line measurement of the last AC window */
+typedef struct
+{
+    bool_t   locked;        /* Last window closed on a zero crossing */
+    uint32_t freq;          /* Line frequency, mHz */
+    uint32_t jitter;        /* Max - min period within the window, us */
+} Adc_Line_t;
+
+/* Window statistics of one channel. All values are in ADC counts with the
+ * channel zero point removed and shift fractional bits gained by the
+ * decimation. Results are updated when a window closes. Window length is
+ * limited to ADC_WIN_MAX samples.
+ */
 typedef struct
 {
     uint32_t last;          /* Last valid calculated RMS */
-    uint32_t max;           /* Max measured RMS value - test purpose only */
-    uint32_t min;           /* Min measured RMS value - test purpose only */
+    int32_t  max;           /* Max sample of the last window */
+    int32_t  min;           /* Min sample of the last window */
     uint32_t curr_cnt;      /* Current sample counter */
     uint32_t req_samples;   /* No of samples required to evaluate RMS */
-    uint64_t sum;           /* Current samples sum value */
+    uint64_t sum;           /* Current squared samples sum value */
+    int64_t  dc_sum;        /* Current samples sum value */
+    int32_t  win_max;       /* Current window max sample */
+    int32_t  win_min;       /* Current window min sample */
+    int32_t  dc;            /* Last window mean value */
+    uint32_t ac;            /* Last window RMS with mean removed */
+    uint32_t p2p;           /* Last window peak-to-peak value */
+    uint32_t crest;         /* Last window crest factor, Q8 */
+    uint32_t samples;       /* Number of samples in the last window */
+    uint32_t shift;         /* Fractional bits of all values */
 } Adc_Rms_t;
 
 status_t adc_init( void );
 status_t adc_start( void );
 status_t adc_stop( void );
-void adc_calc_rms( Adc_Rms_t* rms );
-void adc_set_rms_flag( bool_t state );
+status_t adc_cfg_load( void );
+status_t adc_cfg_save( void );
+const Adc_Cfg_t* adc_get_cfg( void );
+status_t adc_set_mode( Adc_Mode_t mode, uint16_t len );
+status_t adc_set_ref_ch( uint8_t ch );
+status_t adc_set_rate( uint32_t rate );
+status_t adc_set_dec( uint8_t dec );
+uint32_t adc_get_fs( void );
+uint32_t adc_bench( uint8_t dec );
+void adc_calc_rms( void );
+const Adc_Rms_t* adc_get_rms( uint8_t ch );
+uint32_t adc_get_milli( uint8_t ch );
+void adc_get_line( Adc_Line_t* line );
+void adc_get_power( Adc_Power_t* power );
+status_t adc_energy_load( void );
+status_t adc_energy_save( void );
+status_t adc_energy_reset( void );
+status_t adc_cal_load( void );
+status_t adc_cal_save( void );
+status_t adc_cal_reset( uint8_t ch );
+status_t adc_cal_zero( uint8_t ch, uint32_t samples );
+status_t adc_cal_point( uint8_t  ch
+                      , uint8_t  point
+                      , int32_t  ref
+                      , uint32_t samples
+                      );
+const Adc_Cal_t* adc_get_cal( void );
+void adc_get_cal_run( Adc_Cal_Run_t* run );
 bool_t adc_get_rms_flag( void );
+void adc_get_dma_stats( Adc_Dma_Stats_t* stats );
+void adc_reset_dma_stats( void );
 void dma1_ch1_irq_hdl( void );
 
 #endif /* __ADC_H__ */
@@ -7,30 +7,42 @@
  **
  ** Revision
  **   27-Aug-2020 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Use SPSC ring as storage
+ **   18-Oct-2026 (SSB) [] Incremental pattern search
+ **   18-Oct-2026 (SSB) [] Zero-copy spans, line read through memchr
+ **   18-Oct-2026 (SSB) [] Plain scan for patterns longer than the matcher
+ **   18-Oct-2026 (SSB) [] Line read needs room for a character
  **/
 
 #ifndef __BUFFER_H__
 #define __BUFFER_H__
 
+#include "match.h"
 #include "ptypes.h"
+#include "ring.h"
 
 #include <stm32f1xx_hal.h>
 
 #define BUFFER_DEFAULT_DELIMITER    ((uint8_t)'\n')
 
+/* Buffer_t is kept as a compatibility layer on top of Ring_t. Writes are
+ * done by one producer (ISR) and reads by one consumer (main loop).
+ */
 typedef struct
 {
-    uint32_t size;        /* Size of buffer in units of bytes */
-    uint32_t in;          /* Input pointer to save next value */
-    uint32_t out;         /* Output pointer to read next value */
-    uint8_t* data;        /* Pointer to buffer data array */
+    Ring_t   ring;        /* Buffer storage, size is power of two */
     uint8_t  delimiter;   /* Character for string delimiter when reading
                            * from buffer as string
                            */
 } Buffer_t;
 
+/* Static initializer, storage must be an array with power of two size */
+#define BUFFER_INIT(storage, delim) { .ring      = RING_INIT( storage ) \
+                                    , .delimiter = (delim)              \
+                                    }
+
 /*
- * Initialize buffer data structure (Buffer_t)
+ * Initialize buffer data structure (Buffer_t), size has to be power of two
  */
 status_t buffer_init( Buffer_t* buff, uint32_t size, void* buff_ptr );
 
@@ -60,25 +72,54 @@ uint32_t buffer_get_full( Buffer_t* buff );
 void buffer_reset( Buffer_t* buff );
 
 /*
- * Check if specific element is stored in buffer
+ * Check if specific element is stored in buffer, returns offset of its
+ * first occurrence or -1
  */
 int32_t buffer_find_element( Buffer_t* buff, const uint8_t element );
 
 /*
- * Check if specific data sequence is stored in buffer
+ * Check if specific data sequence is stored in buffer, returns offset of
+ * its first occurrence or -1. Sequences of MATCH_NODE_MAX bytes or more
+ * don't fit into the matcher and fall back to a plain scan.
  */
 int32_t buffer_find( Buffer_t* buff, const void* data, uint32_t size );
 
+/*
+ * Offset of the first unread occurrence of any pattern of match or -1, id
+ * gets its pattern. Only bytes received since the previous call with the
+ * same match are scanned.
+ */
+int32_t buffer_match( Buffer_t* buff, Match_t* match, int8_t* id );
+
 /*
  * Write string formatted data to bufferr
  */
 uint32_t buffer_write_string( Buffer_t* buff, const char* string );
 
 /*
- * Read data from buffer as string
+ * Read a line up to and including the delimiter as string, returns its
+ * length or 0 while no complete line is pending. Lines that don't fit are
+ * returned in pieces, buff_size has to be 2 at least.
  */
 uint32_t buffer_read_string( Buffer_t* buff, char* string, uint32_t buff_size );
 
+/*
+ * Pending data in place as up to two spans, returns their total size.
+ * Consume with buffer_skip().
+ */
+uint32_t buffer_get_spans( Buffer_t* buff, Ring_Span_t* span );
+
+/*
+ * First line including the delimiter in place as up to two spans, returns
+ * its length or 0. Consume with buffer_skip().
+ */
+uint32_t buffer_get_line( Buffer_t* buff, Ring_Span_t* span );
+
+/*
+ * Drop count bytes after processing them in place
+ */
+uint32_t buffer_skip( Buffer_t* buff, uint32_t count );
+
 /*
  * Check if character exists in buffer at the given location
  */
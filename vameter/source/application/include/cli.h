@@ -7,6 +7,8 @@
  **
  ** Revision
  **   14-May-2020 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Event driven, runs next to the measurement
+ **   18-Oct-2026 (SSB) [] Arguments point into the line
  **/
 
 #ifndef __CLI_H__
@@ -36,7 +38,7 @@ typedef struct
 {
     uint8_t  count;
     uint16_t num[CLI_CMD_MAX_ARG];
-    uint8_t  str[CLI_CMD_MAX_ARG][CLI_CMD_MAX_ARG_SIZE];
+    uint8_t* str[CLI_CMD_MAX_ARG];  /* Into the line, "" when not given */
 } Cli_Cmd_Args;
 
 typedef Cli_Ret (*Cli_Cmd_Func)( Cli_Cmd_Args* args );
@@ -64,6 +66,8 @@ typedef struct
     uint8_t cmd_len;
 } Cli_Cmd_Line;
 
+void cli_init( void );
 void cli_process( void );
+void cli_stream_stop( void );
 
 #endif /* __CLI_H__ */
@@ -0,0 +1,25 @@
+/**
+ ** Name
+ **   crc.h
+ **
+ ** Purpose
+ **   CRC routines
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#ifndef __CRC_H__
+#define __CRC_H__
+
+#include "ptypes.h"
+
+#define CRC16_INIT (0xFFFF)
+
+/*
+ * CRC-16/CCITT (poly 0x1021, MSB first), feed the previous result to chain
+ * several blocks, start with CRC16_INIT
+ */
+uint16_t crc16( uint16_t crc, const void* data, uint32_t size );
+
+#endif /* __CRC_H__ */
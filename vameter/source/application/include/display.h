@@ -7,6 +7,7 @@
  **
  ** Revision
  **   10-Oct-2020 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Timer multiplexed driver
  **/
 
 #ifndef __DISPLAY_H__
@@ -16,6 +17,36 @@
 
 #include <stm32f1xx_hal.h>
 
+/* Display 2 segments share PA3 with USART2 RX and PA4/PA5 with the PCD8544
+ * D/C and reset lines, so the 7-segment board excludes both of them.
+ */
+#define DISPLAY_ENABLED     (0)
+
+#define DISP_NUM            (2)
+#define DISP_DIGITS         (4)     /* Digits per display, power of two */
+
+/* TIM4 steps one digit of both displays per update event, CC1 blanks the
+ * digit early for brightness below maximum.
+ */
+#define DISP_TMR            TIM4
+#define DISP_TMR_CLK_HZ     (1000000)
+#define DISP_FRAME_HZ       (250)
+#define DISP_BRIGHT_MAX     (16)
+
+/* Segment drive is active high, digit commons are active low */
+#define DISP_SEG_ON         GPIO_PIN_SET
+#define DISP_COM_ON         GPIO_PIN_RESET
+
+/* Segment bits of a digit pattern */
+#define DISP_SEG_A          (0x01)
+#define DISP_SEG_B          (0x02)
+#define DISP_SEG_C          (0x04)
+#define DISP_SEG_D          (0x08)
+#define DISP_SEG_E          (0x10)
+#define DISP_SEG_F          (0x20)
+#define DISP_SEG_G          (0x40)
+#define DISP_SEG_DP         (0x80)
+
 #define DISP1_SEG_A_PIN     GPIO_PIN_15
 #define DISP1_SEG_A_PORT    GPIOC
 #define DISP1_SEG_B_PIN     GPIO_PIN_14
@@ -72,4 +103,29 @@
 #define DISP2_CLOCK_ENABLE() do { __HAL_RCC_GPIOA_CLK_ENABLE(); \
                                   __HAL_RCC_GPIOB_CLK_ENABLE(); } while(0)
 
+status_t display_init( void );
+
+/*
+ * Segment patterns of all digits of one display, leftmost first
+ */
+status_t display_set_segments( uint8_t disp, const uint8_t* seg );
+
+/*
+ * Show up to DISP_DIGITS characters, '.' lights the decimal point of the
+ * previous digit. Unsupported characters are blank.
+ */
+status_t display_puts( uint8_t disp, const char* str );
+
+/*
+ * Show a value given in thousandths with as many decimals as fit
+ */
+status_t display_put_milli( uint8_t disp, int32_t val );
+
+/*
+ * Duty cycle in 1/DISP_BRIGHT_MAX steps, 0 turns the displays off
+ */
+void display_set_brightness( uint8_t level );
+
+void display_tmr_irq_hdl( void );
+
 #endif /* __DISPLAY_H__ */
@@ -0,0 +1,55 @@
+/**
+ ** Name
+ **   event.h
+ **
+ ** Purpose
+ **   Run to completion event loop
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] 64-bit load totals, no wrap after 71 minutes
+ **/
+
+#ifndef __EVENT_H__
+#define __EVENT_H__
+
+#include "ptypes.h"
+#include "tim.h"
+
+#include <stm32f1xx_hal.h>
+
+#define EVENT_TICK_MS (100)     /* Period of EVENT_TICK */
+
+/* Lower id is dispatched first when several events are pending */
+typedef enum
+{
+    EVENT_ADC = 0,              /* ADC DMA half buffer ready */
+    EVENT_UART1_RX,             /* UART1 received data, line idle */
+    EVENT_UART2_RX,             /* UART2 received data, line idle */
+    EVENT_TICK,                 /* Periodic tick */
+    EVENT_NUM
+} Event_Id_t;
+
+typedef void (*Event_Hdl_t)( void );
+
+/* Load of one event type over the statistics window, times in us */
+typedef struct
+{
+    uint32_t count;             /* Handler runs */
+    Time_t   busy;              /* Total handler time */
+    uint32_t max;               /* Longest handler run */
+} Event_Stats_t;
+
+typedef struct
+{
+    Time_t        window;       /* Statistics window length */
+    Time_t        sleep;        /* Time spent in WFI */
+    Event_Stats_t event[EVENT_NUM];
+} Event_Load_t;
+
+void event_register( Event_Id_t id, Event_Hdl_t hdl );
+void event_post( Event_Id_t id );
+void event_loop( void );
+void event_get_load( Event_Load_t* load );
+
+#endif /* __EVENT_H__ */
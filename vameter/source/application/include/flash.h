@@ -7,6 +7,10 @@
  **
  ** Revision
  **   28-Aug-2020 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] User page layout
+ **   18-Oct-2026 (SSB) [] Log-structured settings store
+ **   18-Oct-2026 (SSB) [] ADC calibration slot
+ **   18-Oct-2026 (SSB) [] History configuration slot
  **/
 
 #ifndef __FLASH_H__
@@ -35,15 +39,57 @@
 
 #define FLASH_PAGE_ERASE_OK (uint32_t)(0xFFFFFFFF)
 
+/* User page layout, offsets and sizes are multiples of 4. Items should not
+ * cross a slot boundary, otherwise one write appends several records.
+ */
+#define FLASH_OFFS_ADC_CFG  (0x0000)
+#define FLASH_OFFS_ENERGY   (0x0020)
+#define FLASH_OFFS_ADC_CAL  (0x0040)
+#define FLASH_OFFS_HIST_CFG (0x0060)
+
+/* The user page is a virtual page kept in an append-only record log. Every
+ * write appends one record per touched slot to the active bank, a RAM index
+ * points to the latest record of each slot. When the bank runs full the
+ * latest records are copied to the other bank, which is erased only then.
+ */
+#define FLASH_USER_SIZE      FLASH_PAGE_SIZE
+#define FLASH_SLOT_SIZE      (32)
+#define FLASH_SLOT_NUM       ( FLASH_USER_SIZE / FLASH_SLOT_SIZE )
+
+#define FLASH_LOG_BANK_PAGES (2)
+#define FLASH_LOG_BANK_SIZE  ( FLASH_LOG_BANK_PAGES * FLASH_PAGE_SIZE )
+#define FLASH_LOG_MAGIC      (uint32_t)(0x474F4C46) /* "FLOG" */
+
+/* The last four pages are reserved for the log, see the linker script. The
+ * user page of the previous layout is imported once if no bank is valid.
+ */
 #ifdef STM32F100xB
-    #define FLASH_COPY_PAGE_ADDR FLASH_ADDR_PAGE_63
+    #define FLASH_LOG_BANK0_ADDR FLASH_ADDR_PAGE_60
+    #define FLASH_LOG_BANK1_ADDR FLASH_ADDR_PAGE_62
     #define FLASH_USER_PAGE_ADDR FLASH_ADDR_PAGE_62
 #else
-    #define FLASH_COPY_PAGE_ADDR FLASH_ADDR_PAGE_127
+    #define FLASH_LOG_BANK0_ADDR FLASH_ADDR_PAGE_124
+    #define FLASH_LOG_BANK1_ADDR FLASH_ADDR_PAGE_126
     #define FLASH_USER_PAGE_ADDR FLASH_ADDR_PAGE_126
 #endif
 
+typedef struct
+{
+    uint32_t appends;       /* Records appended since boot */
+    uint32_t compactions;   /* Bank swaps since boot */
+    uint32_t bank_seq;      /* Active bank generation */
+    uint32_t used;          /* Bytes used in the active bank */
+} Flash_Stats_t;
+
+/*
+ * Locate the active bank and rebuild the slot index, called once at boot.
+ * Read and write do it on first use otherwise.
+ */
+status_t flash_init( void );
+
 status_t flash_read( void* buff, uint32_t size, uint32_t offset );
 status_t flash_write( void* buff, uint32_t size, uint32_t offset );
 
+void flash_get_stats( Flash_Stats_t* stats );
+
 #endif /* __FLASH_H__ */
@@ -0,0 +1,119 @@
+/**
+ ** Name
+ **   hist.h
+ **
+ ** Purpose
+ **   Compressed measurement history in flash
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Period averages with a deadband, runtime period
+ **   18-Oct-2026 (SSB) [] Blocks programmed as they fill, lazy erase
+ **/
+
+#ifndef __HIST_H__
+#define __HIST_H__
+
+#include "ptypes.h"
+
+#include "flash.h"
+#include "tim.h"
+
+#include <stm32f1xx_hal.h>
+
+#ifndef HIST_ENABLED
+    #define HIST_ENABLED (1)
+#endif
+
+/* Sample period, multiple of EVENT_TICK_MS, kept in the flash user page.
+ * Longer periods average more readings and fill the pages slower.
+ */
+#define HIST_PERIOD_DEF_MS (1000)
+#define HIST_PERIOD_MAX_MS (60000)
+#define HIST_CH_NUM     (3)     /* Voltage mV, current mA, real power mW */
+
+/* Every tick reading is averaged over the period. A change within the
+ * deadband keeps the stored value, so noise turns into runs. The deadband
+ * is the larger of about 6 ADC counts, see adc.h, and |value| >> REL.
+ * tools/histsim shows the capacity for a few load models.
+ */
+#define HIST_DB_MV      (50)
+#define HIST_DB_MA      (100)
+#define HIST_DB_MW      (1000)
+#define HIST_DB_REL     (8)     /* 0.4 % */
+
+/* Pages right below the settings log, see the linker script. Blocks are
+ * page sized and written round robin, the oldest page is erased when the
+ * next block opens. Entries are programmed as they fill, the header is
+ * completed on close or by hist_init() after a power down.
+ */
+#define HIST_PAGES      (12)
+#define HIST_BLOCK_SIZE FLASH_PAGE_SIZE
+#ifndef HIST_ADDR
+    #define HIST_ADDR   ( FLASH_LOG_BANK0_ADDR                  \
+                        - ( HIST_PAGES * HIST_BLOCK_SIZE ))
+#endif
+#define HIST_MAGIC      (0x5648) /* "HV" */
+
+/* Block layout: header, then one entry per changed sample, or all zero
+ * deltas after a few minutes of repeats
+ *
+ *   varint run        samples repeating the previous one
+ *   zigzag varint     delta of each channel to the previous sample
+ *
+ * The payload may end with a lone run. Samples are spaced period ms apart,
+ * starting at time. The first sample of a block is a delta to zero.
+ */
+typedef struct
+{
+    uint16_t magic;
+    uint16_t len;           /* Payload bytes */
+    uint32_t seq;           /* Block sequence number, counts across boots */
+    Time_t   time;          /* get_time() of the first sample, us */
+    uint16_t boot;          /* Power up the block was recorded in */
+    uint16_t count;         /* Samples in the block */
+    uint16_t period;        /* Sample period, ms */
+    uint16_t crc;           /* CRC16 over header up to here and payload */
+} Hist_Blk_Hdr_t;
+
+#define HIST_PAYLOAD_SIZE ( HIST_BLOCK_SIZE - sizeof( Hist_Blk_Hdr_t ))
+
+typedef struct
+{
+    uint32_t blocks;        /* Valid blocks in flash */
+    uint32_t samples;       /* Samples in flash and in the open block */
+    uint32_t open_bytes;    /* Payload bytes of the open block */
+    uint32_t seq;           /* Sequence number of the open block */
+    uint16_t boot;
+    uint32_t flash_errors;
+} Hist_Stats_t;
+
+/* Receives one block at a time, header followed by len payload bytes */
+typedef void (*Hist_Out_t)( const Hist_Blk_Hdr_t* hdr, const uint8_t* data );
+
+/*
+ * Locate the newest block and continue after it
+ */
+status_t hist_init( void );
+
+/*
+ * Average readings of every EVENT_TICK, one sample per period
+ */
+void hist_tick( void );
+
+/*
+ * Pass blocks overlapping [from, to] seconds since their power up to out,
+ * oldest first, including the block not yet written. Returns block count.
+ */
+uint32_t hist_dump( uint32_t from, uint32_t to, Hist_Out_t out );
+
+void hist_get_stats( Hist_Stats_t* stats );
+
+/*
+ * Closes the open block, a block holds samples of one period only. The
+ * period is saved to flash.
+ */
+status_t hist_set_period( uint32_t period );
+uint32_t hist_get_period( void );
+
+#endif /* __HIST_H__ */
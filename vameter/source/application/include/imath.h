@@ -0,0 +1,27 @@
+/**
+ ** Name
+ **   imath.h
+ **
+ ** Purpose
+ **   Integer math routines
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#ifndef __IMATH_H__
+#define __IMATH_H__
+
+#include "ptypes.h"
+
+/*
+ * Integer square root, rounded down
+ */
+uint16_t isqrt32( uint32_t x );
+
+/*
+ * Integer square root of 64-bit value, rounded down
+ */
+uint32_t isqrt64( uint64_t x );
+
+#endif /* __IMATH_H__ */
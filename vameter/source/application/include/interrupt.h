@@ -7,6 +7,10 @@
  **
  ** Revision
  **   10-Oct-2020 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Add UART receive DMA channels
+ **   18-Oct-2026 (SSB) [] Add UART transmit DMA channels
+ **   18-Oct-2026 (SSB) [] Share DMA1 CH5 with PCD8544
+ **   18-Oct-2026 (SSB) [] Add 7-segment multiplex timer
  **/
 
 #ifndef __INTERRUPT_H__
@@ -22,7 +26,12 @@ void UsageFault_Handler( void );
 void DebugMon_Handler( void );
 void SysTick_Handler( void );
 void TIM2_IRQHandler( void );
+void TIM4_IRQHandler( void );
 void TIM7_IRQHandler( void );
 void DMA1_Channel1_IRQHandler( void );
+void DMA1_Channel4_IRQHandler( void );
+void DMA1_Channel5_IRQHandler( void );
+void DMA1_Channel6_IRQHandler( void );
+void DMA1_Channel7_IRQHandler( void );
 
 #endif /*__INTERRUPT_H__ */
@@ -0,0 +1,75 @@
+/**
+ ** Name
+ **   match.h
+ **
+ ** Purpose
+ **   Streaming multi-pattern matcher (Aho-Corasick)
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#ifndef __MATCH_H__
+#define __MATCH_H__
+
+#include "ptypes.h"
+
+/* Trie nodes incl. the root, the pattern lengths summed up must stay
+ * below. Node indices are 8-bit.
+ */
+#ifndef MATCH_NODE_MAX
+    #define MATCH_NODE_MAX (32)
+#endif
+
+#define MATCH_PAT_MAX  (4)
+
+#if ( MATCH_NODE_MAX > 255 )
+    #error "Match node indices are 8-bit"
+#endif
+
+/* Children of a node are a sibling list, no 256 entry rows in RAM */
+typedef struct
+{
+    uint8_t ch;                 /* Edge label from the parent */
+    uint8_t child;              /* First child, 0 is none */
+    uint8_t next;               /* Next sibling, 0 is none */
+    uint8_t fail;               /* Longest proper suffix in the trie */
+    uint8_t out;                /* Pattern ending here + 1, 0 is none */
+} Match_Node_t;
+
+/* One pattern is KMP, the chain's fail links are its failure table. The
+ * state carries over calls, so data arriving in pieces is scanned once.
+ */
+typedef struct
+{
+    Match_Node_t node[MATCH_NODE_MAX];
+    uint8_t      len[MATCH_PAT_MAX];
+    uint8_t      nodes;         /* Nodes in use */
+    uint8_t      state;         /* Current node */
+    uint32_t     pos;           /* Ring index of the next byte to scan */
+    uint32_t     hit;           /* Ring index of the last match start */
+    int8_t       hit_id;        /* Its pattern, -1 is none */
+} Match_t;
+
+/*
+ * Build the automaton for num patterns of len[i] bytes, fails when they
+ * don't fit into MATCH_NODE_MAX or MATCH_PAT_MAX
+ */
+status_t match_init( Match_t*           match
+                   , const void* const* pat
+                   , const uint8_t*     len
+                   , uint8_t            num
+                   );
+
+/*
+ * Forget partial matches, the patterns stay
+ */
+void match_reset( Match_t* match );
+
+/*
+ * Advance by one byte, returns the id of the longest pattern ending with
+ * it or -1
+ */
+int8_t match_step( Match_t* match, uint8_t ch );
+
+#endif /* __MATCH_H__ */
@@ -7,6 +7,10 @@
  **
  ** Revision
  **   26-Oct-2020 (SB) [] Initial
+ **   18-Oct-2026 (SSB) [] DMA burst refresh
+ **   18-Oct-2026 (SSB) [] Refresh byte counters
+ **   18-Oct-2026 (SSB) [] DMA refresh selectable for host builds
+ **   18-Oct-2026 (SSB) [] DMA refresh opt-in, keeps USART1 receive DMA
  **/
 
 #ifndef __PCD8544_H__
@@ -16,6 +20,19 @@
 
 #define PCD8544_SPI      SPI2
 
+#define PCD8544_WIDTH  84
+#define PCD8544_HEIGHT 48
+
+/* Refresh through SPI2 TX DMA (DMA1 CH5), one burst per page. SPI2 TX has
+ * no other channel and CH5 also serves USART1 RX, so this is opt-in: build
+ * with LCD_DMA=1, which sets UART1_RX_DMA_ENABLED to 0 as well.
+ */
+#ifndef PCD8544_DMA_ENABLED
+    #define PCD8544_DMA_ENABLED (0)
+#endif
+
+#define PCD8544_CONTRAST_DEF (0x38)
+
 /* GPIO mapping */
 #define PCD8544_RST_PORT GPIOA
 #define PCD8544_RST_PIN  GPIO_PIN_5
@@ -58,9 +75,24 @@ typedef enum
     PCD8544_INVERT_YES
 } PCD8544_Invert_t;
 
+/* Refresh completion, called from the DMA interrupt */
+typedef void (*PCD8544_Done_Cb_t)( void );
+
+typedef struct
+{
+    uint32_t refreshes;     /* Completed refreshes */
+    uint32_t time_last;     /* Last refresh duration, us */
+    uint32_t time_max;      /* Longest refresh duration, us */
+    uint32_t bytes_last;    /* Bytes sent by the last refresh */
+    uint32_t bytes_total;   /* Bytes sent by all refreshes */
+} PCD8544_Stats_t;
+
 status_t pcd8544_init( uint8_t contrast );
 status_t pcd8544_home( void );
 status_t pcd8544_refresh( void );
+status_t pcd8544_refresh_async( PCD8544_Done_Cb_t done );
+bool_t pcd8544_is_busy( void );
+void pcd8544_get_stats( PCD8544_Stats_t* stats );
 status_t pcd8544_clear( void );
 status_t pcd8544_set_contrast( uint8_t contrast );
 void pcd8544_goto_xy( uint8_t x, uint8_t y );
@@ -108,4 +140,8 @@ status_t pcd8544_draw_filled_circle( int8_t          x0
                                    , PCD8544_Pixel_t color
                                    );
 
+#if ( PCD8544_DMA_ENABLED != 0 )
+void pcd8544_dma_irq_hdl( void );
+#endif
+
 #endif /* __PCD8544_H__ */
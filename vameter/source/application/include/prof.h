@@ -0,0 +1,96 @@
+/**
+ ** Name
+ **   prof.h
+ **
+ ** Purpose
+ **   Cycle counter profiling of code sections
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Release build switch from the Makefile
+ **   18-Oct-2026 (SSB) [] Time base also without probes, used by trace
+ **/
+
+#ifndef __PROF_H__
+#define __PROF_H__
+
+#include "ptypes.h"
+#include "tim.h"
+
+#include <stm32f1xx_hal.h>
+
+/* Probes compile to nothing when disabled, BUILD_TYPE=release sets it to 0
+ * from the Makefile.
+ */
+#ifndef PROF_ENABLED
+    #define PROF_ENABLED (1)
+#endif
+
+/* Bin n counts runs of 2^n up to 2^(n+1) - 1 ticks, the last bin all
+ * longer ones
+ */
+#define PROF_HIST_BINS (20)
+
+typedef enum
+{
+    PROF_ADC = 0,               /* Half buffer processing */
+    PROF_DISP_SHOW,             /* Display content update */
+    PROF_DISP_IRQ,              /* Display multiplexing interrupt */
+    PROF_UART1_IRQ,             /* UART1 receive interrupt */
+    PROF_UART2_IRQ,             /* UART2 receive interrupt */
+    PROF_UART1_TX,              /* UART1 transmit DMA interrupt */
+    PROF_NUM
+} Prof_Id_t;
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;               /* Ticks */
+    uint32_t max;
+    uint64_t total;
+    uint16_t hist[PROF_HIST_BINS];  /* Saturating */
+} Prof_Scope_t;
+
+extern bool_t prof_dwt;
+
+/* DWT cycle counter, or the microsecond time base where the core has none */
+static __INLINE uint32_t prof_now( void )
+{
+    Time_t   now;
+    uint32_t ret;
+
+    if ( FALSE != prof_dwt )
+    {
+        ret = DWT->CYCCNT;
+    }
+    else
+    {
+        get_time( &now );
+        ret = (uint32_t) now;
+    }
+
+    return ret;
+}
+
+#if ( PROF_ENABLED != 0 )
+
+/* Scopes nest and may sit in interrupts, each id in one context only */
+#define PROF_BEGIN( id ) const uint32_t prof_start_##id = prof_now()
+#define PROF_END( id )   prof_add( id, prof_now() - prof_start_##id )
+
+void prof_add( Prof_Id_t id, uint32_t ticks );
+
+#else
+
+#define PROF_BEGIN( id )
+#define PROF_END( id )
+
+#endif /* PROF_ENABLED */
+
+void prof_init( void );
+const char* prof_get_name( Prof_Id_t id );
+uint32_t prof_get_hz( void );
+void prof_get( Prof_Id_t id, Prof_Scope_t* scope );
+void prof_reset( void );
+
+#endif /* __PROF_H__ */
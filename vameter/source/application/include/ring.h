@@ -0,0 +1,162 @@
+/**
+ ** Name
+ **   ring.h
+ **
+ ** Purpose
+ **   Lock-free single producer / single consumer byte ring
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Zero-copy spans and line extraction
+ **/
+
+#ifndef __RING_H__
+#define __RING_H__
+
+#include "ptypes.h"
+
+#include <stm32f1xx_hal.h>
+
+/* Cortex-M3 has no data cache, so keeping the producer and consumer indices
+ * in separate words is enough. Raise it for cached targets (host builds).
+ */
+#ifndef RING_CACHE_LINE_SIZE
+    #define RING_CACHE_LINE_SIZE (4)
+#endif
+
+#define RING_IS_POW2(x) ((( x ) != 0 ) && ((( x ) & (( x ) - 1 )) == 0 ))
+
+/* Indices are free running, only masked on data access. The producer owns
+ * head, the consumer owns tail, each side only reads the other one.
+ */
+typedef struct
+{
+    uint8_t*          data;    /* Pointer to ring storage */
+    uint32_t          mask;    /* Ring size - 1, size is power of two */
+
+    volatile uint32_t head     /* Producer index */
+                      __attribute__(( aligned( RING_CACHE_LINE_SIZE )));
+    volatile uint32_t tail     /* Consumer index */
+                      __attribute__(( aligned( RING_CACHE_LINE_SIZE )));
+} Ring_t;
+
+/* Static initializer, storage must be an array with power of two size */
+#define RING_INIT(storage) { .data = (storage)                  \
+                           , .mask = sizeof( storage ) - 1      \
+                           , .head = 0                          \
+                           , .tail = 0                          \
+                           }
+
+/* Contiguous piece of ring storage */
+typedef struct
+{
+    const uint8_t* data;
+    uint32_t       size;
+} Ring_Span_t;
+
+#define RING_LOAD_ACQUIRE(p)     __atomic_load_n( (p), __ATOMIC_ACQUIRE )
+#define RING_STORE_RELEASE(p, v) __atomic_store_n( (p), (v), __ATOMIC_RELEASE )
+
+/*
+ * Initialize ring, size has to be power of two
+ */
+status_t ring_init( Ring_t* ring, uint32_t size, void* storage );
+
+/*
+ * Write up to count bytes, returns number of bytes written (producer)
+ */
+uint32_t ring_write( Ring_t* ring, const void* data, uint32_t count );
+
+/*
+ * Read up to count bytes, returns number of bytes read (consumer)
+ */
+uint32_t ring_read( Ring_t* ring, void* data, uint32_t count );
+
+/*
+ * Copy up to count bytes starting at offset without consuming (consumer)
+ */
+uint32_t ring_peek( Ring_t* ring, void* data, uint32_t count, uint32_t offset );
+
+/*
+ * Drop up to count bytes, returns number of bytes dropped (consumer)
+ */
+uint32_t ring_skip( Ring_t* ring, uint32_t count );
+
+/*
+ * Pending bytes in place as up to two spans, the second one is empty
+ * unless the data wraps. Returns their total size, spans stay valid until
+ * consumed by ring_skip() (consumer)
+ */
+uint32_t ring_spans( Ring_t* ring, Ring_Span_t* span );
+
+/*
+ * First line ending with delim in place as up to two spans, returns its
+ * length including delim, 0 if no complete line is pending (consumer)
+ */
+uint32_t ring_line( Ring_t* ring, uint8_t delim, Ring_Span_t* span );
+
+/*
+ * Drop all pending bytes (consumer)
+ */
+void ring_flush( Ring_t* ring );
+
+static __INLINE uint32_t ring_size( const Ring_t* ring )
+{
+    return ring->mask + 1;
+}
+
+static __INLINE uint32_t ring_count( const Ring_t* ring )
+{
+    return RING_LOAD_ACQUIRE( &ring->head ) - RING_LOAD_ACQUIRE( &ring->tail );
+}
+
+static __INLINE uint32_t ring_free( const Ring_t* ring )
+{
+    return ring_size( ring ) - ring_count( ring );
+}
+
+/*
+ * Byte at offset from the consumer index, caller checks offset < count
+ */
+static __INLINE uint8_t ring_at( const Ring_t* ring, uint32_t offset )
+{
+    return ring->data[( ring->tail + offset ) & ring->mask];
+}
+
+/*
+ * Single byte push, intended for ISR usage (producer)
+ */
+static __INLINE bool_t ring_put( Ring_t* ring, uint8_t byte )
+{
+    bool_t   ret  = FALSE;
+    uint32_t head = ring->head;
+
+    if (( head - RING_LOAD_ACQUIRE( &ring->tail )) <= ring->mask )
+    {
+        ring->data[head & ring->mask] = byte;
+        RING_STORE_RELEASE( &ring->head, head + 1 );
+        ret = TRUE;
+    }
+
+    return ret;
+}
+
+/*
+ * Single byte pop (consumer)
+ */
+static __INLINE bool_t ring_get( Ring_t* ring, uint8_t* byte )
+{
+    bool_t   ret  = FALSE;
+    uint32_t tail = ring->tail;
+
+    if ( RING_LOAD_ACQUIRE( &ring->head ) != tail )
+    {
+        *byte = ring->data[tail & ring->mask];
+        RING_STORE_RELEASE( &ring->tail, tail + 1 );
+        ret = TRUE;
+    }
+
+    return ret;
+}
+
+#endif /* __RING_H__ */
@@ -0,0 +1,85 @@
+/**
+ ** Name
+ **   stream.h
+ **
+ ** Purpose
+ **   Binary sample streaming
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#ifndef __STREAM_H__
+#define __STREAM_H__
+
+#include "ptypes.h"
+
+#include "adc.h"
+
+#include <stm32f1xx_hal.h>
+
+#ifndef STREAM_ENABLED
+    #define STREAM_ENABLED (1)
+#endif
+
+#define STREAM_UART        UART_TO_PC
+#define STREAM_VER         (1)
+#define STREAM_DEC_MAX     (16)  /* Stream decimation, power of two */
+#define STREAM_FRAME_PAIRS (48)  /* Sample pairs per frame */
+
+/* Frame before COBS encoding, little endian
+ *
+ *   Stream_Hdr_t | count x ADC_CH_NUM uint16_t samples | CRC16 of both
+ *
+ * On the wire each frame is COBS encoded and followed by a zero byte. A
+ * zero byte also goes ahead of the first frame, so the host can drop
+ * whatever it received before. Samples are raw ADC counts with shift
+ * fractional bits, channel order as in the DMA buffer.
+ */
+typedef struct
+{
+    uint8_t  ver;           /* STREAM_VER */
+    uint8_t  ch_num;        /* Interleaved channels */
+    uint16_t seq;           /* Frame counter, a gap means dropped frames */
+    uint32_t fs;            /* ADC output rate, pairs/s, before dec */
+    uint8_t  shift;         /* Fractional bits of the samples */
+    uint8_t  dec;           /* Stream decimation ratio */
+    uint16_t count;         /* Sample pairs in the frame */
+} Stream_Hdr_t;
+
+#define STREAM_HDR_SIZE   (12)
+#define STREAM_FRAME_SIZE ( STREAM_HDR_SIZE                          \
+                          + ( STREAM_FRAME_PAIRS * ADC_CH_NUM * 2 )  \
+                          + 2 )
+
+/* COBS adds the leading code and one byte per 254, plus the delimiter */
+#define STREAM_WIRE_SIZE  ( STREAM_FRAME_SIZE                        \
+                          + ( STREAM_FRAME_SIZE / 254 ) + 2 )
+
+typedef struct
+{
+    uint32_t frames;        /* Frames produced */
+    uint32_t dropped;       /* Frames not fitting into the transmit ring */
+    uint32_t bytes;         /* Bytes queued for transmission */
+} Stream_Stats_t;
+
+/*
+ * Start streaming with decimation 1..STREAM_DEC_MAX, power of two
+ */
+status_t stream_start( uint8_t dec );
+void stream_stop( void );
+bool_t stream_is_active( void );
+
+/*
+ * Wire bytes per second at the current ADC rate and given decimation
+ */
+uint32_t stream_get_rate( uint8_t dec );
+
+/*
+ * Feed processed ADC pairs, called for every half buffer
+ */
+void stream_feed( const uint16_t* frame, uint32_t pairs );
+
+void stream_get_stats( Stream_Stats_t* stats );
+
+#endif /* __STREAM_H__ */
@@ -7,6 +7,7 @@
  **
  ** Revision
  **   20-Apr-2020 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Runtime ADC trigger rate
  **/
 
 #ifndef __TIM_H__
@@ -29,6 +30,8 @@ status_t tmr_bsp_init( void );
 status_t tmr_ms_init( void );
 status_t tmr_adc_init( void );
 status_t tmr_adc_start( void );
+status_t tmr_adc_set_rate( uint32_t rate );
+uint32_t tmr_adc_get_rate( void );
 void get_time( Time_t* tv );
 void wait( Time_t time, Time_Base_t base );
 bool_t is_timeout( Time_t timeout );
@@ -0,0 +1,114 @@
+/**
+ ** Name
+ **   trace.h
+ **
+ ** Purpose
+ **   Timestamped event trace in RAM
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Release build switch from the Makefile
+ **/
+
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include "ptypes.h"
+#include "prof.h"
+
+/* Disabled by BUILD_TYPE=release from the Makefile */
+#ifndef TRACE_ENABLED
+    #define TRACE_ENABLED (1)
+#endif
+
+/* Records kept, has to be power of two, 8 bytes each */
+#define TRACE_SIZE    (64)
+
+#define TRACE_MAGIC   (0x43525456)  /* "VTRC" */
+#define TRACE_VER     (1)
+
+#if ( 0 != ( TRACE_SIZE & ( TRACE_SIZE - 1 )))
+    #error "TRACE_SIZE has to be power of two"
+#endif
+
+/* Ids are mirrored by tools/vatrace, append only */
+typedef enum
+{
+    TRACE_SLEEP = 0,            /* WFI in the event loop */
+    TRACE_EVENT,                /* Event handler, arg is the event id */
+    TRACE_ADC_HALF,             /* DMA half buffer done, arg is its seq */
+    TRACE_DISP_IRQ,             /* Display multiplexing interrupt */
+    TRACE_UART1_IRQ,            /* UART1 receive interrupt */
+    TRACE_UART2_IRQ,            /* UART2 receive interrupt */
+    TRACE_UART1_TX,             /* UART1 transmit DMA interrupt */
+    TRACE_NUM
+} Trace_Id_t;
+
+typedef enum
+{
+    TRACE_TYPE_MARK = 0,
+    TRACE_TYPE_BEGIN,
+    TRACE_TYPE_END
+} Trace_Type_t;
+
+/* Low word of prof_now(), the reader unwraps consecutive records. A delta
+ * to the previous record would need its time shared between interrupts.
+ */
+typedef struct
+{
+    uint32_t time;
+    uint8_t  id;
+    uint8_t  type;
+    uint16_t arg;
+} Trace_Rec_t;
+
+/* Dump header, followed by count records, oldest first */
+typedef struct
+{
+    uint32_t magic;
+    uint16_t ver;
+    uint16_t count;
+    uint32_t hz;                /* Record time ticks per second */
+} Trace_Hdr_t;
+
+#if ( TRACE_ENABLED != 0 )
+
+extern volatile bool_t trace_on;
+extern uint32_t        trace_head;
+extern Trace_Rec_t     trace_buff[TRACE_SIZE];
+
+/* Lock free from any context, a slot is claimed by one atomic increment */
+static __INLINE void trace_put( Trace_Id_t id, Trace_Type_t type, uint16_t arg )
+{
+    Trace_Rec_t* rec;
+    uint32_t     idx;
+
+    if ( FALSE != trace_on )
+    {
+        idx = __atomic_fetch_add( &trace_head, 1, __ATOMIC_RELAXED );
+        rec = &trace_buff[idx & ( TRACE_SIZE - 1 )];
+
+        rec->time = prof_now();
+        rec->id   = (uint8_t) id;
+        rec->type = (uint8_t) type;
+        rec->arg  = arg;
+    }
+}
+
+#define TRACE_MARK( id, arg )  trace_put( id, TRACE_TYPE_MARK, arg )
+#define TRACE_BEGIN( id, arg ) trace_put( id, TRACE_TYPE_BEGIN, arg )
+#define TRACE_END( id, arg )   trace_put( id, TRACE_TYPE_END, arg )
+
+#else
+
+#define TRACE_MARK( id, arg )
+#define TRACE_BEGIN( id, arg )
+#define TRACE_END( id, arg )
+
+#endif /* TRACE_ENABLED */
+
+void trace_start( void );
+void trace_stop( void );
+uint32_t trace_dump( void );
+
+#endif /* __TRACE_H__ */
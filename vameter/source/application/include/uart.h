@@ -7,12 +7,24 @@
  **
  ** Revision
  **   27-Aug-2020 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Power of two receive buffer sizes
+ **   18-Oct-2026 (SSB) [] Add circular DMA receive mode
+ **   18-Oct-2026 (SSB) [] Add DMA transmit mode
+ **   18-Oct-2026 (SSB) [] USART1 receive without DMA, channel used by PCD8544
+ **   18-Oct-2026 (SSB) [] Room for two stream frames in USART1 transmit ring
+ **   18-Oct-2026 (SSB) [] Multi-pattern search in received data
+ **   18-Oct-2026 (SSB) [] Received data in place
+ **   18-Oct-2026 (SSB) [] Document the search string limit
+ **   18-Oct-2026 (SSB) [] Document receive DMA overrun handling
+ **   18-Oct-2026 (SSB) [] USART1 receive through DMA again by default
  **/
 
 #ifndef __UART_H__
 #define __UART_H__
 
+#include "match.h"
 #include "ptypes.h"
+#include "ring.h"
 
 #include <stm32f1xx_hal.h>
 
@@ -20,7 +32,28 @@
 
 #define UART_TO_PC USART1
 
+/* Receive buffer sizes have to be power of two */
 #define UART_BUFFER_SIZE      (1024)
+#define UART1_BUFFER_SIZE     (64)
+
+/* Receive through circular DMA (USART1 - DMA1 CH5, USART2 - DMA1 CH6)
+ * instead of one interrupt per received byte. DMA1 CH5 is also the only
+ * SPI2 TX channel, a build with PCD8544_DMA_ENABLED turns USART1 off here.
+ */
+#ifndef UART1_RX_DMA_ENABLED
+    #define UART1_RX_DMA_ENABLED  (1)
+#endif
+#define UART2_RX_DMA_ENABLED  (1)
+
+/* Transmit through a ring drained by DMA (USART1 - DMA1 CH4,
+ * USART2 - DMA1 CH7). Sizes have to be power of two.
+ */
+#define UART1_TX_DMA_ENABLED  (1)
+#define UART1_TX_BUFFER_SIZE  (512)
+#define UART2_TX_DMA_ENABLED  (0)
+#define UART2_TX_BUFFER_SIZE  (64)
+
+#define UART_TX_DEFAULT_POLICY UART_TX_POLICY_BLOCK
 #define UART_STRING_DELIMITER ((uint8_t)'\n')
 
 #define UART_WRITE_DATA(UARTx, data) ((UARTx)->DR = (data))
@@ -29,17 +62,63 @@
 #define UART_TXEMPTY(UARTx) ((UARTx)->SR & USART_FLAG_TXE)
 #define UART_WAIT(UARTx)    while (!UART_TXEMPTY(UARTx))
 
+/* What to do with data not fitting into the transmit ring */
+typedef enum
+{
+    UART_TX_POLICY_BLOCK = 0,   /* Wait for DMA to free space */
+    UART_TX_POLICY_DROP,        /* Drop the whole message */
+    UART_TX_POLICY_TRUNCATE     /* Write what fits, drop the rest */
+} Uart_Tx_Policy_t;
+
+typedef struct
+{
+    Uart_Tx_Policy_t policy;    /* Active full buffer policy */
+    uint32_t         size;      /* Transmit ring size */
+    uint32_t         pending;   /* Bytes waiting for transmission */
+    uint32_t         dropped;   /* Number of dropped bytes */
+    uint32_t         hwm;       /* Ring usage high-water mark */
+} Uart_Tx_Stats_t;
+
 status_t uart_init( USART_TypeDef* uart, uint32_t baudrate );
 void uart_puts( USART_TypeDef* uart, char* str );
 void uart_send( USART_TypeDef* uart, uint8_t* data, uint16_t count );
 uint8_t uart_getc( USART_TypeDef* uart );
 uint16_t uart_gets( USART_TypeDef* uart, char* data, uint16_t buff_size );
 int16_t uart_find_char( USART_TypeDef* uart, uint8_t ch );
+uint32_t uart_get_spans( USART_TypeDef* uart, Ring_Span_t* span );
+uint32_t uart_get_line( USART_TypeDef* uart, Ring_Span_t* span );
+void uart_skip( USART_TypeDef* uart, uint32_t count );
 bool_t uart_buff_empty( USART_TypeDef* uart );
 bool_t uart_buff_full( USART_TypeDef* uart );
 uint16_t uart_buff_count( USART_TypeDef* uart );
 void uart_clear_buff( USART_TypeDef* uart );
 void uart_set_custom_string_delimiter( USART_TypeDef* uart, uint8_t delim );
+
+/*
+ * Offset of str in the receive buffer or -1 while not received. Strings
+ * below MATCH_NODE_MAX bytes are matched incrementally over calls, longer
+ * ones are scanned from the oldest byte on every call.
+ */
 int16_t uart_find_string( USART_TypeDef* uart, char* str );
 
+/*
+ * Offset of the first unread occurrence of any pattern of match or -1, see
+ * buffer_match()
+ */
+int16_t uart_match( USART_TypeDef* uart, Match_t* match, int8_t* id );
+
+/*
+ * Receive DMA overruns so far. Pending data is dropped on the next buffer
+ * access after an overrun, it is out of order.
+ */
+uint32_t uart_get_rx_overrun( USART_TypeDef* uart );
+void uart_flush( USART_TypeDef* uart );
+void uart_set_tx_policy( USART_TypeDef* uart, Uart_Tx_Policy_t policy );
+void uart_get_tx_stats( USART_TypeDef* uart, Uart_Tx_Stats_t* stats );
+void uart_reset_tx_stats( USART_TypeDef* uart );
+void dma1_ch4_irq_hdl( void );
+void dma1_ch5_irq_hdl( void );
+void dma1_ch6_irq_hdl( void );
+void dma1_ch7_irq_hdl( void );
+
 #endif /* __UART_H__ */
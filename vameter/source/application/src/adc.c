@@ -7,40 +7,140 @@
  **
  ** Revision
  **   10-Oct-2020 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Integer RMS, no libm
+ **   18-Oct-2026 (SSB) [] Single pass window statistics
+ **   18-Oct-2026 (SSB) [] Zero crossing synchronised AC mode
+ **   18-Oct-2026 (SSB) [] Power and energy metering
+ **   18-Oct-2026 (SSB) [] Runtime sample rate, boxcar decimation
+ **   18-Oct-2026 (SSB) [] DMA half selection from HAL callbacks
+ **   18-Oct-2026 (SSB) [] Post half buffer event
+ **   18-Oct-2026 (SSB) [] RMS in mV and mA
+ **   18-Oct-2026 (SSB) [] Feed sample stream
+ **   18-Oct-2026 (SSB) [] Profiling probe
+ **   18-Oct-2026 (SSB) [] Trace DMA half buffers
+ **   18-Oct-2026 (SSB) [] Gain and offset calibration, auto-zero
+ **   18-Oct-2026 (SSB) [] No scope pin toggle, PB15 drives the LCD
+ **   18-Oct-2026 (SSB) [] Bench on stopped DMA, no calibration or stream
  **/
 
 #include "adc.h"
 
+#include "event.h"
+#include "flash.h"
+#include "imath.h"
+#include "prof.h"
+#include "stream.h"
 #include "tim.h"
+#include "trace.h"
 
-#include <math.h>
+#include <string.h>
 
 static ADC_HandleTypeDef adc_hdl;
 static DMA_HandleTypeDef hdma_adc1;
 
-static bool_t   adc_rms_flag = FALSE;
-static uint16_t dma_data[ADC_DMA_BUFF_SIZE] = {0};
+#define ADC_CFG_MAGIC    ((uint32_t) 0x32434441) /* "ADC2" */
+#define ADC_ENERGY_MAGIC ((uint32_t) 0x31474E45) /* "ENG1" */
+#define ADC_CAL_MAGIC    ((uint32_t) 0x314C4143) /* "CAL1" */
+#define ADC_CAL_ZERO_MAX ((uint32_t) 4095 << ADC_CAL_ZERO_Q )
+#define ADC_CAL_REF_MAX  (1000000)              /* mV or mA */
 
-static uint16_t* adc_get_dma_buff_ready( void )
+/* Last completed DMA half, sequence number above the half index. Written
+ * by the DMA interrupt as one word, so a reader always sees a matching pair.
+ */
+#define ADC_DMA_SEQ(r)   (( r ) >> 1 )
+#define ADC_DMA_HALF(r)  (( r ) & 1 )
+#define ADC_DMA_SEQ_MASK (0x7FFFFFFF)
+
+static volatile uint32_t adc_dma_ready = 0;
+static volatile uint32_t adc_dma_ts    = 0;   /* Completion time, us */
+
+/* Energy total as stored in flash */
+typedef struct
 {
-    static bool_t change = FALSE;
-    uint16_t*     ret;
+    uint32_t magic;
+    uint32_t reserved;
+    int64_t  energy;        /* uJ */
+} Adc_Energy_Rec_t;
 
-    if ( FALSE != change )
-    {
-        ret = &dma_data[ADC_DMA_BUFF_SIZE/2];
-    }
-    else
-    {
-        ret = &dma_data[0];
-    }
+/* V*I accumulators in counts^2. The window sum feeds the power readout,
+ * the energy sum collects every sample and is converted to uJ once per
+ * half buffer with the division remainder carried over.
+ */
+typedef struct
+{
+    int64_t  vi_sum;        /* Current window sum */
+    int64_t  e_raw;         /* Not yet converted energy */
+    int64_t  e_rem;         /* Conversion remainder, nW * samples */
+    uint32_t save_cnt;      /* Samples since last flash save */
+} Adc_Vi_t;
 
-    change = ~change;
+/* Zero crossing tracker of the reference channel. Crossing times are in
+ * samples with ADC_ZC_Q fractional bits, taken from a free running sample
+ * index, so differences stay valid across the index wrap.
+ */
+typedef struct
+{
+    bool_t   armed;         /* Signal was below -hysteresis */
+    bool_t   synced;        /* Windows are aligned to a crossing */
+    int32_t  prev;          /* Previous reference sample, level removed */
+    uint32_t idx;           /* Index of the next unconsumed sample */
+    uint32_t t_last;        /* Last crossing time */
+    uint32_t t_start;       /* Window start crossing time */
+    uint32_t p_min;         /* Shortest period in the window */
+    uint32_t p_max;         /* Longest period in the window */
+    uint16_t periods;       /* Whole periods in the window */
+} Adc_Zc_t;
 
-    HAL_GPIO_TogglePin( GPIOB, GPIO_PIN_15 );
+static uint16_t        dma_data[ADC_DMA_BUFF_SIZE] = {0};
+static Adc_Rms_t       adc_rms[ADC_CH_NUM];
+static Adc_Zc_t        adc_zc;
+static Adc_Line_t      adc_line;
+static Adc_Vi_t        adc_vi;
+static Adc_Power_t     adc_power;
+static Adc_Dma_Stats_t adc_dma_stats;
+static uint32_t        adc_dma_done = 0;     /* Last processed sequence */
+static uint32_t        adc_fs;               /* Output rate after decimation */
+static uint32_t        adc_shift;            /* Decimation fractional bits */
+static int32_t         adc_zero[ADC_CH_NUM]; /* Zero point with adc_shift */
+static uint32_t        adc_scale[ADC_CH_NUM];/* uV or uA per count, Q16 */
+static int64_t         adc_vi_scale;         /* nW per count^2 */
+static Adc_Cal_Run_t   adc_cal_run;
+static uint64_t        adc_cal_sum;
 
-    return ret;
-}
+static Adc_Cfg_t adc_cfg =
+{
+    .magic   = ADC_CFG_MAGIC,
+    .mode    = ADC_MODE_DC,
+    .ref_ch  = 0,
+    .periods = ADC_AC_PERIODS_DEF,
+    .samples = ADC_DC_SAMPLES_DEF,
+    .hyst    = ADC_ZC_HYST,
+    .dec     = 0,
+    .rate    = ADC_RATE_DEF
+};
+
+/* Nominal scale per channel, uV or uA per count */
+static const uint32_t adc_ch_scale[ADC_CH_NUM] =
+{
+    ADC_I_SCALE_UA,
+    ADC_V_SCALE_UV
+};
+
+/* Zero point per channel, subtracted before squaring. For the current
+ * sensing with ACS71240 zero is nominally Vref/2, auto-zero measures it.
+ */
+static const uint16_t adc_ch_offset[ADC_CH_NUM] =
+{
+    ADC_ACS71240_ZERO << ADC_CAL_ZERO_Q,
+    0
+};
+
+static Adc_Cal_t adc_cal =
+{
+    .magic = ADC_CAL_MAGIC,
+    .zero  = { ADC_ACS71240_ZERO << ADC_CAL_ZERO_Q, 0 },
+    .gain  = { 1UL << ADC_CAL_GAIN_Q, 1UL << ADC_CAL_GAIN_Q }
+};
 
 status_t adc_init( void )
 {
@@ -124,69 +224,1042 @@ status_t adc_stop( void )
     return ret;
 }
 
-void adc_calc_rms( Adc_Rms_t* rms )
+static void adc_rms_reset_window( Adc_Rms_t* rms )
+{
+    rms->curr_cnt = 0;
+    rms->sum      = 0;
+    rms->dc_sum   = 0;
+    rms->win_max  = INT32_MIN;
+    rms->win_min  = INT32_MAX;
+}
+
+/* In DC mode the window is closed on the first sample after req_samples
+ * were summed, that sample is not accumulated. Kept as is so RMS results
+ * stay identical to the former per-sample implementation. In AC mode the
+ * same path is only the timeout when no zero crossing shows up.
+ */
+static void adc_rms_close( Adc_Rms_t* rms )
 {
-    uint16_t*       frame_r;
-    uint16_t        i;
-    static uint16_t ch_idx = 0;
+    uint32_t n       = rms->curr_cnt;
+    uint32_t mean_sq = 0;
+    uint64_t var_n2;
+    uint32_t peak;
 
-    frame_r = adc_get_dma_buff_ready();
+    if ( 0 != n )
+    {
+        mean_sq = (uint32_t)( rms->sum / n );
+    }
 
-    for ( i = 0; i < ADC_DMA_BUFF_SIZE / 2; i++ )
+    rms->last = isqrt32( mean_sq );
+
+    if ( 0 != n )
     {
-        if ( rms[ch_idx].curr_cnt < rms[ch_idx].req_samples )
+        /* n^2 * variance = n * sum(x^2) - sum(x)^2, never negative */
+        var_n2 = ( n * rms->sum )
+               - (uint64_t)( rms->dc_sum * rms->dc_sum );
+
+        rms->dc      = (int32_t)( rms->dc_sum / (int32_t) n );
+        rms->ac      = isqrt64( var_n2 ) / n;
+        rms->max     = rms->win_max;
+        rms->min     = rms->win_min;
+        rms->p2p     = (uint32_t)( rms->win_max - rms->win_min );
+        rms->samples = n;
+
+        peak = (uint32_t)(( rms->win_max > -rms->win_min ) ? rms->win_max
+                                                            : -rms->win_min );
+
+        rms->crest = 0;
+
+        if ( 0 != rms->last )
         {
-            uint32_t value;
+            rms->crest = ( peak << ADC_CREST_Q ) / rms->last;
+        }
+    }
+
+    adc_rms_reset_window( rms );
+}
+
+static void adc_win_reset( void )
+{
+    uint8_t ch;
+
+    for ( ch = 0; ch < ADC_CH_NUM; ch++ )
+    {
+        adc_rms_reset_window( &adc_rms[ch] );
+    }
+
+    adc_vi.vi_sum = 0;
+}
+
+/* Windows of all channels open and close together */
+static void adc_win_close( void )
+{
+    const int64_t n = adc_rms[ADC_CH_I].curr_cnt;
+    int64_t       ui;
+    uint8_t       ch;
+
+    for ( ch = 0; ch < ADC_CH_NUM; ch++ )
+    {
+        adc_rms_close( &adc_rms[ch] );
+    }
+
+    ui = (int64_t) adc_rms[ADC_CH_I].last * adc_rms[ADC_CH_V].last;
+
+    /* Products carry twice the decimation fractional bits */
+    adc_power.s  = (uint32_t)(( ui * adc_vi_scale )
+                              / ( 1000000 << ( 2 * adc_shift )));
+    adc_power.p  = 0;
+    adc_power.pf = 0;
+
+    if ( 0 != n )
+    {
+        adc_power.p = (int32_t)((( adc_vi.vi_sum / n ) * adc_vi_scale )
+                                / ( 1000000 << ( 2 * adc_shift )));
+    }
+
+    if (( 0 != n ) && ( 0 != ui ))
+    {
+        adc_power.pf = (int16_t)(( adc_vi.vi_sum * 1000 ) / ( n * ui ));
+    }
+
+    adc_vi.vi_sum = 0;
+}
+
+/* Accumulate a run of pairs which doesn't cross any window boundary, so the
+ * inner loop has neither channel index arithmetic nor window checks.
+ */
+static void adc_rms_run( const uint16_t* frame, uint32_t run )
+{
+    const int32_t off0 = adc_zero[0];
+    const int32_t off1 = adc_zero[1];
+    Adc_Rms_t*    rms  = adc_rms;
+    uint32_t      sq0  = 0;
+    uint32_t      sq1  = 0;
+    int32_t       sum0 = 0;
+    int32_t       sum1 = 0;
+    int32_t       max0 = rms[0].win_max;
+    int32_t       min0 = rms[0].win_min;
+    int32_t       max1 = rms[1].win_max;
+    int32_t       min1 = rms[1].win_min;
+    int32_t       vi   = 0;
+    uint32_t      i;
+    int32_t       d0;
+    int32_t       d1;
+
+    /* Run length is limited by the half buffer (128 pairs), 32-bit
+     * partial sums of 12-bit samples and their products can't overflow here.
+     * Decimation by 4^n adds n bits per sample but divides the run by 4^n.
+     */
+    for ( i = 0; i < run; i++ )
+    {
+        d0 = (int32_t) frame[0] - off0;
+        d1 = (int32_t) frame[1] - off1;
+
+        sq0  += (uint32_t)( d0 * d0 );
+        sq1  += (uint32_t)( d1 * d1 );
+        vi   += d0 * d1;
+        sum0 += d0;
+        sum1 += d1;
+
+        max0 = ( d0 > max0 ) ? d0 : max0;
+        min0 = ( d0 < min0 ) ? d0 : min0;
+        max1 = ( d1 > max1 ) ? d1 : max1;
+        min1 = ( d1 < min1 ) ? d1 : min1;
+
+        frame += ADC_CH_NUM;
+    }
+
+    rms[0].sum      += sq0;
+    rms[0].dc_sum   += sum0;
+    rms[0].win_max   = max0;
+    rms[0].win_min   = min0;
+    rms[0].curr_cnt += run;
+    rms[1].sum      += sq1;
+    rms[1].dc_sum   += sum1;
+    rms[1].win_max   = max1;
+    rms[1].win_min   = min1;
+    rms[1].curr_cnt += run;
+
+    adc_vi.vi_sum += vi;
+    adc_vi.e_raw  += vi;
+}
+
+/* Scan the reference channel for the next rising zero crossing. The level
+ * is the channel zero point plus the mean of the last window, so biased
+ * inputs work as well. On a crossing the index of the first sample past it
+ * is stored to idx and the interpolated crossing time to t.
+ */
+static bool_t adc_zc_scan( const uint16_t* frame
+                         , uint32_t        pairs
+                         , uint32_t*       idx
+                         , uint32_t*       t
+                         )
+{
+    const uint8_t ch    = adc_cfg.ref_ch;
+    const int32_t level = adc_zero[ch] + adc_rms[ch].dc;
+    const int32_t hyst  = adc_cfg.hyst << adc_shift;
+    bool_t        ret   = FALSE;
+    uint32_t      frac;
+    uint32_t      i;
+    int32_t       d;
+
+    frame += ch;
+
+    for ( i = 0; i < pairs; i++ )
+    {
+        d = (int32_t) frame[0] - level;
+
+        if ( d < -hyst )
+        {
+            adc_zc.armed = TRUE;
+        }
+        else if (( FALSE != adc_zc.armed ) && ( d >= 0 ))
+        {
+            /* Linear interpolation between previous (< 0) and this sample */
+            frac = (uint32_t)(( -adc_zc.prev << ADC_ZC_Q )
+                              / ( d - adc_zc.prev ));
+
+            *t   = (( adc_zc.idx + i - 1 ) << ADC_ZC_Q ) + frac;
+            *idx = i;
+
+            adc_zc.armed = FALSE;
+            adc_zc.prev  = d;
+            ret          = TRUE;
+            break;
+        }
+
+        adc_zc.prev = d;
+        frame      += ADC_CH_NUM;
+    }
+
+    return ret;
+}
+
+static void adc_zc_unlock( void )
+{
+    adc_zc.synced   = FALSE;
+    adc_line.locked = FALSE;
+    adc_line.freq   = 0;
+    adc_line.jitter = 0;
+}
+
+static void adc_zc_crossing( uint32_t t )
+{
+    uint32_t period = t - adc_zc.t_last;
+    bool_t   start  = TRUE;
+    uint32_t span;
+
+    if ( FALSE == adc_zc.synced )
+    {
+        /* First crossing only aligns the windows */
+        adc_win_reset();
+
+        adc_zc.synced = TRUE;
+    }
+    else
+    {
+        adc_zc.periods++;
+
+        adc_zc.p_min = ( period < adc_zc.p_min ) ? period : adc_zc.p_min;
+        adc_zc.p_max = ( period > adc_zc.p_max ) ? period : adc_zc.p_max;
+
+        if ( adc_zc.periods < adc_cfg.periods )
+        {
+            start = FALSE;
+        }
+        else
+        {
+            adc_win_close();
+
+            span = t - adc_zc.t_start;
+
+            adc_line.freq   = (uint32_t)((( (uint64_t) adc_cfg.periods
+                                          * adc_fs * 1000 )
+                                          << ADC_ZC_Q ) / span );
+            adc_line.jitter = (uint32_t)(( (uint64_t)( adc_zc.p_max
+                                                     - adc_zc.p_min )
+                                          * 1000000 )
+                                        / ( (uint64_t) adc_fs << ADC_ZC_Q ));
+            adc_line.locked = TRUE;
+        }
+    }
+
+    if ( FALSE != start )
+    {
+        adc_zc.periods = 0;
+        adc_zc.p_min   = UINT32_MAX;
+        adc_zc.p_max   = 0;
+        adc_zc.t_start = t;
+    }
+
+    adc_zc.t_last = t;
+}
+
+/* Process interleaved channel pairs in one pass. Pairs are consumed in runs
+ * which end on the nearest window boundary or, in AC mode, on the next zero
+ * crossing of the reference channel.
+ */
+static void adc_rms_block( const uint16_t* frame, uint32_t pairs )
+{
+    const bool_t ac = ( ADC_MODE_AC == adc_cfg.mode );
+    bool_t       found = FALSE;
+    uint32_t     run;
+    uint32_t     left;
+    uint32_t     cross = 0;
+    uint32_t     t     = 0;
+    uint8_t      ch;
+
+    while ( pairs > 0 )
+    {
+        run = pairs;
 
-            if ( 0 == ch_idx )
+        for ( ch = 0; ch < ADC_CH_NUM; ch++ )
+        {
+            if ( adc_rms[ch].curr_cnt >= adc_rms[ch].req_samples )
             {
-                /* For the current sensing with ACS71240 zero is a Vref/2 */
-                if ( frame_r[i] >= 2048 )
+                run = 0;
+            }
+            else
+            {
+                left = adc_rms[ch].req_samples - adc_rms[ch].curr_cnt;
+
+                if ( left < run )
                 {
-                    value = frame_r[i] - 2048;
+                    run = left;
                 }
-                else
+            }
+        }
+
+        if ( FALSE != ac )
+        {
+            /* Keep the tracker in step with consumed samples */
+            found = adc_zc_scan( frame, ( 0 == run ) ? 1 : run, &cross, &t );
+        }
+
+        if ( 0 == run )
+        {
+            /* Windows close on this pair, it only counts for the energy */
+            adc_win_close();
+
+            adc_vi.e_raw += ( (int32_t) frame[ADC_CH_I] - adc_zero[ADC_CH_I] )
+                          * ( (int32_t) frame[ADC_CH_V] - adc_zero[ADC_CH_V] );
+
+            if ( FALSE != ac )
+            {
+                /* No crossing within the longest allowed window */
+                adc_zc_unlock();
+            }
+
+            frame += ADC_CH_NUM;
+            pairs--;
+            adc_zc.idx++;
+        }
+        else
+        {
+            if ( FALSE != found )
+            {
+                /* Crossing sample starts the next run */
+                run = cross;
+            }
+
+            adc_rms_run( frame, run );
+
+            frame      += run * ADC_CH_NUM;
+            pairs      -= run;
+            adc_zc.idx += run;
+
+            if ( FALSE != found )
+            {
+                adc_zc_crossing( t );
+            }
+        }
+    }
+}
+/* Pipeline state for decimation 4^dec at the current trigger rate, all
+ * windows restart. In AC mode the window length is only the timeout for a
+ * missing zero crossing.
+ */
+static void adc_pipeline_cfg( uint8_t dec )
+{
+    uint32_t req = adc_cfg.samples;
+    uint8_t  ch;
+
+    adc_shift = dec;
+    adc_fs    = tmr_adc_get_rate() >> ( 2 * adc_shift );
+
+    if ( ADC_MODE_AC == adc_cfg.mode )
+    {
+        req = ( adc_cfg.periods * adc_fs / ADC_AC_FREQ_MIN ) + 1;
+
+        if ( req > ADC_WIN_MAX )
+        {
+            req = ADC_WIN_MAX;
+        }
+    }
+
+    for ( ch = 0; ch < ADC_CH_NUM; ch++ )
+    {
+        memset( &adc_rms[ch], 0, sizeof( Adc_Rms_t ));
+
+        adc_rms[ch].req_samples = req;
+        adc_rms[ch].shift       = adc_shift;
+
+        /* Calibration works on window results and the zero point already
+         * subtracted per sample, the inner loops stay as they are.
+         */
+        adc_zero[ch]  = (int32_t)((( (uint32_t) adc_cal.zero[ch] << adc_shift )
+                                   + ( 1UL << ( ADC_CAL_ZERO_Q - 1 )))
+                                  >> ADC_CAL_ZERO_Q );
+        adc_scale[ch] = adc_ch_scale[ch] * adc_cal.gain[ch];
+    }
+
+    adc_vi_scale = (int64_t)((( (uint64_t) adc_scale[ADC_CH_I]
+                               * adc_scale[ADC_CH_V] ) / 1000 )
+                             >> ( 2 * ADC_CAL_GAIN_Q ));
+
+    adc_win_reset();
+
+    memset( &adc_zc, 0, sizeof( Adc_Zc_t ));
+    adc_zc_unlock();
+}
+
+/* Restart all windows with the current configuration */
+static void adc_apply_cfg( void )
+{
+    (void) tmr_adc_set_rate( adc_cfg.rate );
+
+    adc_pipeline_cfg( adc_cfg.dec );
+
+    /* Averages taken with another decimation would be off */
+    if ( ADC_CAL_BUSY == adc_cal_run.state )
+    {
+        adc_cal_run.state = ADC_CAL_FAILED;
+    }
+}
+
+status_t adc_cfg_load( void )
+{
+    status_t  ret;
+    Adc_Cfg_t cfg;
+
+    ret = flash_read( &cfg, sizeof( Adc_Cfg_t ), FLASH_OFFS_ADC_CFG );
+
+    if (( STATUS_OK == ret ) && ( ADC_CFG_MAGIC == cfg.magic ))
+    {
+        if (( cfg.mode <= ADC_MODE_AC )
+         && ( cfg.ref_ch < ADC_CH_NUM )
+         && ( cfg.periods > 0 ) && ( cfg.periods <= ADC_AC_PERIODS_MAX )
+         && ( cfg.samples > 0 )
+         && ( cfg.dec <= ADC_DEC_MAX )
+         && ( cfg.rate > 0 ) && ( cfg.rate <= ADC_RATE_MAX ))
+        {
+            adc_cfg = cfg;
+        }
+    }
+
+    adc_apply_cfg();
+
+    return ret;
+}
+
+status_t adc_cfg_save( void )
+{
+    return flash_write( &adc_cfg, sizeof( Adc_Cfg_t ), FLASH_OFFS_ADC_CFG );
+}
+
+const Adc_Cfg_t* adc_get_cfg( void )
+{
+    return &adc_cfg;
+}
+
+/* Length is samples per window in DC mode and mains periods in AC mode */
+status_t adc_set_mode( Adc_Mode_t mode, uint16_t len )
+{
+    status_t ret = STATUS_ERROR;
+
+    if (( ADC_MODE_DC == mode ) && ( len > 0 ))
+    {
+        adc_cfg.samples = len;
+        ret             = STATUS_OK;
+    }
+    else if (( ADC_MODE_AC == mode )
+          && ( len > 0 ) && ( len <= ADC_AC_PERIODS_MAX ))
+    {
+        adc_cfg.periods = len;
+        ret             = STATUS_OK;
+    }
+
+    if ( STATUS_OK == ret )
+    {
+        adc_cfg.mode = (uint8_t) mode;
+        adc_apply_cfg();
+    }
+
+    return ret;
+}
+
+status_t adc_set_ref_ch( uint8_t ch )
+{
+    status_t ret = STATUS_ERROR;
+
+    if ( ch < ADC_CH_NUM )
+    {
+        adc_cfg.ref_ch = ch;
+        adc_apply_cfg();
+        ret = STATUS_OK;
+    }
+
+    return ret;
+}
+
+/* Trigger rate is rounded to what the timer can do, see adc_get_cfg() */
+status_t adc_set_rate( uint32_t rate )
+{
+    status_t ret = STATUS_ERROR;
+
+    if (( rate > 0 ) && ( rate <= ADC_RATE_MAX ))
+    {
+        ret = tmr_adc_set_rate( rate );
+    }
+
+    if ( STATUS_OK == ret )
+    {
+        adc_cfg.rate = tmr_adc_get_rate();
+        adc_apply_cfg();
+    }
+
+    return ret;
+}
+
+status_t adc_set_dec( uint8_t dec )
+{
+    status_t ret = STATUS_ERROR;
+
+    if ( dec <= ADC_DEC_MAX )
+    {
+        adc_cfg.dec = dec;
+        adc_apply_cfg();
+        ret = STATUS_OK;
+    }
+
+    return ret;
+}
+
+uint32_t adc_get_fs( void )
+{
+    return adc_fs;
+}
+
+/* Convert accumulated V*I samples to uJ and save the total periodically.
+ * Flash update stalls the CPU for tens of milliseconds, so it is rare.
+ */
+static void adc_energy_update( uint32_t pairs )
+{
+    const int64_t div = ((int64_t) adc_fs * 1000 ) << ( 2 * adc_shift );
+    int64_t       acc;
+
+    acc = ( adc_vi.e_raw * adc_vi_scale ) + adc_vi.e_rem;
+
+    adc_power.energy += acc / div;
+    adc_vi.e_rem      = acc % div;
+    adc_vi.e_raw      = 0;
+
+    adc_vi.save_cnt += pairs;
+
+    if ( adc_vi.save_cnt >= ( adc_fs * ADC_ENERGY_SAVE_S ))
+    {
+        adc_vi.save_cnt = 0;
+        (void) adc_energy_save();
+    }
+}
+
+status_t adc_energy_load( void )
+{
+    status_t         ret;
+    Adc_Energy_Rec_t rec;
+
+    ret = flash_read( &rec, sizeof( Adc_Energy_Rec_t ), FLASH_OFFS_ENERGY );
+
+    if (( STATUS_OK == ret ) && ( ADC_ENERGY_MAGIC == rec.magic ))
+    {
+        adc_power.energy = rec.energy;
+    }
+
+    return ret;
+}
+
+status_t adc_energy_save( void )
+{
+    Adc_Energy_Rec_t rec;
+
+    rec.magic    = ADC_ENERGY_MAGIC;
+    rec.reserved = 0;
+    rec.energy   = adc_power.energy;
+
+    return flash_write( &rec, sizeof( Adc_Energy_Rec_t ), FLASH_OFFS_ENERGY );
+}
+
+status_t adc_energy_reset( void )
+{
+    adc_power.energy = 0;
+    adc_vi.e_rem     = 0;
+    adc_vi.save_cnt  = 0;
+
+    return adc_energy_save();
+}
+
+/* Coefficients from the mean of a finished run. Auto-zero takes the mean
+ * as zero point. Two gain points of one channel give the scale as reference
+ * difference over mean difference, zero follows from the first point.
+ */
+static void adc_cal_finish( void )
+{
+    Adc_Cal_Run_t* run   = &adc_cal_run;
+    const int64_t  den   = (int64_t) run->samples << adc_shift;
+    const int64_t  unit  = (int64_t) 1000 << ( ADC_CAL_GAIN_Q
+                                             + ADC_CAL_ZERO_Q );
+    const int64_t  nom   = adc_ch_scale[run->ch];
+    bool_t         apply = FALSE;
+    int32_t        mean;
+    int64_t        gain;
+    int64_t        zero;
+
+    mean       = (int32_t)(((int64_t)( adc_cal_sum << ADC_CAL_ZERO_Q )
+                            + ( den / 2 )) / den );
+    run->state = ADC_CAL_DONE;
+
+    if ( 0 == run->point )
+    {
+        adc_cal.zero[run->ch] = (uint16_t) mean;
+        apply                 = TRUE;
+    }
+    else
+    {
+        run->mean[run->point - 1]  = mean;
+        run->valid                |= (uint8_t)( 1 << ( run->point - 1 ));
+
+        if ( 3 == run->valid )
+        {
+            run->state = ADC_CAL_FAILED;
+
+            if ( run->mean[1] != run->mean[0] )
+            {
+                gain = ((int64_t)( run->ref[1] - run->ref[0] ) * unit )
+                     / ( run->mean[1] - run->mean[0] );
+                gain = ( gain + ( nom / 2 )) / nom;
+
+                if (( gain >= (int64_t) ADC_CAL_GAIN_MIN )
+                 && ( gain <= (int64_t) ADC_CAL_GAIN_MAX ))
                 {
-                    value = 2048 - frame_r[i];
+                    zero = run->mean[0]
+                         - (( (int64_t) run->ref[0] * unit ) / ( nom * gain ));
+
+                    if (( zero >= 0 ) && ( zero <= ADC_CAL_ZERO_MAX ))
+                    {
+                        adc_cal.zero[run->ch] = (uint16_t) zero;
+                        adc_cal.gain[run->ch] = (uint32_t) gain;
+                        run->state            = ADC_CAL_DONE;
+                        apply                 = TRUE;
+                    }
                 }
             }
-            else
+        }
+    }
+
+    if ( FALSE != apply )
+    {
+        adc_apply_cfg();
+    }
+}
+
+/* Average raw samples of the channel under calibration. Only runs while a
+ * calibration step is active, measurement goes on meanwhile.
+ */
+static void adc_cal_feed( const uint16_t* frame, uint32_t pairs )
+{
+    const uint16_t* sample = &frame[adc_cal_run.ch];
+    uint32_t        n;
+
+    n = ( pairs < adc_cal_run.left ) ? pairs : adc_cal_run.left;
+
+    adc_cal_run.left -= n;
+
+    while ( n-- > 0 )
+    {
+        adc_cal_sum += *sample;
+        sample      += ADC_CH_NUM;
+    }
+
+    if ( 0 == adc_cal_run.left )
+    {
+        adc_cal_finish();
+    }
+}
+
+static status_t adc_cal_start( uint8_t ch, uint8_t point, uint32_t samples )
+{
+    status_t ret = STATUS_ERROR;
+
+    if (( ch < ADC_CH_NUM )
+     && ( 0 != samples )
+     && ( ADC_CAL_BUSY != adc_cal_run.state ))
+    {
+        if ( ch != adc_cal_run.ch )
+        {
+            adc_cal_run.valid = 0;
+        }
+
+        adc_cal_run.ch      = ch;
+        adc_cal_run.point   = point;
+        adc_cal_run.samples = samples;
+        adc_cal_run.left    = samples;
+        adc_cal_run.state   = ADC_CAL_BUSY;
+        adc_cal_sum         = 0;
+
+        ret = STATUS_OK;
+    }
+
+    return ret;
+}
+
+status_t adc_cal_load( void )
+{
+    status_t  ret;
+    Adc_Cal_t cal;
+    uint8_t   ch;
+    bool_t    valid;
+
+    ret = flash_read( &cal, sizeof( Adc_Cal_t ), FLASH_OFFS_ADC_CAL );
+
+    if (( STATUS_OK == ret ) && ( ADC_CAL_MAGIC == cal.magic ))
+    {
+        valid = TRUE;
+
+        for ( ch = 0; ch < ADC_CH_NUM; ch++ )
+        {
+            if (( cal.zero[ch] > ADC_CAL_ZERO_MAX )
+             || ( cal.gain[ch] < ADC_CAL_GAIN_MIN )
+             || ( cal.gain[ch] > ADC_CAL_GAIN_MAX ))
             {
-                value = frame_r[i];
+                valid = FALSE;
             }
+        }
 
-            rms[ch_idx].sum += ( value * value );
-            rms[ch_idx].curr_cnt++;
+        if ( FALSE != valid )
+        {
+            adc_cal = cal;
         }
-        else
+    }
+
+    adc_apply_cfg();
+
+    return ret;
+}
+
+status_t adc_cal_save( void )
+{
+    return flash_write( &adc_cal, sizeof( Adc_Cal_t ), FLASH_OFFS_ADC_CAL );
+}
+
+/* Back to nominal zero and scale, takes effect without saving */
+status_t adc_cal_reset( uint8_t ch )
+{
+    status_t ret = STATUS_ERROR;
+
+    if ( ch < ADC_CH_NUM )
+    {
+        adc_cal.zero[ch] = adc_ch_offset[ch];
+        adc_cal.gain[ch] = 1UL << ADC_CAL_GAIN_Q;
+
+        if ( ch == adc_cal_run.ch )
+        {
+            adc_cal_run.valid = 0;
+        }
+
+        adc_apply_cfg();
+        ret = STATUS_OK;
+    }
+
+    return ret;
+}
+
+/* Average samples at no load, the mean becomes the zero point */
+status_t adc_cal_zero( uint8_t ch, uint32_t samples )
+{
+    return adc_cal_start( ch, 0, samples );
+}
+
+/* Average samples with the reference applied as point 1 or 2. DC
+ * references only, the mean is taken, not the RMS.
+ */
+status_t adc_cal_point( uint8_t  ch
+                      , uint8_t  point
+                      , int32_t  ref
+                      , uint32_t samples
+                      )
+{
+    status_t ret = STATUS_ERROR;
+
+    if (( point >= 1 ) && ( point <= ADC_CAL_POINTS )
+     && ( ref >= -ADC_CAL_REF_MAX ) && ( ref <= ADC_CAL_REF_MAX ))
+    {
+        ret = adc_cal_start( ch, point, samples );
+    }
+
+    if ( STATUS_OK == ret )
+    {
+        adc_cal_run.ref[point - 1]  = ref;
+        adc_cal_run.valid          &= (uint8_t) ~( 1 << ( point - 1 ));
+    }
+
+    return ret;
+}
+
+const Adc_Cal_t* adc_get_cal( void )
+{
+    return &adc_cal;
+}
+
+void adc_get_cal_run( Adc_Cal_Run_t* run )
+{
+    *run = adc_cal_run;
+}
+
+/* Boxcar decimation in place, 4^n input pairs are summed and scaled by
+ * 2^-n, so each output keeps n fractional bits. It's a first order CIC
+ * with the half buffer being a multiple of the ratio, so no state is
+ * carried between halves. Returns number of output pairs.
+ */
+static uint32_t adc_decimate( uint16_t* frame, uint32_t pairs )
+{
+    const uint32_t  shift = adc_shift;
+    const uint32_t  ratio = 1UL << ( 2 * shift );
+    const uint32_t  round = ( 1UL << shift ) >> 1;
+    const uint16_t* in    = frame;
+    uint16_t*       out   = frame;
+    uint32_t        ret   = pairs >> ( 2 * shift );
+    uint32_t        acc0;
+    uint32_t        acc1;
+    uint32_t        i;
+    uint32_t        j;
+
+    for ( i = 0; i < ret; i++ )
+    {
+        acc0 = round;
+        acc1 = round;
+
+        for ( j = 0; j < ratio; j++ )
         {
-            /* Do the math if enough number of samples is collected
-             * for the RMS evaluation
-             */
-            uint32_t tmp;
+            acc0 += in[0];
+            acc1 += in[1];
+            in   += ADC_CH_NUM;
+        }
+
+        out[0] = (uint16_t)( acc0 >> shift );
+        out[1] = (uint16_t)( acc1 >> shift );
+        out   += ADC_CH_NUM;
+    }
+
+    return ret;
+}
+
+/* Measurement part of the pipeline, returns number of output pairs */
+static uint32_t adc_measure( uint16_t* frame )
+{
+    uint32_t pairs = ADC_DMA_BUFF_SIZE / 2 / ADC_CH_NUM;
 
-            tmp = rms[ch_idx].sum
-                / rms[ch_idx].req_samples;
+    if ( 0 != adc_shift )
+    {
+        pairs = adc_decimate( frame, pairs );
+    }
+
+    adc_rms_block( frame, pairs );
+    adc_energy_update( pairs );
+
+    return pairs;
+}
+
+static void adc_process( uint16_t* frame )
+{
+    const uint32_t pairs = adc_measure( frame );
+
+    if ( ADC_CAL_BUSY == adc_cal_run.state )
+    {
+        adc_cal_feed( frame, pairs );
+    }
+
+#if ( STREAM_ENABLED != 0 )
+    stream_feed( frame, pairs );
+#endif
+}
+
+/* Process the last half completed by the DMA. Halves completed in between
+ * are lost and counted as missed. When the DMA completes another half while
+ * processing, it was already rewriting the one being processed.
+ */
+void adc_calc_rms( void )
+{
+    uint32_t ready;
+    uint32_t ts;
+    uint32_t seq;
+    uint32_t lost;
+    Time_t   start;
+    Time_t   stop;
 
-            rms[ch_idx].last = sqrt( tmp );
+    __disable_irq();
+    ready = adc_dma_ready;
+    ts    = adc_dma_ts;
+    __enable_irq();
 
-            rms[ch_idx].curr_cnt = 0;
-            rms[ch_idx].sum      = 0;
+    seq = ADC_DMA_SEQ( ready );
+
+    if ( seq != adc_dma_done )
+    {
+        get_time( &start );
+
+        PROF_BEGIN( PROF_ADC );
+
+        adc_process( &dma_data[ADC_DMA_HALF( ready )
+                              * ( ADC_DMA_BUFF_SIZE / 2 )] );
+
+        PROF_END( PROF_ADC );
+
+        get_time( &stop );
+
+        lost = ( seq - adc_dma_done - 1 ) & ADC_DMA_SEQ_MASK;
+
+        adc_dma_stats.missed   += lost;
+        adc_dma_stats.lat_last  = (uint32_t) start - ts;
+        adc_dma_stats.proc_last = (uint32_t)( stop - start );
+
+        if ( adc_dma_stats.lat_last > adc_dma_stats.lat_max )
+        {
+            adc_dma_stats.lat_max = adc_dma_stats.lat_last;
+        }
+        if ( adc_dma_stats.proc_last > adc_dma_stats.proc_max )
+        {
+            adc_dma_stats.proc_max = adc_dma_stats.proc_last;
+        }
+        if ( ADC_DMA_SEQ( adc_dma_ready ) != seq )
+        {
+            adc_dma_stats.late++;
         }
 
-        ch_idx++;
-        ch_idx = ch_idx % 2;
+        adc_dma_stats.processed++;
+        adc_dma_done = seq;
     }
 }
 
-void adc_set_rms_flag( bool_t state )
+/* Time the measurement pipeline with decimation 4^dec on synthetic data.
+ * ADC DMA is stopped meanwhile, so the first DMA half is free to hold the
+ * data, and halves completed before are dropped. Calibration and stream
+ * are not fed, measurement state is restored afterwards. Returns average
+ * processing time of a half buffer in us, the highest sustainable trigger
+ * rate is 128 pairs over that time.
+ */
+uint32_t adc_bench( uint8_t dec )
 {
-    adc_rms_flag = state;
+    const Adc_Vi_t    vi    = adc_vi;
+    const Adc_Power_t power = adc_power;
+    const Adc_Line_t  line  = adc_line;
+    const Adc_Zc_t    zc    = adc_zc;
+    Adc_Rms_t         rms[ADC_CH_NUM];
+    uint64_t          total = 0;
+    Time_t            start;
+    Time_t            stop;
+    uint32_t          run;
+    uint32_t          i;
+    int32_t           tri;
+
+    memcpy( rms, adc_rms, sizeof( rms ));
+
+    (void) HAL_ADC_Stop_DMA( &adc_hdl );
+
+    __disable_irq();
+    adc_dma_done = ADC_DMA_SEQ( adc_dma_ready );
+    __enable_irq();
+
+    adc_pipeline_cfg(( dec > ADC_DEC_MAX ) ? ADC_DEC_MAX : dec );
+
+    adc_vi.save_cnt = 0;
+
+    for ( run = 0; run < ADC_BENCH_RUNS; run++ )
+    {
+        /* Triangle around the zero points, 64 samples per period */
+        for ( i = 0; i < ( ADC_DMA_BUFF_SIZE / 2 / ADC_CH_NUM ); i++ )
+        {
+            tri = (int32_t)( i & 0x1F ) - 16;
+
+            if ( 0 != ( i & 0x20 ))
+            {
+                tri = -tri;
+            }
+
+            dma_data[i * ADC_CH_NUM]     = (uint16_t)( 2048 + 64 * tri );
+            dma_data[i * ADC_CH_NUM + 1] = (uint16_t)( 2048 + 32 * tri );
+        }
+
+        get_time( &start );
+        (void) adc_measure( dma_data );
+        get_time( &stop );
+
+        total += stop - start;
+    }
+
+    adc_pipeline_cfg( adc_cfg.dec );
+
+    memcpy( adc_rms, rms, sizeof( rms ));
+    adc_zc    = zc;
+    adc_line  = line;
+    adc_vi    = vi;
+    adc_power = power;
+
+    (void) HAL_ADC_Start_DMA( &adc_hdl
+                            , (uint32_t*) dma_data
+                            , ADC_DMA_BUFF_SIZE
+                            );
+
+    return (uint32_t)( total / ADC_BENCH_RUNS );
+}
+
+const Adc_Rms_t* adc_get_rms( uint8_t ch )
+{
+    return &adc_rms[ch % ADC_CH_NUM];
+}
+
+uint32_t adc_get_milli( uint8_t ch )
+{
+    const Adc_Rms_t* rms   = &adc_rms[ch % ADC_CH_NUM];
+    const uint64_t   scale = adc_scale[ch % ADC_CH_NUM];
+
+    return (uint32_t)((( rms->last * scale )
+                       >> ( rms->shift + ADC_CAL_GAIN_Q )) / 1000 );
+}
+
+void adc_get_line( Adc_Line_t* line )
+{
+    *line = adc_line;
+}
+
+void adc_get_power( Adc_Power_t* power )
+{
+    *power = adc_power;
 }
 
 bool_t adc_get_rms_flag( void )
 {
-    return adc_rms_flag;
+    return ( ADC_DMA_SEQ( adc_dma_ready ) != adc_dma_done );
+}
+
+void adc_get_dma_stats( Adc_Dma_Stats_t* stats )
+{
+    *stats     = adc_dma_stats;
+    stats->seq = ADC_DMA_SEQ( adc_dma_ready );
+}
+
+void adc_reset_dma_stats( void )
+{
+    memset( &adc_dma_stats, 0, sizeof( Adc_Dma_Stats_t ));
 }
 
 void HAL_ADC_MspInit( ADC_HandleTypeDef* adc )
@@ -221,10 +1294,36 @@ void HAL_ADC_MspInit( ADC_HandleTypeDef* adc )
     }
 }
 
+static void adc_dma_half_done( uint32_t half )
+{
+    Time_t now;
+
+    get_time( &now );
+
+    adc_dma_ts    = (uint32_t) now;
+    adc_dma_ready = (( ADC_DMA_SEQ( adc_dma_ready ) + 1 ) << 1 ) | half;
+
+    TRACE_MARK( TRACE_ADC_HALF, (uint16_t) ADC_DMA_SEQ( adc_dma_ready ));
+
+    event_post( EVENT_ADC );
+}
+
+void HAL_ADC_ConvHalfCpltCallback( ADC_HandleTypeDef* adc )
+{
+    (void) adc;
+
+    adc_dma_half_done( 0 );
+}
+
+void HAL_ADC_ConvCpltCallback( ADC_HandleTypeDef* adc )
+{
+    (void) adc;
+
+    adc_dma_half_done( 1 );
+}
+
 void dma1_ch1_irq_hdl( void )
 {
+    /* Calls back at half-full and full buffer */
     HAL_DMA_IRQHandler( &hdma_adc1 );
-
-    /* This handler is invoked twice - at half-full and full buffer */
-    adc_set_rms_flag( TRUE );
 }
@@ -7,6 +7,11 @@
  **
  ** Revision
  **   27-Aug-2020 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Use SPSC ring as storage
+ **   18-Oct-2026 (SSB) [] Incremental pattern search
+ **   18-Oct-2026 (SSB) [] Zero-copy spans, line read through memchr
+ **   18-Oct-2026 (SSB) [] Plain scan for patterns longer than the matcher
+ **   18-Oct-2026 (SSB) [] Line read needs room for a character
  **/
 
 #include "buffer.h"
@@ -19,16 +24,10 @@ status_t buffer_init( Buffer_t* buff, uint32_t size, void* buff_ptr )
 
     if (( NULL != buff ) && ( NULL != buff_ptr ))
     {
-
-        /* Set all values to zero */
-        memset( buff, 0, sizeof( Buffer_t ));
+        ret = ring_init( &buff->ring, size, buff_ptr );
 
         /* Set default values */
-        buff->size      = size;
-        buff->data      = buff_ptr;
         buff->delimiter = BUFFER_DEFAULT_DELIMITER;
-
-        ret = STATUS_OK;
     }
 
     return ret;
@@ -37,219 +36,206 @@ status_t buffer_init( Buffer_t* buff, uint32_t size, void* buff_ptr )
 uint32_t buffer_write( Buffer_t* buff, const void* data, uint32_t count )
 {
     uint32_t ret = 0;
-    uint32_t i   = 0;
-    uint32_t free;
-    uint32_t tocopy;
-    uint8_t* d;
 
     if ((( NULL != buff ) && ( NULL != data )) && ( count > 0 ))
     {
-        d = (uint8_t*) data;
-
-        /* Check input pointer */
-        if ( buff->in >= buff->size )
-        {
-            buff->in = 0;
-        }
+        ret = ring_write( &buff->ring, data, count );
+    }
 
-        free = buffer_get_free( buff );
+    return ret;
+}
 
-        if ( free != 0 )
-        {
-            if ( free < count )
-            {
-                count = free;
-            }
+uint32_t buffer_read( Buffer_t* buff, void* data, uint32_t count )
+{
+    uint32_t ret = 0;
 
-            /* Calculate number of elements to be put at the end of buffer */
-            tocopy = buff->size - buff->in;
+    if ((( NULL != buff ) && ( NULL != data )) && ( count > 0 ))
+    {
+        ret = ring_read( &buff->ring, data, count );
+    }
 
-            if ( tocopy > count )
-            {
-                tocopy = count;
-            }
+    return ret;
+}
 
-            memcpy( &buff->data[buff->in], data, tocopy );
+uint32_t buffer_get_free( Buffer_t* buff )
+{
+    uint32_t size = 0;
 
-            i        += tocopy;
-            buff->in += tocopy;
-            count   -= tocopy;
+    if ( NULL != buff )
+    {
+        size = ring_free( &buff->ring );
+    }
 
-            if ( count > 0 )
-            {
-                /* Start from the beginning of buffer*/
-                buff->in = 0;
+    return size;
+}
 
-                memcpy( &buff->data[buff->in], &d[i], count );
+uint32_t buffer_get_full( Buffer_t* buff )
+{
+    uint32_t size = 0;
 
-                buff->in = count;
-            }
+    if ( NULL != buff )
+    {
+        size = ring_count( &buff->ring );
+    }
 
-            if ( buff->in >= buff->size )
-            {
-                buff->in = 0;
-            }
+    return size;
+}
 
-            /* Return number of elements stored in memory */
-            ret = i + count;
-        }
+void buffer_reset( Buffer_t* buff )
+{
+    if ( NULL != buff )
+    {
+        ring_flush( &buff->ring );
     }
-
-    return ret;
 }
 
-uint32_t buffer_read( Buffer_t* buff, void* data, uint32_t count )
+int32_t buffer_find_element( Buffer_t* buff, const uint8_t element )
 {
-    uint32_t ret = 0;
-    uint32_t i   = 0;
-    uint32_t full;
-    uint32_t tocopy;
-    uint8_t* d;
+    int32_t        ret = -1;
+    Ring_Span_t    span[2];
+    const uint8_t* pos;
 
-    if ((( NULL != buff ) && ( NULL != data )) && ( count > 0 ))
+    if ( NULL != buff )
     {
-        d = (uint8_t*) data;
+        (void) ring_spans( &buff->ring, span );
+
+        pos = memchr( span[0].data, element, span[0].size );
 
-        /* Check output pointer */
-        if ( buff->out >= buff->size )
+        if ( NULL != pos )
         {
-            buff->out = 0;
+            ret = (int32_t)( pos - span[0].data );
         }
-
-        full = buffer_get_full( buff );
-
-        if ( full != 0 )
+        else
         {
-            if ( full < count )
-            {
-                count = full;
-            }
+            pos = memchr( span[1].data, element, span[1].size );
 
-            tocopy = buff->size - buff->out;
-
-            if ( tocopy > count )
+            if ( NULL != pos )
             {
-                tocopy = count;
+                ret = (int32_t)( span[0].size + ( pos - span[1].data ));
             }
+        }
+    }
 
-            memcpy( d, &buff->data[buff->out], tocopy );
-
-            i         += tocopy;
-            buff->out += tocopy;
-            count     -= tocopy;
+    return ret;
+}
 
-            if ( count > 0 )
-            {
-                buff->out = 0;
+uint32_t buffer_get_spans( Buffer_t* buff, Ring_Span_t* span )
+{
+    uint32_t ret = 0;
 
-                memcpy( &d[i],  &buff->data[buff->out], count );
+    if (( NULL != buff ) && ( NULL != span ))
+    {
+        ret = ring_spans( &buff->ring, span );
+    }
 
-                buff->out = count;
-            }
+    return ret;
+}
 
-            if ( buff-> out >= buff->size )
-            {
-                buff->out = 0;
-            }
+uint32_t buffer_get_line( Buffer_t* buff, Ring_Span_t* span )
+{
+    uint32_t ret = 0;
 
-            ret = i + count;
-        }
+    if (( NULL != buff ) && ( NULL != span ))
+    {
+        ret = ring_line( &buff->ring, buff->delimiter, span );
     }
 
     return ret;
 }
 
-uint32_t buffer_get_free( Buffer_t* buff )
+uint32_t buffer_skip( Buffer_t* buff, uint32_t count )
 {
-    uint32_t size = 0;
-    uint32_t in;
-    uint32_t out;
+    uint32_t ret = 0;
 
     if ( NULL != buff )
     {
-        in  = buff->in;
-        out = buff->out;
-
-        if ( out > in )
-        {
-            size = out - in;
-        }
-        else if ( in > out )
-        {
-            size = buff->size - ( in - out );
-        }
-        else
-        {
-            size = buff->size;
-        }
+        ret = ring_skip( &buff->ring, count );
     }
 
-    return ( size - 1 );
+    return ret;
 }
 
-uint32_t buffer_get_full( Buffer_t* buff )
+int32_t buffer_match( Buffer_t* buff, Match_t* match, int8_t* id )
 {
-    uint32_t size = 0;
-    uint32_t in;
-    uint32_t out;
+    int32_t  ret = -1;
+    uint32_t tail;
+    uint32_t head;
+    int8_t   hit;
 
-    if ( NULL != buff )
+    if (( NULL != buff ) && ( NULL != match ))
     {
-        in  = buff->in;
-        out = buff->out;
+        tail = buff->ring.tail;
+        head = RING_LOAD_ACQUIRE( &buff->ring.head );
 
-        if ( in > out )
+        /* Read past the scan position or flushed, partial matches are gone */
+        if (((int32_t)( match->pos - tail ) < 0 )
+         || (( match->pos - tail ) > ( head - tail )))
         {
-            size = in - out;
+            match_reset( match );
+            match->pos = tail;
         }
-        else if ( out > in )
+
+        if (( match->hit_id >= 0 ) && ((int32_t)( match->hit - tail ) < 0 ))
         {
-            size = buff->size - ( out - in );
+            match->hit_id = -1;
         }
-        else
+
+        /* Only bytes that arrived since the last call, until a match */
+        while (( match->hit_id < 0 ) && ( match->pos != head ))
         {
-            size = 0;
+            hit = match_step( match, ring_at( &buff->ring, match->pos - tail ));
+            match->pos++;
+
+            if (( hit >= 0 )
+             && ((int32_t)( match->pos - match->len[hit] - tail ) >= 0 ))
+            {
+                match->hit    = match->pos - match->len[hit];
+                match->hit_id = hit;
+            }
         }
-    }
 
-    return size;
-}
+        if ( match->hit_id >= 0 )
+        {
+            ret = (int32_t)( match->hit - tail );
 
-void buffer_reset( Buffer_t* buff )
-{
-    if ( NULL != buff )
-    {
-        buff->in  = 0;
-        buff->out = 0;
+            if ( NULL != id )
+            {
+                *id = match->hit_id;
+            }
+        }
     }
+
+    return ret;
 }
 
-int32_t buffer_find_element( Buffer_t* buff, const uint8_t element )
+/* Plain scan for patterns too long for the matcher, every call starts
+ * over from the oldest byte
+ */
+static int32_t buffer_find_scan( Buffer_t*      buff
+                               , const uint8_t* pat
+                               , uint32_t       size
+                               )
 {
     int32_t  ret = -1;
-    uint32_t num;
-    uint32_t out;
+    uint32_t full;
+    uint32_t pos;
+    uint32_t i;
 
-    if ( NULL != buff )
-    {
-        num = buffer_get_full( buff );
-        out = buff->out;
+    full = ring_count( &buff->ring );
 
-        while ( num > 0 )
+    for ( pos = 0; ( pos + size <= full ) && ( ret < 0 ); pos++ )
+    {
+        for ( i = 0; i < size; i++ )
         {
-            if ( out >= buff->size )
-            {
-                out = 0;
-            }
-
-            if ((uint8_t) buff->data[out] == (uint8_t) element )
+            if ( ring_at( &buff->ring, pos + i ) != pat[i] )
             {
                 break;
             }
+        }
 
-            out++;
-            num--;
-            ret++;
+        if ( i == size )
+        {
+            ret = (int32_t) pos;
         }
     }
 
@@ -258,67 +244,22 @@ int32_t buffer_find_element( Buffer_t* buff, const uint8_t element )
 
 int32_t buffer_find( Buffer_t* buff, const void* data, uint32_t size )
 {
-    int32_t  ret = -1;
-    uint32_t num;
-    uint32_t out;
-    uint32_t i;
-    uint8_t  found = 0;
-    uint8_t* d;
+    int32_t     ret = -1;
+    Match_t     match;
+    const void* pat = data;
+    uint8_t     len = (uint8_t) size;
 
-    if (( NULL != buff ) && ( NULL != data ))
+    if (( NULL == buff ) || ( NULL == data ) || ( 0 == size ))
     {
-        num = buffer_get_full( buff );
-
-        if ( num >= size )
-        {
-            d = (uint8_t*) data;
-            out = buff->out;
-
-            while ( num > 0 )
-            {
-                if ( out >= buff->size )
-                {
-                    out = 0;
-                }
-
-                if ((uint8_t) buff->data[out] == (uint8_t) d[0] )
-                {
-                    found = 1;
-                }
-
-                out++;
-                num--;
-                ret++;
-
-                if ( 0 != found )
-                {
-                    i = 1;
-
-                    while (( i < size ) && ( num > 0 ))
-                    {
-                        if ( out >= buff->size )
-                        {
-                            out = 0;
-                        }
-
-                        if ((uint8_t) buff->data[out] != (uint8_t) d[i])
-                        {
-                            ret += i - 1;
-                            break;
-                        }
-
-                        out++;
-                        num--;
-                        i++;
-                    }
-
-                    if ( i == size )
-                    {
-                        break;
-                    }
-                }
-            }
-        }
+        /* Nothing to look for */
+    }
+    else if ( size >= MATCH_NODE_MAX )
+    {
+        ret = buffer_find_scan( buff, (const uint8_t*) data, size );
+    }
+    else if ( STATUS_OK == match_init( &match, &pat, &len, 1 ))
+    {
+        ret = buffer_match( buff, &match, NULL );
     }
 
     return ret;
@@ -331,53 +272,29 @@ uint32_t buffer_write_string( Buffer_t* buff, const char* string )
 
 uint32_t buffer_read_string( Buffer_t* buff, char* string, uint32_t buff_size )
 {
-    uint32_t ret = 0;
-    uint32_t i   = 0;
-    uint32_t mem_free;
-    uint32_t mem_full;
-    int32_t  delim_found;
-    uint8_t  ch;
-
-    if ((( NULL != buff ) && ( NULL != string )) && ( 0 != buff_size ))
+    uint32_t    ret = 0;
+    Ring_Span_t span[2];
+    uint32_t    len;
+    uint32_t    n;
+
+    /* One byte and the terminator at least, a piece of no bytes would leave
+     * the line pending forever
+     */
+    if ((( NULL != buff ) && ( NULL != string )) && ( buff_size >= 2 ))
     {
-        mem_free = buffer_get_free( buff );
-        mem_full = buffer_get_full( buff );
-
-        delim_found = buffer_find_element( buff, buff->delimiter );
+        len = ring_line( &buff->ring, buff->delimiter, span );
 
-        if (( 0 != mem_full )
-         && ( delim_found >= 0 )
-         && ( mem_full >= buff_size )
-         && ( mem_free > 0 ))
+        if ( 0 != len )
         {
-            while ( i < ( buff_size - 1 ))
-            {
-                ret = buffer_read( buff, &ch, 1 );
-
-                if ( 0 == ret )
-                {
-                    break;
-                }
+            /* Rest of a longer line stays for the next call */
+            ret = ( len < buff_size ) ? len : ( buff_size - 1 );
+            n   = ( span[0].size < ret ) ? span[0].size : ret;
 
-                string[i] = (char) ch;
+            memcpy( string, span[0].data, n );
+            memcpy( &string[n], span[1].data, ret - n );
+            string[ret] = 0;
 
-                if ((char) string[i] == (char) buff->delimiter )
-                {
-                    break;
-                }
-
-                i++;
-            }
-
-            if ( i == ( buff_size - 1 ))
-            {
-                string[i] = 0;
-            }
-            else
-            {
-                i++;
-                string[i] = 0;
-            }
+            (void) ring_skip( &buff->ring, ret );
         }
     }
 
@@ -386,30 +303,13 @@ uint32_t buffer_read_string( Buffer_t* buff, char* string, uint32_t buff_size )
 
 bool_t buffer_check_element( Buffer_t* buff, uint32_t pos, void* element )
 {
-    bool_t   ret = FALSE;
-    uint32_t i   = 0;
-    uint32_t in;
-    uint32_t out;
+    bool_t ret = FALSE;
 
     if (( NULL != buff ) && ( NULL != element ))
     {
-        in  = buff->in;
-        out = buff->out;
-
-        while (( i < pos ) && ( in != out ))
-        {
-            out++;
-            i++;
-
-            if ( out >= buff->size )
-            {
-                out = 0;
-            }
-        }
-
-        if ( i == pos )
+        if ( pos < ring_count( &buff->ring ))
         {
-            *(uint8_t *) element = buff->data[out];
+            *(uint8_t *) element = ring_at( &buff->ring, pos );
 
             ret = TRUE;
         }
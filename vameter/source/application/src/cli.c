@@ -7,10 +7,23 @@
  **
  ** Revision
  **   28-Aug-2020 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Add UART commands
+ **   18-Oct-2026 (SSB) [] Add measurement commands
+ **   18-Oct-2026 (SSB) [] Add energy commands
+ **   18-Oct-2026 (SSB) [] Add LCD commands
+ **   18-Oct-2026 (SSB) [] Add history commands
+ **   18-Oct-2026 (SSB) [] Add streaming commands
+ **   18-Oct-2026 (SSB) [] Line assembly from receive events, no busy wait
+ **   18-Oct-2026 (SSB) [] Add profiling commands
+ **   18-Oct-2026 (SSB) [] Add trace commands
+ **   18-Oct-2026 (SSB) [] Receive in place, arguments tokenised in the line
+ **   18-Oct-2026 (SSB) [] Add calibration commands
  **/
 
 #include "cli.h"
 
+#include "event.h"
+#include "stream.h"
 #include "uart.h"
 
 #include <stdlib.h>
@@ -18,11 +31,51 @@
 
 #define CLI_CMD_BUFF_NUM (2)
 
+typedef enum
+{
+    CLI_RX_TEXT = 0,
+    CLI_RX_ESC,                 /* Got ESC */
+    CLI_RX_CSI                  /* Got ESC [, until the final byte */
+} Cli_Rx_State_t;
+
+/* Line being assembled and the recall history */
+typedef struct
+{
+    Cli_Rx_State_t state;
+    uint8_t        line[CLI_CMD_MAX_LINE_SIZE];
+    uint8_t        len;
+    uint8_t        last;        /* Previous character */
+    Cli_Cmd_Line   hist[CLI_CMD_BUFF_NUM];
+    uint8_t        hist_next;   /* Slot of the next line */
+    uint8_t        hist_num;    /* Lines in the history */
+    uint8_t        hist_delta;  /* Recalled line, 0 is none */
+} Cli_Rx_t;
+
+extern const Cli_Cmd_List cmd_cal_list;
+extern const Cli_Cmd_List cmd_energy_list;
+extern const Cli_Cmd_List cmd_lcd_list;
+extern const Cli_Cmd_List cmd_log_list;
+extern const Cli_Cmd_List cmd_meas_list;
+extern const Cli_Cmd_List cmd_prof_list;
+extern const Cli_Cmd_List cmd_stream_list;
 extern const Cli_Cmd_List cmd_sys_list;
+extern const Cli_Cmd_List cmd_trace_list;
+extern const Cli_Cmd_List cmd_uart_list;
+
+static Cli_Rx_t cli_rx;
 
 static const Cli_Cmd_Table_Entry cli_cmd_table[] =
 {
-    &cmd_sys_list
+    &cmd_sys_list,
+    &cmd_uart_list,
+    &cmd_meas_list,
+    &cmd_cal_list,
+    &cmd_energy_list,
+    &cmd_lcd_list,
+    &cmd_log_list,
+    &cmd_stream_list,
+    &cmd_prof_list,
+    &cmd_trace_list
 };
 
 static void cli_fill_with_space( uint8_t name_size )
@@ -71,151 +124,146 @@ static void cli_print_help( void )
     printf( "\r\n" );
 }
 
-static void cli_delete_others( uint8_t num )
+/* Erase the visible line after the prompt and print buff instead */
+static void cli_redraw( const uint8_t* buff, uint8_t len, uint8_t old_len )
 {
     uint8_t i;
 
-    for ( i = 0 ; i < num; i++ )
+    uart_send( CLI_UART, (uint8_t*)"\r> ", 3 );
+    uart_send( CLI_UART, (uint8_t*) buff, len );
+
+    for ( i = len; i < old_len; i++ )
     {
         uart_send( CLI_UART, (uint8_t*)" ", 1 );
     }
 
-    for ( i = 0; i< num; i++ )
+    for ( i = len; i < old_len; i++ )
     {
         uart_send( CLI_UART, (uint8_t*)"\b", 1 );
     }
 }
 
-static uint32_t cli_read_line( uint8_t* buff
-                             , uint8_t  max_len
-                             )
+/* Up and down arrows walk the history, delta 0 is an empty line */
+static void cli_recall( bool_t older )
 {
-    static Cli_Cmd_Line cmd_buff[CLI_CMD_BUFF_NUM];
-
-    uint8_t      cmd_delta = 0;
-    uint8_t      cmd_ind   = 0;
-    uint8_t      cmd_num   = 0;
-    uint8_t      i = 0;
-    uint8_t      ch;
-    bool_t       going = TRUE;
-    bool_t       is_empty;
-    int8_t       ind;
-    int8_t       del;
-
-    while (( i < max_len ) && ( FALSE != going ))
-    {
-        is_empty = uart_buff_empty( CLI_UART );
-
-        if ( FALSE == is_empty )
-        {
-            ch = uart_getc( CLI_UART );
-
-            switch ( ch )
-            {
-                case 0x0A:  /**< Line feed \n */
-                case 0x0D:  /**< Carriage return \r */
-                    going = FALSE;
+    const Cli_Cmd_Line* line;
+    uint8_t             old_len = cli_rx.len;
+    uint8_t             ind;
 
-                    if ( i > 1 )
-                    {
-                        memcpy( cmd_buff[cmd_ind].line, buff, i );
-                        cmd_buff[cmd_ind].cmd_len = i;
-                        cmd_ind++;
+    if ( older && ( cli_rx.hist_delta < cli_rx.hist_num ))
+    {
+        cli_rx.hist_delta++;
+    }
+    else if ( !older && ( cli_rx.hist_delta > 0 ))
+    {
+        cli_rx.hist_delta--;
+    }
 
-                        if ( CLI_CMD_BUFF_NUM == cmd_num )
-                        {
-                            cmd_ind = 0;
-                        }
+    if ( 0 == cli_rx.hist_delta )
+    {
+        cli_rx.len = 0;
+    }
+    else
+    {
+        ind  = ( cli_rx.hist_next + CLI_CMD_BUFF_NUM - cli_rx.hist_delta )
+             % CLI_CMD_BUFF_NUM;
+        line = &cli_rx.hist[ind];
 
-                        if ( cmd_num < CLI_CMD_BUFF_NUM )
-                        {
-                            cmd_ind++;
-                        }
+        memcpy( cli_rx.line, line->line, line->cmd_len );
+        cli_rx.len = line->cmd_len;
+    }
 
-                        cmd_delta = 0;
-                    }
+    cli_redraw( cli_rx.line, cli_rx.len, old_len );
+}
 
-                    buff[i] = 0x0;
-                    printf( "\r\n" );
-                    break;
+static void cli_hist_add( void )
+{
+    Cli_Cmd_Line* line = &cli_rx.hist[cli_rx.hist_next];
 
-                case 0x09:  /**< Horizontal tab */
-                case 0x08:  /**< Backspace */
-                case 0x7F:  /**< DEL */
-                    if ( 0 != i )
-                    {
-                        i--;
-                        uart_send( CLI_UART, (uint8_t*)"\b", 1 );
-                    }
-                    break;
+    memcpy( line->line, cli_rx.line, cli_rx.len );
+    line->cmd_len = cli_rx.len;
 
-                case 0x41:
-                    if ( ( 0x5B == buff[i-1] ) && ( 0x1B == buff[i-2] ) )
-                    {
-                        uart_send( CLI_UART, (uint8_t*)"\r> ", 3 );
+    cli_rx.hist_next = ( cli_rx.hist_next + 1 ) % CLI_CMD_BUFF_NUM;
 
-                        if ( cmd_delta < cmd_num )
-                        {
-                            cmd_delta++;
-                        }
+    if ( cli_rx.hist_num < CLI_CMD_BUFF_NUM )
+    {
+        cli_rx.hist_num++;
+    }
+}
 
-                        ind = ( cmd_ind - cmd_delta ) % CLI_CMD_BUFF_NUM;
-                        memcpy ( buff
-                               , cmd_buff[ind].line
-                               , cmd_buff[ind].cmd_len
-                               );
+/* Line assembly, one received character at a time. Returns TRUE when a
+ * complete line is in cli_rx.line, zero terminated.
+ */
+static bool_t cli_feed( uint8_t ch )
+{
+    bool_t ret = FALSE;
 
-                        del = i - cmd_buff[ind].cmd_len - 2;
-                        i   = cmd_buff[ind].cmd_len;
+    switch ( cli_rx.state )
+    {
+        case CLI_RX_ESC:
+            cli_rx.state = ( 0x5B == ch ) ? CLI_RX_CSI : CLI_RX_TEXT;
+            break;
 
-                        uart_send( CLI_UART, buff, i );
+        case CLI_RX_CSI:
+            /* Parameters and intermediates until the final byte */
+            if (( ch >= 0x40 ) && ( ch <= 0x7E ))
+            {
+                cli_rx.state = CLI_RX_TEXT;
 
-                        if ( del > 0 )
-                        {
-                            cli_delete_others( del );
-                        }
-                    }
-                    break;
+                if (( 0x41 == ch ) || ( 0x42 == ch ))
+                {
+                    cli_recall(( 0x41 == ch ) ? TRUE : FALSE );
+                }
+            }
+            break;
 
-                case 0x42:
-                    if ( ( 0x5B == buff[i-1] ) && ( 0x1B == buff[i-2] ) )
+        default:
+            switch ( ch )
+            {
+                case 0x0A:  /**< Line feed \n */
+                case 0x0D:  /**< Carriage return \r */
+                    /* CR LF ends one line, not two */
+                    if (( 0x0A != ch ) || ( 0x0D != cli_rx.last ))
                     {
-                        uart_send( CLI_UART, (uint8_t*)"\r> ", 3 );
-
-                        if ( cmd_delta > 0 )
+                        if ( cli_rx.len > 1 )
                         {
-                            cmd_delta--;
+                            cli_hist_add();
                         }
 
-                        ind = ( cmd_ind - cmd_delta ) % CLI_CMD_BUFF_NUM;
-                        memcpy ( buff
-                               , cmd_buff[ind].line
-                               , cmd_buff[ind].cmd_len
-                               );
+                        cli_rx.line[cli_rx.len] = 0x0;
+                        cli_rx.hist_delta       = 0;
+                        printf( "\r\n" );
+                        ret = TRUE;
+                    }
+                    break;
 
-                        del = i - cmd_buff[ind].cmd_len - 2;
-                        i   = cmd_buff[ind].cmd_len;
-                        uart_send ( CLI_UART, buff, i );
+                case 0x1B:  /**< Escape sequence */
+                    cli_rx.state = CLI_RX_ESC;
+                    break;
 
-                        if ( del > 0 )
-                        {
-                            cli_delete_others( del );
-                        }
+                case 0x09:  /**< Horizontal tab */
+                case 0x08:  /**< Backspace */
+                case 0x7F:  /**< DEL */
+                    if ( 0 != cli_rx.len )
+                    {
+                        cli_rx.len--;
+                        uart_send( CLI_UART, (uint8_t*)"\b \b", 3 );
                     }
                     break;
 
                 default:
-                    buff[i++] = ch;
-
-                    if ( ( 0x5B != ch ) && ( 0x1B != ch ) )
+                    /* Room for the terminating zero */
+                    if ( cli_rx.len < ( CLI_CMD_MAX_LINE_SIZE - 1 ))
                     {
+                        cli_rx.line[cli_rx.len++] = ch;
                         uart_send( CLI_UART, &ch, 1 );
                     }
             }
-        }
     }
 
-    return i;
+    cli_rx.last = ch;
+
+    return ret;
 }
 
 static void cli_parse_cmd( Cli_Cmd_Args* args, uint8_t* str )
@@ -224,21 +272,18 @@ static void cli_parse_cmd( Cli_Cmd_Args* args, uint8_t* str )
     char*    result = NULL;
     uint8_t  i = 0;
 
+    for ( i = 0; i < CLI_CMD_MAX_ARG; i++ )
+    {
+        args->str[i] = (uint8_t*) "";
+    }
+
+    i      = 0;
     result = strtok ( (char*)str, delims );
 
     while ( NULL != result )
     {
-        if ( strnlen( result , CLI_CMD_MAX_ARG_SIZE ) >=
-            CLI_CMD_MAX_ARG_SIZE )
-        {
-            printf( "Error: Argument %s is too long!\r\n", result );
-            break;
-        }
-
-        strncpy( (char*) args->str[i]
-               , result
-               , CLI_CMD_MAX_ARG_SIZE
-               );
+        /* Terminated in place by strtok, no copy */
+        args->str[i] = (uint8_t*) result;
 
         if ( ( '0' == result[0] ) && ( 'x' == result[1] ) )
         {
@@ -252,7 +297,7 @@ static void cli_parse_cmd( Cli_Cmd_Args* args, uint8_t* str )
         result = (char*) strtok( NULL, delims );
         i++;
 
-        if ( i >= CLI_CMD_MAX_ARG )
+        if (( i >= CLI_CMD_MAX_ARG ) && ( NULL != result ))
         {
             printf( "Error: Maximal argument count reached!\r\n" );
             break;
@@ -373,18 +418,63 @@ static Cli_Ret cli_run_cmd ( Cli_Cmd_Args* args )
     return ret;
 }
 
-void cli_process ( void )
+void cli_init( void )
 {
-    uint8_t         cmd_str[CLI_CMD_MAX_LINE_SIZE] = {0};
-    Cli_Cmd_Args    args = {0};
+    memset( &cli_rx, 0, sizeof( cli_rx ));
 
-    cli_print_help();
+    printf( "Info: Command Line Interface loaded, help lists commands.\r\n" );
+    uart_send( CLI_UART, (uint8_t*)"> ", 2 );
+}
 
-    while ( TRUE )
+/*
+ * EVENT_UART1_RX handler. At most one command runs per call and the event
+ * is posted again while input is left, so pending ADC half buffers are
+ * processed in between. Any key ends binary streaming instead.
+ */
+void cli_process( void )
+{
+    Cli_Cmd_Args args = {0};
+    Ring_Span_t  span[2];
+    bool_t       line = FALSE;
+    uint32_t     used = 0;
+    uint32_t     n;
+    uint32_t     i;
+
+    if ( stream_is_active() )
     {
+        uart_clear_buff( CLI_UART );
+        cli_stream_stop();
         uart_send( CLI_UART, (uint8_t*)"> ", 2 );
-        cli_read_line( cmd_str, CLI_CMD_MAX_LINE_SIZE );
-        cli_parse_cmd( &args, cmd_str );
+    }
+
+    /* Fed straight from the receive ring, consumed in one go */
+    (void) uart_get_spans( CLI_UART, span );
+
+    for ( n = 0; ( n < 2 ) && ( FALSE == line ); n++ )
+    {
+        for ( i = 0; ( i < span[n].size ) && ( FALSE == line ); i++ )
+        {
+            line = cli_feed( span[n].data[i] );
+            used++;
+        }
+    }
+
+    uart_skip( CLI_UART, used );
+
+    if ( line )
+    {
+        cli_parse_cmd( &args, cli_rx.line );
         cli_run_cmd( &args );
+        cli_rx.len = 0;
+
+        if ( !stream_is_active() )
+        {
+            uart_send( CLI_UART, (uint8_t*)"> ", 2 );
+        }
+
+        if ( FALSE == uart_buff_empty( CLI_UART ))
+        {
+            event_post( EVENT_UART1_RX );
+        }
     }
 }
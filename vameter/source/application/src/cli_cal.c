@@ -0,0 +1,211 @@
+/**
+ ** Name
+ **   cli_cal.c
+ **
+ ** Purpose
+ **   Calibration commands
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "cli.h"
+
+#include "adc.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* const cli_cal_state[] =
+{
+    "idle",
+    "busy",
+    "done",
+    "failed"
+};
+
+/* Channel by name, i or v, ADC_CH_NUM if unknown */
+static uint8_t cli_cal_ch( const uint8_t* str )
+{
+    uint8_t ret = ADC_CH_NUM;
+
+    if ( 0 == strcmp( (const char*) str, "i" ))
+    {
+        ret = ADC_CH_I;
+    }
+    else if ( 0 == strcmp( (const char*) str, "v" ))
+    {
+        ret = ADC_CH_V;
+    }
+
+    return ret;
+}
+
+/* Samples to average, numeric arguments are 16-bit */
+static uint32_t cli_cal_samples( Cli_Cmd_Args* args, uint8_t idx )
+{
+    uint32_t ret = ADC_CAL_SAMPLES;
+
+    if ( args->count > idx )
+    {
+        ret = strtoul( (char*) args->str[idx], NULL, 10 );
+    }
+
+    return ret;
+}
+
+static Cli_Ret cli_cal_show( Cli_Cmd_Args* args )
+{
+    const Adc_Cal_t* cal = adc_get_cal();
+    Adc_Cal_Run_t    run;
+    uint8_t          ch;
+
+    (void) args;
+
+    for ( ch = 0; ch < ADC_CH_NUM; ch++ )
+    {
+        printf( "%s: zero %lu.%04lu counts, gain %lu.%04lu\r\n"
+              , ( ADC_CH_I == ch ) ? "i" : "v"
+              , (unsigned long)( cal->zero[ch] >> ADC_CAL_ZERO_Q )
+              , (unsigned long)((( cal->zero[ch]
+                                 & (( 1U << ADC_CAL_ZERO_Q ) - 1 ))
+                                * 10000 ) >> ADC_CAL_ZERO_Q )
+              , (unsigned long)( cal->gain[ch] >> ADC_CAL_GAIN_Q )
+              , (unsigned long)((( cal->gain[ch]
+                                 & (( 1UL << ADC_CAL_GAIN_Q ) - 1 ))
+                                * 10000 ) >> ADC_CAL_GAIN_Q )
+              );
+    }
+
+    adc_get_cal_run( &run );
+
+    printf( "run: %s, ch %s, step %u, %lu of %lu samples left, points %u\r\n"
+          , cli_cal_state[run.state]
+          , ( ADC_CH_I == run.ch ) ? "i" : "v"
+          , run.point
+          , (unsigned long) run.left
+          , (unsigned long) run.samples
+          , run.valid
+          );
+
+    printf( "rms: %lu mA, %lu mV\r\n"
+          , (unsigned long) adc_get_milli( ADC_CH_I )
+          , (unsigned long) adc_get_milli( ADC_CH_V )
+          );
+
+    return CLI_RET_OK;
+}
+
+static Cli_Ret cli_cal_zero( Cli_Cmd_Args* args )
+{
+    Cli_Ret  ret  = CLI_RET_ERROR;
+    status_t sret = STATUS_ERROR;
+
+    if ( args->count > 2 )
+    {
+        sret = adc_cal_zero( cli_cal_ch( args->str[2] )
+                           , cli_cal_samples( args, 3 )
+                           );
+    }
+
+    if ( STATUS_OK == sret )
+    {
+        printf( "Info: Averaging at no load, see cal show\r\n" );
+        ret = CLI_RET_OK;
+    }
+    else
+    {
+        printf( "Error: Usage cal zero <i|v> [samples], none running\r\n" );
+    }
+
+    return ret;
+}
+
+static Cli_Ret cli_cal_point( Cli_Cmd_Args* args )
+{
+    Cli_Ret  ret  = CLI_RET_ERROR;
+    status_t sret = STATUS_ERROR;
+
+    if ( args->count > 4 )
+    {
+        sret = adc_cal_point( cli_cal_ch( args->str[2] )
+                            , (uint8_t) args->num[3]
+                            , strtol( (char*) args->str[4], NULL, 10 )
+                            , cli_cal_samples( args, 5 )
+                            );
+    }
+
+    if ( STATUS_OK == sret )
+    {
+        printf( "Info: Averaging at the reference, see cal show\r\n" );
+        ret = CLI_RET_OK;
+    }
+    else
+    {
+        printf( "Error: Usage cal point <i|v> <1|2> <mA|mV> [samples]\r\n" );
+    }
+
+    return ret;
+}
+
+static Cli_Ret cli_cal_reset( Cli_Cmd_Args* args )
+{
+    Cli_Ret ret = CLI_RET_OK;
+
+    if (( args->count < 3 )
+     || ( STATUS_OK != adc_cal_reset( cli_cal_ch( args->str[2] ))))
+    {
+        printf( "Error: Usage cal reset <i|v>\r\n" );
+        ret = CLI_RET_ERROR;
+    }
+
+    return ret;
+}
+
+static Cli_Ret cli_cal_save( Cli_Cmd_Args* args )
+{
+    Cli_Ret ret = CLI_RET_OK;
+
+    (void) args;
+
+    if ( STATUS_OK != adc_cal_save() )
+    {
+        printf( "Error: Saving calibration failed!\r\n" );
+        ret = CLI_RET_ERROR;
+    }
+
+    return ret;
+}
+
+static const Cli_Cmd cal_cmds[] =
+{
+    { "show"
+    , cli_cal_show
+    , "Show coefficients, running step and readings"
+    },
+    { "zero"
+    , cli_cal_zero
+    , "Auto-zero a channel at no load"
+    },
+    { "point"
+    , cli_cal_point
+    , "Gain point 1 or 2 at a DC reference"
+    },
+    { "reset"
+    , cli_cal_reset
+    , "Nominal zero and gain for a channel"
+    },
+    { "save"
+    , cli_cal_save
+    , "Store coefficients in flash"
+    }
+};
+
+const Cli_Cmd_List cmd_cal_list =
+{
+    "cal"
+    , cal_cmds
+    , sizeof ( cal_cmds ) / sizeof ( cal_cmds[0] )
+    , "Calibration commands"
+};
@@ -0,0 +1,89 @@
+/**
+ ** Name
+ **   cli_energy.c
+ **
+ ** Purpose
+ **   Power and energy commands
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "cli.h"
+
+#include "adc.h"
+
+#include <stdio.h>
+
+/* Print a value given in thousandths with three decimals */
+static void cli_energy_print_milli( const char* name, int64_t val, const char* unit )
+{
+    const char* sign = "";
+
+    if ( val < 0 )
+    {
+        sign = "-";
+        val  = -val;
+    }
+
+    printf( "%s: %s%lu.%03u %s\r\n"
+          , name
+          , sign
+          , (unsigned long) ( val / 1000 )
+          , (unsigned int) ( val % 1000 )
+          , unit
+          );
+}
+
+static Cli_Ret cli_energy_show( Cli_Cmd_Args* args )
+{
+    Adc_Power_t power;
+
+    (void) args;
+
+    adc_get_power( &power );
+
+    cli_energy_print_milli( "real power", power.p, "W" );
+    cli_energy_print_milli( "apparent power", power.s, "VA" );
+    cli_energy_print_milli( "power factor", power.pf, "" );
+
+    /* uJ to mWh */
+    cli_energy_print_milli( "energy", power.energy / 3600000, "Wh" );
+
+    return CLI_RET_OK;
+}
+
+static Cli_Ret cli_energy_reset( Cli_Cmd_Args* args )
+{
+    Cli_Ret ret = CLI_RET_OK;
+
+    (void) args;
+
+    if ( STATUS_OK != adc_energy_reset() )
+    {
+        printf( "Error: Saving energy total failed!\r\n" );
+        ret = CLI_RET_ERROR;
+    }
+
+    return ret;
+}
+
+static const Cli_Cmd energy_cmds[] =
+{
+    { "show"
+    , cli_energy_show
+    , "Show power of the last window and energy total"
+    },
+    { "reset"
+    , cli_energy_reset
+    , "Clear energy total"
+    }
+};
+
+const Cli_Cmd_List cmd_energy_list =
+{
+    "energy"
+    , energy_cmds
+    , sizeof ( energy_cmds ) / sizeof ( energy_cmds[0] )
+    , "Power and energy commands"
+};
@@ -0,0 +1,155 @@
+/**
+ ** Name
+ **   cli_lcd.c
+ **
+ ** Purpose
+ **   PCD8544 LCD commands
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Refresh statistics
+ **/
+
+#include "cli.h"
+
+#include "pcd8544.h"
+#include "tim.h"
+
+#include <stdio.h>
+
+#define CLI_LCD_BENCH_RUNS (32)
+
+static bool_t cli_lcd_ready = FALSE;
+
+static Cli_Ret cli_lcd_open( void )
+{
+    Cli_Ret ret = CLI_RET_OK;
+
+    if ( FALSE == cli_lcd_ready )
+    {
+        if ( STATUS_OK == pcd8544_init( PCD8544_CONTRAST_DEF ))
+        {
+            cli_lcd_ready = TRUE;
+        }
+        else
+        {
+            printf( "Error: LCD init failed!\r\n" );
+            ret = CLI_RET_ERROR;
+        }
+    }
+
+    return ret;
+}
+
+/* Full frame refreshes, blocking call time next to the time the CPU is
+ * held by the asynchronous variant.
+ */
+static Cli_Ret cli_lcd_bench( Cli_Cmd_Args* args )
+{
+    Cli_Ret         ret;
+    PCD8544_Stats_t stats;
+    Time_t          start;
+    Time_t          stop;
+    uint32_t        sync_us  = 0;
+    uint32_t        async_us = 0;
+    uint32_t        wire_us  = 0;
+    uint8_t         i;
+
+    (void) args;
+
+    ret = cli_lcd_open();
+
+    if ( CLI_RET_OK == ret )
+    {
+        for ( i = 0; i < CLI_LCD_BENCH_RUNS; i++ )
+        {
+            pcd8544_update_area( 0
+                               , 0
+                               , PCD8544_WIDTH - 1
+                               , PCD8544_HEIGHT - 1
+                               );
+
+            get_time( &start );
+            (void) pcd8544_refresh();
+            get_time( &stop );
+
+            sync_us += (uint32_t)( stop - start );
+        }
+
+        for ( i = 0; i < CLI_LCD_BENCH_RUNS; i++ )
+        {
+            pcd8544_update_area( 0
+                               , 0
+                               , PCD8544_WIDTH - 1
+                               , PCD8544_HEIGHT - 1
+                               );
+
+            get_time( &start );
+            (void) pcd8544_refresh_async( NULL );
+            get_time( &stop );
+
+            async_us += (uint32_t)( stop - start );
+
+            while ( FALSE != pcd8544_is_busy() )
+            {
+            }
+
+            pcd8544_get_stats( &stats );
+            wire_us += stats.time_last;
+        }
+
+        printf( "full frame, %u runs: blocking %lu us, async call %lu us"
+                ", refresh %lu us\r\n"
+              , CLI_LCD_BENCH_RUNS
+              , (unsigned long) ( sync_us / CLI_LCD_BENCH_RUNS )
+              , (unsigned long) ( async_us / CLI_LCD_BENCH_RUNS )
+              , (unsigned long) ( wire_us / CLI_LCD_BENCH_RUNS )
+              );
+    }
+
+    return ret;
+}
+
+static Cli_Ret cli_lcd_stats( Cli_Cmd_Args* args )
+{
+    PCD8544_Stats_t stats;
+
+    (void) args;
+
+    pcd8544_get_stats( &stats );
+
+    printf( "refreshes %lu, last %lu us, max %lu us\r\n"
+          , (unsigned long) stats.refreshes
+          , (unsigned long) stats.time_last
+          , (unsigned long) stats.time_max
+          );
+    printf( "bytes last %lu, total %lu, average %lu per refresh\r\n"
+          , (unsigned long) stats.bytes_last
+          , (unsigned long) stats.bytes_total
+          , (unsigned long) (( 0 != stats.refreshes )
+                             ? ( stats.bytes_total / stats.refreshes )
+                             : 0 )
+          );
+
+    return CLI_RET_OK;
+}
+
+static const Cli_Cmd lcd_cmds[] =
+{
+    { "bench"
+    , cli_lcd_bench
+    , "Measure full frame refresh time"
+    },
+    { "stats"
+    , cli_lcd_stats
+    , "Show refresh time and bytes sent per refresh"
+    }
+};
+
+const Cli_Cmd_List cmd_lcd_list =
+{
+    "lcd"
+    , lcd_cmds
+    , sizeof ( lcd_cmds ) / sizeof ( lcd_cmds[0] )
+    , "PCD8544 LCD commands"
+};
@@ -0,0 +1,127 @@
+/**
+ ** Name
+ **   cli_log.c
+ **
+ ** Purpose
+ **   Measurement history commands
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Sample period command
+ **/
+
+#include "cli.h"
+
+#include "hist.h"
+#include "uart.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Blocks go out raw, header and payload as stored. Two zero bytes, an
+ * invalid magic, end the stream.
+ */
+static void cli_log_out( const Hist_Blk_Hdr_t* hdr, const uint8_t* data )
+{
+    uart_send( UART_TO_PC, (uint8_t*) hdr, sizeof( Hist_Blk_Hdr_t ));
+    uart_send( UART_TO_PC, (uint8_t*) data, hdr->len );
+}
+
+static Cli_Ret cli_log_dump( Cli_Cmd_Args* args )
+{
+    const uint8_t end[2] = { 0, 0 };
+    uint32_t      from   = 0;
+    uint32_t      to     = 0xFFFFFFFF;
+
+    /* Seconds since power up, parsed as strings for the full range */
+    if ( args->count > 2 )
+    {
+        from = strtoul( (char*) args->str[2], NULL, 10 );
+    }
+
+    if ( args->count > 3 )
+    {
+        to = strtoul( (char*) args->str[3], NULL, 10 );
+    }
+
+    fflush( stdout );
+
+    (void) hist_dump( from, to, cli_log_out );
+    uart_send( UART_TO_PC, (uint8_t*) end, sizeof( end ));
+    uart_flush( UART_TO_PC );
+
+    return CLI_RET_OK;
+}
+
+static Cli_Ret cli_log_stats( Cli_Cmd_Args* args )
+{
+    Hist_Stats_t stats;
+
+    (void) args;
+
+    hist_get_stats( &stats );
+
+    printf( "blocks %lu of %u, samples %lu, boot %u\r\n"
+          , (unsigned long) stats.blocks
+          , (unsigned) HIST_PAGES
+          , (unsigned long) stats.samples
+          , (unsigned) stats.boot
+          );
+    printf( "period %lu ms, open block %lu, %lu of %u bytes, "
+            "flash errors %lu\r\n"
+          , (unsigned long) hist_get_period()
+          , (unsigned long) stats.seq
+          , (unsigned long) stats.open_bytes
+          , (unsigned) HIST_PAYLOAD_SIZE
+          , (unsigned long) stats.flash_errors
+          );
+
+    return CLI_RET_OK;
+}
+
+static Cli_Ret cli_log_period( Cli_Cmd_Args* args )
+{
+    Cli_Ret ret = CLI_RET_OK;
+
+    if ( args->count > 2 )
+    {
+        if ( STATUS_OK != hist_set_period( (uint32_t) args->num[2] * 1000 ))
+        {
+            printf( "Error: Usage log period <1..%u s>\r\n"
+                  , (unsigned) ( HIST_PERIOD_MAX_MS / 1000 )
+                  );
+            ret = CLI_RET_ERROR;
+        }
+    }
+
+    if ( CLI_RET_OK == ret )
+    {
+        printf( "period %lu ms\r\n", (unsigned long) hist_get_period() );
+    }
+
+    return ret;
+}
+
+static const Cli_Cmd log_cmds[] =
+{
+    { "dump"
+    , cli_log_dump
+    , "Send history blocks [from s] [to s] since power up, binary"
+    },
+    { "stats"
+    , cli_log_stats
+    , "Show history usage"
+    },
+    { "period"
+    , cli_log_period
+    , "Show or set sample period [s], saved"
+    }
+};
+
+const Cli_Cmd_List cmd_log_list =
+{
+    "log"
+    , log_cmds
+    , sizeof ( log_cmds ) / sizeof ( log_cmds[0] )
+    , "Measurement history commands"
+};
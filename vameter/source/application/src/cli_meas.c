@@ -0,0 +1,311 @@
+/**
+ ** Name
+ **   cli_meas.c
+ **
+ ** Purpose
+ **   Measurement commands
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Sample rate, decimation and benchmark
+ **   18-Oct-2026 (SSB) [] DMA hand over counters
+ **   18-Oct-2026 (SSB) [] Pause acquisition for the benchmark
+ **   18-Oct-2026 (SSB) [] Calibrated RMS in mA and mV
+ **   18-Oct-2026 (SSB) [] Benchmark pauses acquisition itself
+ **/
+
+#include "cli.h"
+
+#include "adc.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static Cli_Ret cli_meas_save( void )
+{
+    Cli_Ret ret = CLI_RET_OK;
+
+    if ( STATUS_OK != adc_cfg_save() )
+    {
+        printf( "Error: Saving measurement configuration failed!\r\n" );
+        ret = CLI_RET_ERROR;
+    }
+
+    return ret;
+}
+
+static Cli_Ret cli_meas_show( Cli_Cmd_Args* args )
+{
+    const Adc_Cfg_t* cfg = adc_get_cfg();
+    const Adc_Rms_t* rms;
+    Adc_Line_t       line;
+    uint8_t          ch;
+
+    (void) args;
+
+    printf( "rate %lu S/s, decimation %u, output %lu S/s\r\n"
+          , (unsigned long) cfg->rate
+          , 1u << ( 2 * cfg->dec )
+          , (unsigned long) adc_get_fs()
+          );
+
+    if ( ADC_MODE_AC == cfg->mode )
+    {
+        printf( "mode ac, %u periods, reference ch%u\r\n"
+              , cfg->periods
+              , cfg->ref_ch
+              );
+    }
+    else
+    {
+        printf( "mode dc, %u samples\r\n", cfg->samples );
+    }
+
+    for ( ch = 0; ch < ADC_CH_NUM; ch++ )
+    {
+        rms = adc_get_rms( ch );
+
+        printf( "ch%u: q%lu, rms %lu, dc %ld, ac %lu, p2p %lu, crest %lu/%u"
+                ", samples %lu\r\n"
+              , ch
+              , (unsigned long) rms->shift
+              , (unsigned long) rms->last
+              , (long) rms->dc
+              , (unsigned long) rms->ac
+              , (unsigned long) rms->p2p
+              , (unsigned long) rms->crest
+              , 1u << ADC_CREST_Q
+              , (unsigned long) rms->samples
+              );
+    }
+
+    printf( "rms: %lu mA, %lu mV\r\n"
+          , (unsigned long) adc_get_milli( ADC_CH_I )
+          , (unsigned long) adc_get_milli( ADC_CH_V )
+          );
+
+    if ( ADC_MODE_AC == cfg->mode )
+    {
+        adc_get_line( &line );
+
+        if ( FALSE != line.locked )
+        {
+            printf( "line: %lu.%03lu Hz, jitter %lu us\r\n"
+                  , (unsigned long) ( line.freq / 1000 )
+                  , (unsigned long) ( line.freq % 1000 )
+                  , (unsigned long) line.jitter
+                  );
+        }
+        else
+        {
+            printf( "line: no zero crossing\r\n" );
+        }
+    }
+
+    return CLI_RET_OK;
+}
+
+static Cli_Ret cli_meas_dc( Cli_Cmd_Args* args )
+{
+    Cli_Ret  ret  = CLI_RET_ERROR;
+    status_t sret = STATUS_ERROR;
+
+    if ( args->count > 2 )
+    {
+        sret = adc_set_mode( ADC_MODE_DC, args->num[2] );
+    }
+
+    if ( STATUS_OK == sret )
+    {
+        ret = cli_meas_save();
+    }
+    else
+    {
+        printf( "Error: Usage meas dc <samples>\r\n" );
+    }
+
+    return ret;
+}
+
+static Cli_Ret cli_meas_ac( Cli_Cmd_Args* args )
+{
+    Cli_Ret  ret  = CLI_RET_ERROR;
+    status_t sret = STATUS_ERROR;
+
+    if ( args->count > 2 )
+    {
+        sret = adc_set_mode( ADC_MODE_AC, args->num[2] );
+
+        if ( args->count > 3 )
+        {
+            sret |= adc_set_ref_ch( (uint8_t) args->num[3] );
+        }
+    }
+
+    if ( STATUS_OK == sret )
+    {
+        ret = cli_meas_save();
+    }
+    else
+    {
+        printf( "Error: Usage meas ac <1..%u periods> [reference ch]\r\n"
+              , ADC_AC_PERIODS_MAX
+              );
+    }
+
+    return ret;
+}
+
+static Cli_Ret cli_meas_rate( Cli_Cmd_Args* args )
+{
+    Cli_Ret  ret  = CLI_RET_ERROR;
+    status_t sret = STATUS_ERROR;
+
+    /* Numeric arguments are 16-bit, parse the rate from the string */
+    if ( args->count > 2 )
+    {
+        sret = adc_set_rate( strtoul( (char*) args->str[2], NULL, 10 ));
+    }
+
+    if ( STATUS_OK == sret )
+    {
+        printf( "Info: Rate set to %lu S/s\r\n"
+              , (unsigned long) adc_get_cfg()->rate
+              );
+        ret = cli_meas_save();
+    }
+    else
+    {
+        printf( "Error: Usage meas rate <1..%lu>\r\n"
+              , (unsigned long) ADC_RATE_MAX
+              );
+    }
+
+    return ret;
+}
+
+static Cli_Ret cli_meas_dec( Cli_Cmd_Args* args )
+{
+    Cli_Ret  ret  = CLI_RET_ERROR;
+    status_t sret = STATUS_ERROR;
+
+    if ( args->count > 2 )
+    {
+        sret = adc_set_dec( (uint8_t) args->num[2] );
+    }
+
+    if ( STATUS_OK == sret )
+    {
+        ret = cli_meas_save();
+    }
+    else
+    {
+        printf( "Error: Usage meas dec <0..%u>, ratio is 4^n\r\n"
+              , ADC_DEC_MAX
+              );
+    }
+
+    return ret;
+}
+
+static Cli_Ret cli_meas_bench( Cli_Cmd_Args* args )
+{
+    uint32_t us;
+    uint8_t  dec;
+
+    (void) args;
+
+    /* Acquisition pauses for each run, see adc_bench() */
+    for ( dec = 0; dec <= ADC_DEC_MAX; dec++ )
+    {
+        us = adc_bench( dec );
+
+        printf( "decimation %2u: %lu us per half buffer, max rate %lu S/s\r\n"
+              , 1u << ( 2 * dec )
+              , (unsigned long) us
+              , (unsigned long) (( 0 != us )
+                                 ? (( ADC_DMA_BUFF_SIZE / 2 / ADC_CH_NUM )
+                                    * 1000000UL / us )
+                                 : 0 )
+              );
+    }
+
+    return CLI_RET_OK;
+}
+
+static Cli_Ret cli_meas_stats( Cli_Cmd_Args* args )
+{
+    Adc_Dma_Stats_t stats;
+
+    (void) args;
+
+    adc_get_dma_stats( &stats );
+
+    printf( "halves %lu, processed %lu, missed %lu, late %lu\r\n"
+          , (unsigned long) stats.seq
+          , (unsigned long) stats.processed
+          , (unsigned long) stats.missed
+          , (unsigned long) stats.late
+          );
+    printf( "latency %lu us (max %lu), processing %lu us (max %lu)\r\n"
+          , (unsigned long) stats.lat_last
+          , (unsigned long) stats.lat_max
+          , (unsigned long) stats.proc_last
+          , (unsigned long) stats.proc_max
+          );
+
+    return CLI_RET_OK;
+}
+
+static Cli_Ret cli_meas_reset( Cli_Cmd_Args* args )
+{
+    (void) args;
+
+    adc_reset_dma_stats();
+
+    return CLI_RET_OK;
+}
+
+static const Cli_Cmd meas_cmds[] =
+{
+    { "show"
+    , cli_meas_show
+    , "Show measurement mode and last window"
+    },
+    { "dc"
+    , cli_meas_dc
+    , "Fixed sample count windows"
+    },
+    { "ac"
+    , cli_meas_ac
+    , "Zero crossing synchronised windows"
+    },
+    { "rate"
+    , cli_meas_rate
+    , "Set ADC trigger rate"
+    },
+    { "dec"
+    , cli_meas_dec
+    , "Set decimation ratio 4^n"
+    },
+    { "bench"
+    , cli_meas_bench
+    , "Time processing, show highest sustainable rate"
+    },
+    { "stats"
+    , cli_meas_stats
+    , "Show DMA overrun and latency counters"
+    },
+    { "reset"
+    , cli_meas_reset
+    , "Clear DMA overrun and latency counters"
+    }
+};
+
+const Cli_Cmd_List cmd_meas_list =
+{
+    "meas"
+    , meas_cmds
+    , sizeof ( meas_cmds ) / sizeof ( meas_cmds[0] )
+    , "Measurement commands"
+};
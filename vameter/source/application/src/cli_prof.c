@@ -0,0 +1,105 @@
+/**
+ ** Name
+ **   cli_prof.c
+ **
+ ** Purpose
+ **   Profiling commands
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "cli.h"
+
+#include "prof.h"
+
+#include <stdio.h>
+
+/* Ticks to us, rounded */
+static uint32_t cli_prof_us( uint64_t ticks )
+{
+    const uint32_t hz = prof_get_hz();
+
+    return (uint32_t)((( ticks * 1000000 ) + ( hz / 2 )) / hz );
+}
+
+static void cli_prof_print( Prof_Id_t id, const Prof_Scope_t* scope )
+{
+    uint8_t bin;
+
+    printf( "%-10s %lu %lu %lu %lu\r\n "
+          , prof_get_name( id )
+          , (unsigned long) scope->count
+          , (unsigned long) cli_prof_us( scope->min )
+          , (unsigned long) cli_prof_us( scope->total / scope->count )
+          , (unsigned long) cli_prof_us( scope->max )
+          );
+
+    /* Only the used span of the histogram */
+    for ( bin = 0; bin < PROF_HIST_BINS; bin++ )
+    {
+        if ((( scope->min >> bin ) <= 1 ) && ( 0 != ( scope->max >> bin )))
+        {
+            printf( " %u:%u", bin, scope->hist[bin] );
+        }
+    }
+
+    printf( "\r\n" );
+}
+
+static Cli_Ret cli_prof_show( Cli_Cmd_Args* args )
+{
+    Prof_Scope_t scope;
+    uint8_t      id;
+
+    (void) args;
+
+    printf( "%lu ticks/s, us: count min avg max, then log2 tick bins\r\n"
+          , (unsigned long) prof_get_hz()
+          );
+
+    for ( id = 0; id < PROF_NUM; id++ )
+    {
+        prof_get( (Prof_Id_t) id, &scope );
+
+        if ( 0 == scope.count )
+        {
+            printf( "%-10s -\r\n", prof_get_name( (Prof_Id_t) id ));
+        }
+        else
+        {
+            cli_prof_print( (Prof_Id_t) id, &scope );
+        }
+    }
+
+    return CLI_RET_OK;
+}
+
+static Cli_Ret cli_prof_reset( Cli_Cmd_Args* args )
+{
+    (void) args;
+
+    prof_reset();
+
+    return CLI_RET_OK;
+}
+
+static const Cli_Cmd prof_cmds[] =
+{
+    { "show"
+    , cli_prof_show
+    , "Show section timing and latency histograms"
+    },
+    { "reset"
+    , cli_prof_reset
+    , "Clear section timing"
+    }
+};
+
+const Cli_Cmd_List cmd_prof_list =
+{
+    "prof"
+    , prof_cmds
+    , sizeof ( prof_cmds ) / sizeof ( prof_cmds[0] )
+    , "Profiling commands"
+};
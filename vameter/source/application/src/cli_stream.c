@@ -0,0 +1,106 @@
+/**
+ ** Name
+ **   cli_stream.c
+ **
+ ** Purpose
+ **   Sample streaming commands
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Stream next to the running measurement
+ **   18-Oct-2026 (SSB) [] Check decimation before computing the rate
+ **/
+
+#include "cli.h"
+
+#include "adc.h"
+#include "stream.h"
+#include "uart.h"
+
+#include <stdio.h>
+
+/* Link budget in bytes per second, 10 bits per byte on the wire */
+static uint32_t cli_stream_link( void )
+{
+    return ( HAL_RCC_GetPCLK2Freq() / STREAM_UART->BRR ) / 10;
+}
+
+static Cli_Ret cli_stream_start( Cli_Cmd_Args* args )
+{
+    Cli_Ret  ret  = CLI_RET_ERROR;
+    uint16_t dec  = 1;
+    uint32_t rate;
+
+    if ( args->count > 2 )
+    {
+        dec = args->num[2];
+    }
+
+    /* Checked before narrowing, the rate divides by dec */
+    if (( 0 == dec )
+     || ( dec > STREAM_DEC_MAX )
+     || ( 0 != ( dec & ( dec - 1 ))))
+    {
+        printf( "Error: Usage stream start [1|2|4|8|16 decimation]\r\n" );
+    }
+    else
+    {
+        rate = stream_get_rate( (uint8_t) dec );
+
+        if ( rate > cli_stream_link() )
+        {
+            printf( "Error: %lu B/s exceed the %lu B/s link, "
+                    "raise decimation\r\n"
+                  , (unsigned long) rate
+                  , (unsigned long) cli_stream_link()
+                  );
+        }
+        else
+        {
+            printf( "Info: Streaming %lu pairs/s, %lu B/s, any key stops\r\n"
+                  , (unsigned long) ( adc_get_fs() / dec )
+                  , (unsigned long) rate
+                  );
+
+            /* Frames go out from the half buffer processing, the next
+             * received character ends up in cli_stream_stop().
+             */
+            if ( STATUS_OK == stream_start( (uint8_t) dec ))
+            {
+                ret = CLI_RET_OK;
+            }
+        }
+    }
+
+    return ret;
+}
+
+void cli_stream_stop( void )
+{
+    Stream_Stats_t stats;
+
+    stream_stop();
+    stream_get_stats( &stats );
+
+    printf( "\r\nInfo: %lu frames, %lu dropped, %lu bytes\r\n"
+          , (unsigned long) stats.frames
+          , (unsigned long) stats.dropped
+          , (unsigned long) stats.bytes
+          );
+}
+
+static const Cli_Cmd stream_cmds[] =
+{
+    { "start"
+    , cli_stream_start
+    , "Stream COBS framed samples [decimation] until a key is hit"
+    }
+};
+
+const Cli_Cmd_List cmd_stream_list =
+{
+    "stream"
+    , stream_cmds
+    , sizeof ( stream_cmds ) / sizeof ( stream_cmds[0] )
+    , "Binary sample streaming commands"
+};
@@ -7,13 +7,28 @@
  **
  ** Revision
  **   27-Aug-2020 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Add CPU load command
+ **   18-Oct-2026 (SSB) [] Add settings log command
+ **   18-Oct-2026 (SSB) [] 64-bit load totals
  **/
 
 #include "cli.h"
 
+#include "event.h"
+#include "flash.h"
 #include "gpio.h"
 #include "time.h"
 
+#include <stdio.h>
+
+static const char* const cli_sys_event_name[EVENT_NUM] =
+{
+    "adc",
+    "uart1 rx",
+    "uart2 rx",
+    "tick"
+};
+
 static Cli_Ret cli_sys_reset( Cli_Cmd_Args* args )
 {
     Cli_Ret ret = CLI_RET_OK;
@@ -25,11 +40,102 @@ static Cli_Ret cli_sys_reset( Cli_Cmd_Args* args )
     return ret;
 }
 
+/* Share of the window in per mille */
+static uint32_t cli_sys_permille( Time_t part, Time_t window )
+{
+    uint32_t ret = 0;
+
+    if ( 0 != window )
+    {
+        ret = (uint32_t)(( part * 1000 ) / window );
+    }
+
+    return ret;
+}
+
+static Cli_Ret cli_sys_load( Cli_Cmd_Args* args )
+{
+    Event_Load_t load;
+    Time_t       used;
+    uint32_t     pm;
+    uint8_t      id;
+
+    (void) args;
+
+    event_get_load( &load );
+
+    printf( "window %lu ms\r\n", (unsigned long) ( load.window / 1000 ));
+
+    used = load.sleep;
+
+    for ( id = 0; id < EVENT_NUM; id++ )
+    {
+        pm    = cli_sys_permille( load.event[id].busy, load.window );
+        used += load.event[id].busy;
+
+        printf( "%-8s: %3lu.%lu %%, runs %lu, max %lu us\r\n"
+              , cli_sys_event_name[id]
+              , (unsigned long) ( pm / 10 )
+              , (unsigned long) ( pm % 10 )
+              , (unsigned long) load.event[id].count
+              , (unsigned long) load.event[id].max
+              );
+    }
+
+    pm = cli_sys_permille( load.sleep, load.window );
+
+    printf( "sleep   : %3lu.%lu %%\r\n"
+          , (unsigned long) ( pm / 10 )
+          , (unsigned long) ( pm % 10 )
+          );
+
+    /* Interrupts and loop overhead */
+    pm = ( used < load.window )
+       ? cli_sys_permille( load.window - used, load.window )
+       : 0;
+
+    printf( "other   : %3lu.%lu %%\r\n"
+          , (unsigned long) ( pm / 10 )
+          , (unsigned long) ( pm % 10 )
+          );
+
+    return CLI_RET_OK;
+}
+
+static Cli_Ret cli_sys_flash( Cli_Cmd_Args* args )
+{
+    Flash_Stats_t stats;
+
+    (void) args;
+
+    flash_get_stats( &stats );
+
+    printf( "bank %lu, used %lu of %u bytes\r\n"
+          , (unsigned long) stats.bank_seq
+          , (unsigned long) stats.used
+          , (unsigned) FLASH_LOG_BANK_SIZE
+          );
+    printf( "appends %lu, compactions %lu since boot\r\n"
+          , (unsigned long) stats.appends
+          , (unsigned long) stats.compactions
+          );
+
+    return CLI_RET_OK;
+}
+
 static const Cli_Cmd sys_cmds[] =
 {
     { "reset"
     , cli_sys_reset
     , "Execute system reset"
+    },
+    { "load"
+    , cli_sys_load
+    , "Show CPU load per event since the last call"
+    },
+    { "flash"
+    , cli_sys_flash
+    , "Show settings log usage"
     }
 };
 
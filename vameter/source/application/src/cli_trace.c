@@ -0,0 +1,69 @@
+/**
+ ** Name
+ **   cli_trace.c
+ **
+ ** Purpose
+ **   Event trace commands
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "cli.h"
+
+#include "trace.h"
+
+#include <stdio.h>
+
+static Cli_Ret cli_trace_start( Cli_Cmd_Args* args )
+{
+    (void) args;
+
+    trace_start();
+
+    return CLI_RET_OK;
+}
+
+static Cli_Ret cli_trace_stop( Cli_Cmd_Args* args )
+{
+    (void) args;
+
+    trace_stop();
+
+    return CLI_RET_OK;
+}
+
+static Cli_Ret cli_trace_dump( Cli_Cmd_Args* args )
+{
+    (void) args;
+
+    fflush( stdout );
+
+    (void) trace_dump();
+
+    return CLI_RET_OK;
+}
+
+static const Cli_Cmd trace_cmds[] =
+{
+    { "start"
+    , cli_trace_start
+    , "Clear the trace and record"
+    },
+    { "stop"
+    , cli_trace_stop
+    , "Freeze the trace"
+    },
+    { "dump"
+    , cli_trace_dump
+    , "Send the trace binary, decode with tools/vatrace"
+    }
+};
+
+const Cli_Cmd_List cmd_trace_list =
+{
+    "trace"
+    , trace_cmds
+    , sizeof ( trace_cmds ) / sizeof ( trace_cmds[0] )
+    , "Event trace commands"
+};
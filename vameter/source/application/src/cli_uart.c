@@ -0,0 +1,115 @@
+/**
+ ** Name
+ **   cli_uart.c
+ **
+ ** Purpose
+ **   UART commands
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "cli.h"
+
+#include "uart.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char* const cli_uart_policy_name[] =
+{
+    "block",
+    "drop",
+    "truncate"
+};
+
+static void cli_uart_print_stats( const char* name, USART_TypeDef* uart )
+{
+    Uart_Tx_Stats_t stats;
+
+    uart_get_tx_stats( uart, &stats );
+
+    printf( "%s: tx %s, size %lu, pending %lu, hwm %lu, dropped %lu"
+            ", rx overrun %lu\r\n"
+          , name
+          , cli_uart_policy_name[stats.policy]
+          , (unsigned long) stats.size
+          , (unsigned long) stats.pending
+          , (unsigned long) stats.hwm
+          , (unsigned long) stats.dropped
+          , (unsigned long) uart_get_rx_overrun( uart )
+          );
+}
+
+static Cli_Ret cli_uart_stats( Cli_Cmd_Args* args )
+{
+    (void) args;
+
+    cli_uart_print_stats( "uart1", USART1 );
+    cli_uart_print_stats( "uart2", USART2 );
+
+    return CLI_RET_OK;
+}
+
+static Cli_Ret cli_uart_reset( Cli_Cmd_Args* args )
+{
+    (void) args;
+
+    uart_reset_tx_stats( USART1 );
+    uart_reset_tx_stats( USART2 );
+
+    return CLI_RET_OK;
+}
+
+static Cli_Ret cli_uart_policy( Cli_Cmd_Args* args )
+{
+    Cli_Ret ret = CLI_RET_ERROR;
+    uint8_t i;
+
+    if ( args->count > 2 )
+    {
+        for ( i = 0; i < ( sizeof( cli_uart_policy_name )
+                         / sizeof( cli_uart_policy_name[0] )); i++ )
+        {
+            if ( 0 == strncmp( (char*) args->str[2]
+                             , cli_uart_policy_name[i]
+                             , CLI_CMD_MAX_ARG_SIZE ))
+            {
+                uart_set_tx_policy( CLI_UART, (Uart_Tx_Policy_t) i );
+                ret = CLI_RET_OK;
+                break;
+            }
+        }
+    }
+
+    if ( CLI_RET_OK != ret )
+    {
+        printf( "Error: Usage uart policy <block|drop|truncate>\r\n" );
+    }
+
+    return ret;
+}
+
+static const Cli_Cmd uart_cmds[] =
+{
+    { "stats"
+    , cli_uart_stats
+    , "Show UART transmit and receive counters"
+    },
+    { "reset"
+    , cli_uart_reset
+    , "Clear UART transmit counters"
+    },
+    { "policy"
+    , cli_uart_policy
+    , "Set CLI UART full buffer policy"
+    }
+};
+
+const Cli_Cmd_List cmd_uart_list =
+{
+    "uart"
+    , uart_cmds
+    , sizeof ( uart_cmds ) / sizeof ( uart_cmds[0] )
+    , "UART commands"
+};
@@ -0,0 +1,38 @@
+/**
+ ** Name
+ **   crc.c
+ **
+ ** Purpose
+ **   CRC routines
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "crc.h"
+
+/* Nibble table, two lookups per byte. A full 256 entry table buys little
+ * for the record sizes handled here and costs 512 bytes of flash.
+ */
+static const uint16_t crc16_tbl[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+uint16_t crc16( uint16_t crc, const void* data, uint32_t size )
+{
+    const uint8_t* p = (const uint8_t*) data;
+    uint8_t        idx;
+
+    while ( size-- > 0 )
+    {
+        idx = ( crc >> 12 ) ^ ( *p >> 4 );
+        crc = (uint16_t)(( crc << 4 ) ^ crc16_tbl[idx] );
+        idx = ( crc >> 12 ) ^ ( *p & 0x0F );
+        crc = (uint16_t)(( crc << 4 ) ^ crc16_tbl[idx] );
+        p++;
+    }
+
+    return crc;
+}
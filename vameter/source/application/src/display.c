@@ -1,20 +1,477 @@
 /**
  ** Name
- **   gpio.c
+ **   display.c
  **
  ** Purpose
- **   GPIO routines
+ **   7-segment display routines
  **
  ** Revision
  **   19-Apr-2020 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Timer multiplexed driver
+ **   18-Oct-2026 (SSB) [] Profiling probe
+ **   18-Oct-2026 (SSB) [] Trace multiplexing interrupt
  **/
 
 #include "display.h"
 
-status_t display_init( void )
+#include "prof.h"
+#include "trace.h"
+
+#define DISP_PORT_NUM  (3)
+#define DISP_SEG_NUM   (8)
+#define DISP_TMR_ARR   (( DISP_TMR_CLK_HZ                                \
+                        / ( DISP_FRAME_HZ * DISP_DIGITS )) - 1 )
+
+typedef struct
+{
+    GPIO_TypeDef* port;
+    uint16_t      pin;
+} Disp_Pin_t;
+
+/* One BSRR word per port for every digit slot, a slot lights the same
+ * digit position of all displays.
+ */
+typedef struct
+{
+    uint32_t bsrr[DISP_DIGITS][DISP_PORT_NUM];
+} Disp_Frame_t;
+
+static GPIO_TypeDef* const disp_ports[DISP_PORT_NUM] =
+{
+    GPIOA, GPIOB, GPIOC
+};
+
+static const Disp_Pin_t disp_seg_pins[DISP_NUM][DISP_SEG_NUM] =
+{
+    {
+        { DISP1_SEG_A_PORT, DISP1_SEG_A_PIN },
+        { DISP1_SEG_B_PORT, DISP1_SEG_B_PIN },
+        { DISP1_SEG_C_PORT, DISP1_SEG_C_PIN },
+        { DISP1_SEG_D_PORT, DISP1_SEG_D_PIN },
+        { DISP1_SEG_E_PORT, DISP1_SEG_E_PIN },
+        { DISP1_SEG_F_PORT, DISP1_SEG_F_PIN },
+        { DISP1_SEG_G_PORT, DISP1_SEG_G_PIN },
+        { DISP1_SEG_H_PORT, DISP1_SEG_H_PIN }
+    },
+    {
+        { DISP2_SEG_A_PORT, DISP2_SEG_A_PIN },
+        { DISP2_SEG_B_PORT, DISP2_SEG_B_PIN },
+        { DISP2_SEG_C_PORT, DISP2_SEG_C_PIN },
+        { DISP2_SEG_D_PORT, DISP2_SEG_D_PIN },
+        { DISP2_SEG_E_PORT, DISP2_SEG_E_PIN },
+        { DISP2_SEG_F_PORT, DISP2_SEG_F_PIN },
+        { DISP2_SEG_G_PORT, DISP2_SEG_G_PIN },
+        { DISP2_SEG_H_PORT, DISP2_SEG_H_PIN }
+    }
+};
+
+static const Disp_Pin_t disp_com_pins[DISP_NUM][DISP_DIGITS] =
+{
+    {
+        { DISP1_T1_PORT, DISP1_T1_PIN },
+        { DISP1_T2_PORT, DISP1_T2_PIN },
+        { DISP1_T3_PORT, DISP1_T3_PIN },
+        { DISP1_T4_PORT, DISP1_T4_PIN }
+    },
+    {
+        { DISP2_T1_PORT, DISP2_T1_PIN },
+        { DISP2_T2_PORT, DISP2_T2_PIN },
+        { DISP2_T3_PORT, DISP2_T3_PIN },
+        { DISP2_T4_PORT, DISP2_T4_PIN }
+    }
+};
+
+/* Digits 0-9 */
+static const uint8_t disp_font_digits[10] =
+{
+    0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F
+};
+
+static TIM_HandleTypeDef disp_tmr;
+
+/* Pin masks per port, filled by display_init() */
+static uint16_t disp_seg_mask[DISP_NUM][DISP_SEG_NUM][DISP_PORT_NUM];
+static uint16_t disp_com_mask[DISP_DIGITS][DISP_PORT_NUM];
+static uint16_t disp_all_seg[DISP_PORT_NUM];
+static uint16_t disp_all_com[DISP_PORT_NUM];
+
+/* All commons off, used before every digit and for blanking */
+static uint32_t disp_off[DISP_PORT_NUM];
+
+static uint8_t disp_seg[DISP_NUM][DISP_DIGITS];
+
+/* The main loop only writes the back frame and hands it over with
+ * disp_swap, the interrupt switches frames at the start of a scan.
+ */
+static Disp_Frame_t     disp_frame[2];
+static volatile uint8_t disp_front;
+static volatile bool_t  disp_swap;
+static uint8_t          disp_slot;
+
+static uint8_t disp_port_idx( GPIO_TypeDef* port )
+{
+    uint8_t idx = 0;
+
+    while (( idx < ( DISP_PORT_NUM - 1 )) && ( disp_ports[idx] != port ))
+    {
+        idx++;
+    }
+
+    return idx;
+}
+
+/* BSRR word driving the pins in on to level on and the rest of all to
+ * the opposite level
+ */
+static uint32_t disp_bsrr( uint16_t on, uint16_t all, GPIO_PinState level )
+{
+    uint32_t ret;
+    uint16_t off = all & ~on;
+
+    if ( GPIO_PIN_SET == level )
+    {
+        ret = on | ((uint32_t) off << 16 );
+    }
+    else
+    {
+        ret = off | ((uint32_t) on << 16 );
+    }
+
+    return ret;
+}
+
+static void disp_publish( void )
+{
+    Disp_Frame_t* frame;
+    uint16_t      seg_on;
+    uint8_t       slot;
+    uint8_t       port;
+    uint8_t       disp;
+    uint8_t       bit;
+
+    /* Claim the back frame, the interrupt may just have switched */
+    disp_swap = FALSE;
+    __DMB();
+    frame = &disp_frame[disp_front ^ 1];
+
+    for ( slot = 0; slot < DISP_DIGITS; slot++ )
+    {
+        for ( port = 0; port < DISP_PORT_NUM; port++ )
+        {
+            seg_on = 0;
+
+            for ( disp = 0; disp < DISP_NUM; disp++ )
+            {
+                for ( bit = 0; bit < DISP_SEG_NUM; bit++ )
+                {
+                    if ( 0 != ( disp_seg[disp][slot] & ( 1 << bit )))
+                    {
+                        seg_on |= disp_seg_mask[disp][bit][port];
+                    }
+                }
+            }
+
+            frame->bsrr[slot][port] =
+                    disp_bsrr( seg_on, disp_all_seg[port], DISP_SEG_ON )
+                  | disp_bsrr( disp_com_mask[slot][port]
+                             , disp_all_com[port]
+                             , DISP_COM_ON
+                             );
+        }
+    }
+
+    __DMB();
+    disp_swap = TRUE;
+}
+
+static uint8_t disp_char_seg( char ch )
+{
+    uint8_t seg;
+
+    if (( ch >= '0' ) && ( ch <= '9' ))
+    {
+        seg = disp_font_digits[ch - '0'];
+    }
+    else
+    {
+        switch ( ch )
+        {
+            case '-': seg = DISP_SEG_G; break;
+            case '_': seg = DISP_SEG_D; break;
+            case 'A': seg = 0x77;       break;
+            case 'b': seg = 0x7C;       break;
+            case 'C': seg = 0x39;       break;
+            case 'd': seg = 0x5E;       break;
+            case 'E': seg = 0x79;       break;
+            case 'F': seg = 0x71;       break;
+            case 'H': seg = 0x76;       break;
+            case 'L': seg = 0x38;       break;
+            case 'n': seg = 0x54;       break;
+            case 'o': seg = 0x5C;       break;
+            case 'P': seg = 0x73;       break;
+            case 'r': seg = 0x50;       break;
+            case 'U': seg = 0x3E;       break;
+            default:  seg = 0x00;       break;
+        }
+    }
+
+    return seg;
+}
+
+static void disp_gpio_init( void )
 {
-    status_t         ret             = STATUS_OK;
     GPIO_InitTypeDef GPIO_InitStruct = {0};
+    uint8_t          port;
+
+    DISP1_CLOCK_ENABLE();
+    DISP2_CLOCK_ENABLE();
+
+    /* PA15, PB3 and PB4 are JTAG pins after reset, keep SWD only */
+    __HAL_RCC_AFIO_CLK_ENABLE();
+    __HAL_AFIO_REMAP_SWJ_NOJTAG();
+
+    for ( port = 0; port < DISP_PORT_NUM; port++ )
+    {
+        if ( 0 != ( disp_all_seg[port] | disp_all_com[port] ))
+        {
+            disp_ports[port]->BSRR = disp_off[port];
+
+            GPIO_InitStruct.Pin   = disp_all_seg[port] | disp_all_com[port];
+            GPIO_InitStruct.Mode  = GPIO_MODE_OUTPUT_PP;
+            GPIO_InitStruct.Pull  = GPIO_NOPULL;
+            GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+            HAL_GPIO_Init( disp_ports[port], &GPIO_InitStruct );
+        }
+    }
+}
+
+static status_t disp_tmr_init( void )
+{
+    status_t           ret  = STATUS_OK;
+    HAL_StatusTypeDef  hret;
+    TIM_OC_InitTypeDef oc_cfg = {0};
+
+    disp_tmr.Instance               = DISP_TMR;
+    disp_tmr.Init.Prescaler         = ( SystemCoreClock
+                                      / DISP_TMR_CLK_HZ ) - 1;
+    disp_tmr.Init.Period            = DISP_TMR_ARR;
+    disp_tmr.Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
+    disp_tmr.Init.CounterMode       = TIM_COUNTERMODE_UP;
+    disp_tmr.Init.RepetitionCounter = 0;
+
+    oc_cfg.OCMode     = TIM_OCMODE_TIMING;
+    oc_cfg.Pulse      = DISP_TMR_ARR + 1;
+    oc_cfg.OCPolarity = TIM_OCPOLARITY_HIGH;
+    oc_cfg.OCFastMode = TIM_OCFAST_DISABLE;
+
+    __HAL_RCC_TIM4_CLK_ENABLE();
+
+    hret  = HAL_TIM_OC_Init( &disp_tmr );
+    hret |= HAL_TIM_OC_ConfigChannel( &disp_tmr, &oc_cfg, TIM_CHANNEL_1 );
+
+    if ( HAL_OK == hret )
+    {
+        /* Short enough to run above the ADC DMA without delaying it much */
+        HAL_NVIC_SetPriority( TIM4_IRQn, 1, 0 );
+        HAL_NVIC_EnableIRQ( TIM4_IRQn );
+
+        hret  = HAL_TIM_Base_Start_IT( &disp_tmr );
+        hret |= HAL_TIM_OC_Start_IT( &disp_tmr, TIM_CHANNEL_1 );
+    }
+
+    if ( HAL_OK != hret )
+    {
+        ret = STATUS_ERROR;
+    }
+
+    return ret;
+}
+
+status_t display_init( void )
+{
+    uint8_t disp;
+    uint8_t bit;
+    uint8_t slot;
+    uint8_t port;
+
+    for ( disp = 0; disp < DISP_NUM; disp++ )
+    {
+        for ( bit = 0; bit < DISP_SEG_NUM; bit++ )
+        {
+            port = disp_port_idx( disp_seg_pins[disp][bit].port );
+
+            disp_seg_mask[disp][bit][port] |= disp_seg_pins[disp][bit].pin;
+            disp_all_seg[port]             |= disp_seg_pins[disp][bit].pin;
+        }
+
+        for ( slot = 0; slot < DISP_DIGITS; slot++ )
+        {
+            port = disp_port_idx( disp_com_pins[disp][slot].port );
+
+            disp_com_mask[slot][port] |= disp_com_pins[disp][slot].pin;
+            disp_all_com[port]        |= disp_com_pins[disp][slot].pin;
+        }
+    }
+
+    for ( port = 0; port < DISP_PORT_NUM; port++ )
+    {
+        /* Commons only, segments stay as they are */
+        disp_off[port] = disp_bsrr( 0, disp_all_com[port], DISP_COM_ON );
+    }
+
+    disp_gpio_init();
+    disp_publish();
+
+    return disp_tmr_init();
+}
+
+status_t display_set_segments( uint8_t disp, const uint8_t* seg )
+{
+    status_t ret = STATUS_ERROR;
+    uint8_t  i;
+
+    if (( disp < DISP_NUM ) && ( NULL != seg ))
+    {
+        for ( i = 0; i < DISP_DIGITS; i++ )
+        {
+            disp_seg[disp][i] = seg[i];
+        }
+
+        disp_publish();
+        ret = STATUS_OK;
+    }
+
+    return ret;
+}
+
+status_t display_puts( uint8_t disp, const char* str )
+{
+    status_t ret = STATUS_ERROR;
+    uint8_t  seg[DISP_DIGITS] = {0};
+    uint8_t  i = 0;
+
+    if ( NULL != str )
+    {
+        while (( '\0' != *str ) && (( i < DISP_DIGITS ) || ( '.' == *str )))
+        {
+            if (( '.' == *str ) && ( i > 0 ))
+            {
+                seg[i - 1] |= DISP_SEG_DP;
+            }
+            else if ( i < DISP_DIGITS )
+            {
+                seg[i++] = disp_char_seg( *str );
+            }
+            str++;
+        }
+
+        ret = display_set_segments( disp, seg );
+    }
 
     return ret;
 }
+
+status_t display_put_milli( uint8_t disp, int32_t val )
+{
+    char     str[DISP_DIGITS + 3];
+    uint32_t mag    = ( val < 0 ) ? (uint32_t) -val : (uint32_t) val;
+    uint8_t  digits = ( val < 0 ) ? ( DISP_DIGITS - 1 ) : DISP_DIGITS;
+    uint8_t  frac   = 3;
+    uint32_t limit  = 1;
+    uint8_t  pos    = sizeof( str ) - 1;
+    bool_t   ovf;
+    uint8_t  i;
+
+    for ( i = 0; i < digits; i++ )
+    {
+        limit *= 10;
+    }
+
+    /* Drop decimals until the value fits with at least one integer digit,
+     * rounding the last one kept
+     */
+    while (( frac > 0 ) && (( mag >= limit ) || ( frac >= digits )))
+    {
+        mag = ( mag + 5 ) / 10;
+        frac--;
+    }
+
+    ovf      = ( mag >= limit );
+    str[pos] = '\0';
+
+    /* Right to left, zero padded to all digits */
+    for ( i = 0; i < digits; i++ )
+    {
+        if (( i == frac ) && ( 0 != frac ))
+        {
+            str[--pos] = '.';
+        }
+
+        str[--pos] = ( FALSE != ovf ) ? '-' : ( '0' + ( mag % 10 ));
+        mag       /= 10;
+    }
+
+    if ( val < 0 )
+    {
+        str[--pos] = '-';
+    }
+
+    return display_puts( disp, &str[pos] );
+}
+
+void display_set_brightness( uint8_t level )
+{
+    if ( level > DISP_BRIGHT_MAX )
+    {
+        level = DISP_BRIGHT_MAX;
+    }
+
+    /* Past the period at maximum, so the digit is never blanked */
+    __HAL_TIM_SET_COMPARE( &disp_tmr
+                         , TIM_CHANNEL_1
+                         , (( DISP_TMR_ARR + 1 ) * level ) / DISP_BRIGHT_MAX
+                         );
+}
+
+/* Plain register stores only, no HAL and no segment decoding */
+void display_tmr_irq_hdl( void )
+{
+    const uint32_t* bsrr;
+    uint32_t        sr = DISP_TMR->SR;
+
+    PROF_BEGIN( PROF_DISP_IRQ );
+    TRACE_BEGIN( TRACE_DISP_IRQ, disp_slot );
+
+    DISP_TMR->SR = ~sr;
+
+    if ( 0 != ( sr & TIM_SR_UIF ))
+    {
+        if (( 0 == disp_slot ) && ( FALSE != disp_swap ))
+        {
+            disp_front ^= 1;
+            disp_swap   = FALSE;
+        }
+
+        bsrr = disp_frame[disp_front].bsrr[disp_slot];
+
+        GPIOA->BSRR = disp_off[0];
+        GPIOB->BSRR = disp_off[1];
+        GPIOC->BSRR = disp_off[2];
+        GPIOA->BSRR = bsrr[0];
+        GPIOB->BSRR = bsrr[1];
+        GPIOC->BSRR = bsrr[2];
+
+        disp_slot = ( disp_slot + 1 ) & ( DISP_DIGITS - 1 );
+    }
+
+    /* Also taken right after the update at brightness 0 */
+    if ( 0 != ( sr & TIM_SR_CC1IF ))
+    {
+        GPIOA->BSRR = disp_off[0];
+        GPIOB->BSRR = disp_off[1];
+        GPIOC->BSRR = disp_off[2];
+    }
+
+    TRACE_END( TRACE_DISP_IRQ, disp_slot );
+    PROF_END( PROF_DISP_IRQ );
+}
@@ -0,0 +1,133 @@
+/**
+ ** Name
+ **   event.c
+ **
+ ** Purpose
+ **   Run to completion event loop
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Trace handlers and sleep
+ **   18-Oct-2026 (SSB) [] Full time base for load, no wrap after 71 minutes
+ **/
+
+#include "event.h"
+
+#include "tim.h"
+#include "trace.h"
+
+#include <string.h>
+
+static volatile uint32_t event_pending = 0;
+static Event_Hdl_t       event_hdl[EVENT_NUM];
+static Event_Load_t      event_load;
+static Time_t            event_window_start;
+
+static Time_t event_now( void )
+{
+    Time_t now;
+
+    get_time( &now );
+
+    return now;
+}
+
+void event_register( Event_Id_t id, Event_Hdl_t hdl )
+{
+    if ( id < EVENT_NUM )
+    {
+        event_hdl[id] = hdl;
+    }
+}
+
+/*
+ * Mark event pending, safe from any interrupt priority
+ */
+void event_post( Event_Id_t id )
+{
+    __atomic_fetch_or( &event_pending, 1UL << id, __ATOMIC_RELEASE );
+}
+
+static void event_dispatch( uint32_t pending )
+{
+    Event_Stats_t* stats;
+    Time_t         start;
+    uint32_t       busy;
+    uint8_t        id;
+
+    for ( id = 0; id < EVENT_NUM; id++ )
+    {
+        if ( 0 != ( pending & ( 1UL << id )))
+        {
+            stats = &event_load.event[id];
+            start = event_now();
+
+            TRACE_BEGIN( TRACE_EVENT, id );
+
+            if ( NULL != event_hdl[id] )
+            {
+                event_hdl[id]();
+            }
+
+            TRACE_END( TRACE_EVENT, id );
+
+            busy = (uint32_t)( event_now() - start );
+
+            stats->count++;
+            stats->busy += busy;
+
+            if ( busy > stats->max )
+            {
+                stats->max = busy;
+            }
+        }
+    }
+}
+
+/*
+ * Never returns. Interrupts are disabled between the empty queue check and
+ * WFI, so an event posted in between can't be slept over - a pending
+ * interrupt wakes the core even with PRIMASK set and runs right after it
+ * is cleared again.
+ */
+void event_loop( void )
+{
+    uint32_t pending;
+    Time_t   start;
+
+    event_window_start = event_now();
+
+    for(;;)
+    {
+        __disable_irq();
+
+        if ( 0 == event_pending )
+        {
+            start = event_now();
+            TRACE_BEGIN( TRACE_SLEEP, 0 );
+            __WFI();
+            TRACE_END( TRACE_SLEEP, 0 );
+            event_load.sleep += event_now() - start;
+        }
+
+        __enable_irq();
+
+        pending = __atomic_exchange_n( &event_pending, 0, __ATOMIC_ACQUIRE );
+
+        event_dispatch( pending );
+    }
+}
+
+/*
+ * Copy the load since the previous call and start a new window
+ */
+void event_get_load( Event_Load_t* load )
+{
+    const Time_t now = event_now();
+
+    *load        = event_load;
+    load->window = now - event_window_start;
+
+    memset( &event_load, 0, sizeof( Event_Load_t ));
+    event_window_start = now;
+}
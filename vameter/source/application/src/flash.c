@@ -7,128 +7,507 @@
  **
  ** Revision
  **   28-Aug-2020 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Log-structured settings store
  **/
 
 #include "flash.h"
 
-status_t flash_read( void* buff, uint32_t size, uint32_t offset )
+#include "crc.h"
+
+#include <string.h>
+
+/* Bank layout
+ *
+ *   Flash_Bank_Hdr_t | Flash_Rec_Hdr_t | data | Flash_Rec_Hdr_t | data | ...
+ *
+ * Data is programmed before its header, so an interrupted append leaves an
+ * erased header followed by programmed words. The scan at boot stops at the
+ * first erased header and marks the bank dirty if anything past it is not
+ * erased; the next write then compacts first. A record whose header made it
+ * only half way fails the CRC and is skipped. The bank header is written
+ * last on compaction, so an interrupted compaction keeps the old bank.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t seq;           /* Bank generation, the newer valid bank wins */
+} Flash_Bank_Hdr_t;
+
+typedef struct
+{
+    uint8_t  slot;
+    uint8_t  len;           /* Data bytes following the header */
+    uint16_t crc;           /* Over slot, len, seq and data */
+    uint32_t seq;           /* Record sequence number */
+} Flash_Rec_Hdr_t;
+
+typedef struct
+{
+    uint32_t bank;          /* Active bank address */
+    uint32_t bank_seq;
+    uint32_t rec_seq;       /* Next record sequence number */
+    uint32_t head;          /* Append offset in the active bank */
+    bool_t   ready;
+    bool_t   dirty;         /* Programmed words past head */
+} Flash_Log_t;
+
+#define FLASH_BANK_HDR_SIZE (8)
+#define FLASH_REC_HDR_SIZE  (8)
+#define FLASH_REC_MAX_SIZE  ( FLASH_REC_HDR_SIZE + FLASH_SLOT_SIZE )
+
+/* A compacted bank always leaves room for one more record */
+#if (( FLASH_BANK_HDR_SIZE + ( FLASH_SLOT_NUM + 1 ) * FLASH_REC_MAX_SIZE ) \
+        > FLASH_LOG_BANK_SIZE )
+    #error "Flash log bank too small for the user page"
+#endif
+
+static Flash_Log_t   flash_log;
+static Flash_Stats_t flash_stats;
+
+/* Offset of the latest record per slot in the active bank, 0 = never written */
+static uint16_t flash_idx[FLASH_SLOT_NUM];
+
+static bool_t flash_seq_newer( uint32_t a, uint32_t b )
+{
+    return ( (int32_t)( a - b ) > 0 ) ? TRUE : FALSE;
+}
+
+static uint16_t flash_rec_crc( const Flash_Rec_Hdr_t* hdr, const void* data )
+{
+    uint16_t crc;
+
+    crc = crc16( CRC16_INIT, &hdr->slot, 2 );
+    crc = crc16( crc, &hdr->seq, sizeof( hdr->seq ));
+    crc = crc16( crc, data, hdr->len );
+
+    return crc;
+}
+
+static status_t flash_prog( uint32_t address, const void* data, uint32_t size )
+{
+    HAL_StatusTypeDef hret = HAL_OK;
+    uint32_t          word;
+    uint32_t          i;
+
+    for ( i = 0; ( i < size ) && ( HAL_OK == hret ); i += 4 )
+    {
+        memcpy( &word, (const uint8_t*) data + i, 4 );
+
+        hret = HAL_FLASH_Program( FLASH_TYPEPROGRAM_WORD, address + i, word );
+    }
+
+    return ( HAL_OK == hret ) ? STATUS_OK : STATUS_ERROR;
+}
+
+static status_t flash_erase_bank( uint32_t bank )
 {
-    status_t ret      = STATUS_ERROR;
-    uint32_t location = FLASH_USER_PAGE_ADDR + offset;
-    uint32_t i;
-    uint8_t* data     = (uint8_t*) buff;
+    status_t               ret   = STATUS_ERROR;
+    HAL_StatusTypeDef      hret;
+    FLASH_EraseInitTypeDef erase = {0};
+    uint32_t               page_error;
+
+    erase.TypeErase   = FLASH_TYPEERASE_PAGES;
+    erase.PageAddress = bank;
+    erase.NbPages     = FLASH_LOG_BANK_PAGES;
+
+    hret = HAL_FLASHEx_Erase( &erase, &page_error );
 
-    if ( NULL != data )
+    if (( HAL_OK == hret ) && ( FLASH_PAGE_ERASE_OK == page_error ))
     {
-        if (( offset + size ) <= FLASH_PAGE_SIZE )
+        ret = STATUS_OK;
+    }
+
+    return ret;
+}
+
+static bool_t flash_bank_valid( uint32_t bank, uint32_t* seq )
+{
+    const Flash_Bank_Hdr_t* hdr = (const Flash_Bank_Hdr_t*) bank;
+    bool_t                  ret = FALSE;
+
+    if ( FLASH_LOG_MAGIC == hdr->magic )
+    {
+        *seq = hdr->seq;
+        ret  = TRUE;
+    }
+
+    return ret;
+}
+
+/* Rebuild the slot index from the active bank */
+static void flash_scan( void )
+{
+    const Flash_Rec_Hdr_t* hdr;
+    uint32_t               off = FLASH_BANK_HDR_SIZE;
+    uint32_t               i;
+    bool_t                 first = TRUE;
+
+    memset( flash_idx, 0, sizeof( flash_idx ));
+    flash_log.dirty = FALSE;
+
+    while (( off + FLASH_REC_HDR_SIZE ) <= FLASH_LOG_BANK_SIZE )
+    {
+        hdr = (const Flash_Rec_Hdr_t*)( flash_log.bank + off );
+
+        if (( FLASH_PAGE_ERASE_OK == ((const uint32_t*) hdr)[0] )
+         && ( FLASH_PAGE_ERASE_OK == ((const uint32_t*) hdr)[1] ))
+        {
+            break;
+        }
+
+        if (( hdr->slot >= FLASH_SLOT_NUM )
+         || ( hdr->len > FLASH_SLOT_SIZE )
+         || ( 0 != ( hdr->len & 3 ))
+         || (( off + FLASH_REC_HDR_SIZE + hdr->len ) > FLASH_LOG_BANK_SIZE ))
+        {
+            /* Length can not be trusted, nothing past it is reachable */
+            flash_log.dirty = TRUE;
+            break;
+        }
+
+        if ( hdr->crc == flash_rec_crc( hdr, hdr + 1 ))
         {
-            for ( i = 0; i < size; i++ )
+            if (( 0 == flash_idx[hdr->slot] )
+             || flash_seq_newer( hdr->seq
+                               , ((const Flash_Rec_Hdr_t*)( flash_log.bank
+                                                          + flash_idx[hdr->slot]
+                                                          ))->seq
+                               ))
             {
-                data[i] = *(volatile uint8_t*)( location + i );
+                flash_idx[hdr->slot] = (uint16_t) off;
             }
 
-            ret = STATUS_OK;
+            if ( first || flash_seq_newer( hdr->seq + 1, flash_log.rec_seq ))
+            {
+                flash_log.rec_seq = hdr->seq + 1;
+                first             = FALSE;
+            }
         }
+
+        off += FLASH_REC_HDR_SIZE + hdr->len;
+    }
+
+    flash_log.head = off;
+
+    for ( i = off; i < FLASH_LOG_BANK_SIZE; i += 4 )
+    {
+        if ( FLASH_PAGE_ERASE_OK != *(const uint32_t*)( flash_log.bank + i ))
+        {
+            flash_log.dirty = TRUE;
+            break;
+        }
+    }
+}
+
+static status_t flash_append( uint8_t slot, const void* data, uint8_t len )
+{
+    status_t        ret;
+    Flash_Rec_Hdr_t hdr;
+    uint32_t        address = flash_log.bank + flash_log.head;
+
+    hdr.slot = slot;
+    hdr.len  = len;
+    hdr.seq  = flash_log.rec_seq;
+    hdr.crc  = flash_rec_crc( &hdr, data );
+
+    ret = flash_prog( address + FLASH_REC_HDR_SIZE, data, len );
+
+    if ( STATUS_OK == ret )
+    {
+        ret = flash_prog( address, &hdr, FLASH_REC_HDR_SIZE );
+    }
+
+    if ( STATUS_OK == ret )
+    {
+        flash_idx[slot]    = (uint16_t) flash_log.head;
+        flash_log.head    += FLASH_REC_HDR_SIZE + len;
+        flash_log.rec_seq += 1;
+        flash_stats.appends++;
+    }
+    else
+    {
+        /* Whatever got programmed has to go before the next append */
+        flash_log.dirty = TRUE;
     }
 
     return ret;
 }
 
-status_t flash_write( void* buff, uint32_t size, uint32_t offset )
+/* Copy the latest record of every slot to the other bank and switch */
+static status_t flash_compact( void )
 {
-    status_t               ret  = STATUS_OK;
-    HAL_StatusTypeDef      hret = HAL_ERROR;
-    FLASH_EraseInitTypeDef erase = {0};
-    uint32_t               page_error;
-    uint32_t               i = 0;
-    uint32_t               address;
+    status_t               ret;
+    Flash_Bank_Hdr_t       bank_hdr;
+    const Flash_Rec_Hdr_t* hdr;
+    uint32_t               bank;
+    uint32_t               off = FLASH_BANK_HDR_SIZE;
+    uint32_t               size;
+    uint8_t                slot;
 
-    erase.TypeErase   = FLASH_TYPEERASE_PAGES;
-    erase.PageAddress = FLASH_COPY_PAGE_ADDR;
-    erase.NbPages     = 1;
+    bank = ( FLASH_LOG_BANK0_ADDR == flash_log.bank )
+         ? FLASH_LOG_BANK1_ADDR
+         : FLASH_LOG_BANK0_ADDR;
+
+    ret = flash_erase_bank( bank );
 
-    if ( NULL != buff )
+    for ( slot = 0; ( slot < FLASH_SLOT_NUM ) && ( STATUS_OK == ret ); slot++ )
     {
-        if (( size + offset ) <= FLASH_PAGE_SIZE )
+        if ( 0 != flash_idx[slot] )
         {
-            HAL_FLASH_Unlock();
+            hdr  = (const Flash_Rec_Hdr_t*)( flash_log.bank + flash_idx[slot] );
+            size = FLASH_REC_HDR_SIZE + hdr->len;
 
-            /* First make a copy of existing page */
-            hret = HAL_FLASHEx_Erase( &erase, &page_error );
+            /* Records keep their sequence number, the CRC stays valid */
+            ret = flash_prog( bank + off, hdr, size );
 
-            if (( HAL_OK == hret ) && ( FLASH_PAGE_ERASE_OK == page_error ))
-            {
-                for ( i = 0; i < FLASH_PAGE_SIZE / 4; i++ )
-                {
-                    address = i << 2;
+            flash_idx[slot] = (uint16_t) off;
+            off            += size;
+        }
+    }
 
-                    hret |= HAL_FLASH_Program
-                                ( FLASH_TYPEPROGRAM_WORD
-                                , FLASH_COPY_PAGE_ADDR + address
-                                , *(uint32_t*)( FLASH_USER_PAGE_ADDR + address )
-                                );
-                }
+    if ( STATUS_OK == ret )
+    {
+        bank_hdr.magic = FLASH_LOG_MAGIC;
+        bank_hdr.seq   = flash_log.bank_seq + 1;
+
+        ret = flash_prog( bank, &bank_hdr, sizeof( bank_hdr ));
+    }
+
+    if ( STATUS_OK == ret )
+    {
+        flash_log.bank     = bank;
+        flash_log.bank_seq = bank_hdr.seq;
+        flash_log.head     = off;
+        flash_log.dirty    = FALSE;
+        flash_stats.compactions++;
+    }
+    else
+    {
+        /* Old bank is still the valid one, index has to point back to it */
+        flash_scan();
+    }
+
+    return ret;
+}
+
+/* Start bank 0 from the user page of the previous layout */
+static status_t flash_import( void )
+{
+    status_t         ret;
+    Flash_Bank_Hdr_t bank_hdr;
+    uint32_t         slot;
+    uint32_t         address;
+    uint32_t         len;
+
+    flash_log.bank     = FLASH_LOG_BANK0_ADDR;
+    flash_log.bank_seq = 0;
+    flash_log.rec_seq  = 0;
+    flash_log.head     = FLASH_BANK_HDR_SIZE;
+    flash_log.dirty    = FALSE;
+
+    memset( flash_idx, 0, sizeof( flash_idx ));
+
+    ret = flash_erase_bank( FLASH_LOG_BANK0_ADDR );
+
+    for ( slot = 0; ( slot < FLASH_SLOT_NUM ) && ( STATUS_OK == ret ); slot++ )
+    {
+        address = FLASH_USER_PAGE_ADDR + ( slot * FLASH_SLOT_SIZE );
+
+        /* Trailing erased words are not stored */
+        for ( len = FLASH_SLOT_SIZE; len > 0; len -= 4 )
+        {
+            if ( FLASH_PAGE_ERASE_OK != *(const uint32_t*)( address + len - 4 ))
+            {
+                break;
             }
-            else
+        }
+
+        if ( 0 != len )
+        {
+            ret = flash_append( (uint8_t) slot, (const void*) address, len );
+        }
+    }
+
+    if ( STATUS_OK == ret )
+    {
+        bank_hdr.magic = FLASH_LOG_MAGIC;
+        bank_hdr.seq   = 0;
+
+        ret = flash_prog( FLASH_LOG_BANK0_ADDR, &bank_hdr, sizeof( bank_hdr ));
+    }
+
+    return ret;
+}
+
+status_t flash_init( void )
+{
+    status_t ret = STATUS_OK;
+    uint32_t seq0;
+    uint32_t seq1;
+    bool_t   valid0;
+    bool_t   valid1;
+
+    valid0 = flash_bank_valid( FLASH_LOG_BANK0_ADDR, &seq0 );
+    valid1 = flash_bank_valid( FLASH_LOG_BANK1_ADDR, &seq1 );
+
+    if ( valid0 && (( !valid1 ) || flash_seq_newer( seq0, seq1 )))
+    {
+        flash_log.bank     = FLASH_LOG_BANK0_ADDR;
+        flash_log.bank_seq = seq0;
+    }
+    else if ( valid1 )
+    {
+        flash_log.bank     = FLASH_LOG_BANK1_ADDR;
+        flash_log.bank_seq = seq1;
+    }
+    else
+    {
+        HAL_FLASH_Unlock();
+        ret = flash_import();
+        HAL_FLASH_Lock();
+    }
+
+    if ( STATUS_OK == ret )
+    {
+        flash_scan();
+        flash_log.ready = TRUE;
+    }
+
+    return ret;
+}
+
+status_t flash_read( void* buff, uint32_t size, uint32_t offset )
+{
+    status_t               ret  = STATUS_ERROR;
+    uint8_t*               data = (uint8_t*) buff;
+    const Flash_Rec_Hdr_t* hdr;
+    uint32_t               slot;
+    uint32_t               pos;
+    uint32_t               n;
+    uint32_t               have;
+
+    if ( FALSE == flash_log.ready )
+    {
+        (void) flash_init();
+    }
+
+    if (( NULL != data ) && flash_log.ready
+     && (( offset + size ) <= FLASH_USER_SIZE ))
+    {
+        while ( size > 0 )
+        {
+            slot = offset / FLASH_SLOT_SIZE;
+            pos  = offset % FLASH_SLOT_SIZE;
+            n    = FLASH_SLOT_SIZE - pos;
+            n    = ( n > size ) ? size : n;
+            have = 0;
+
+            if ( 0 != flash_idx[slot] )
             {
-                hret = HAL_ERROR;
+                hdr  = (const Flash_Rec_Hdr_t*)( flash_log.bank
+                                               + flash_idx[slot]
+                                               );
+                have = ( hdr->len > pos ) ? ( hdr->len - pos ) : 0;
+                have = ( have > n ) ? n : have;
+
+                memcpy( data, (const uint8_t*)( hdr + 1 ) + pos, have );
             }
+
+            /* Never written bytes read as erased flash */
+            memset( data + have, 0xFF, n - have );
+
+            data   += n;
+            offset += n;
+            size   -= n;
         }
 
-        if ( HAL_OK == hret )
+        ret = STATUS_OK;
+    }
+
+    return ret;
+}
+
+status_t flash_write( void* buff, uint32_t size, uint32_t offset )
+{
+    status_t               ret  = STATUS_ERROR;
+    const uint8_t*         data = (const uint8_t*) buff;
+    const Flash_Rec_Hdr_t* hdr;
+    uint8_t                rec[FLASH_SLOT_SIZE];
+    uint32_t               slot;
+    uint32_t               pos;
+    uint32_t               n;
+    uint32_t               len;
+
+    if ( FALSE == flash_log.ready )
+    {
+        (void) flash_init();
+    }
+
+    if (( NULL != data ) && flash_log.ready
+     && (( offset + size ) <= FLASH_USER_SIZE )
+     && ( 0 == ( offset & 3 )) && ( 0 == ( size & 3 )))
+    {
+        ret = STATUS_OK;
+
+        HAL_FLASH_Unlock();
+
+        while (( size > 0 ) && ( STATUS_OK == ret ))
         {
-            /* Erase the user page */
-            erase.PageAddress = FLASH_USER_PAGE_ADDR;
+            slot = offset / FLASH_SLOT_SIZE;
+            pos  = offset % FLASH_SLOT_SIZE;
+            n    = FLASH_SLOT_SIZE - pos;
+            n    = ( n > size ) ? size : n;
+            len  = pos + n;
 
-            hret = HAL_FLASHEx_Erase( &erase, &page_error );
+            /* A record always holds the slot from its start */
+            memset( rec, 0xFF, sizeof( rec ));
 
-            if (( HAL_OK == hret ) && ( FLASH_PAGE_ERASE_OK == page_error ))
+            if ( 0 != flash_idx[slot] )
             {
-                for ( i = 0; i < ( offset / 4 ); i++ )
-                {
-                    address = i << 2;
+                hdr = (const Flash_Rec_Hdr_t*)( flash_log.bank
+                                              + flash_idx[slot]
+                                              );
+                len = ( hdr->len > len ) ? hdr->len : len;
 
-                    hret |= HAL_FLASH_Program
-                                ( FLASH_TYPEPROGRAM_WORD
-                                , FLASH_USER_PAGE_ADDR + address
-                                , *(uint32_t*)( FLASH_COPY_PAGE_ADDR + address )
-                                );
-                }
+                memcpy( rec, hdr + 1, hdr->len );
+            }
 
-                for ( i = 0; i < ( size / 4 ); i++ )
-                {
-                    address = offset + ( i << 2 );
+            /* Unchanged data costs no flash wear */
+            if (( 0 == flash_idx[slot] )
+             || ( 0 != memcmp( &rec[pos], data, n )))
+            {
+                memcpy( &rec[pos], data, n );
 
-                    hret |= HAL_FLASH_Program
-                                ( FLASH_TYPEPROGRAM_WORD
-                                , FLASH_USER_PAGE_ADDR + address
-                                , *(uint32_t*)( buff + ( i << 2 ))
-                                );
+                if ( flash_log.dirty
+                 || (( flash_log.head + FLASH_REC_HDR_SIZE + len )
+                        > FLASH_LOG_BANK_SIZE ))
+                {
+                    ret = flash_compact();
                 }
 
-                for ( i = 0;
-                      i < (( FLASH_PAGE_SIZE - size - offset ) / 4 );
-                      i++
-                    )
+                if ( STATUS_OK == ret )
                 {
-                    address = ( offset + size + ( i << 2 ));
-
-                    hret |= HAL_FLASH_Program
-                                ( FLASH_TYPEPROGRAM_WORD
-                                , FLASH_USER_PAGE_ADDR + address
-                                , *(uint32_t*)( FLASH_COPY_PAGE_ADDR + address )
-                                );
+                    ret = flash_append( (uint8_t) slot, rec, (uint8_t) len );
                 }
             }
+
+            data   += n;
+            offset += n;
+            size   -= n;
         }
 
         HAL_FLASH_Lock();
     }
 
-    if ( HAL_OK != hret )
+    return ret;
+}
+
+void flash_get_stats( Flash_Stats_t* stats )
+{
+    if ( NULL != stats )
     {
-        ret = STATUS_ERROR;
+        *stats          = flash_stats;
+        stats->bank_seq = flash_log.bank_seq;
+        stats->used     = flash_log.head;
     }
-
-    return ret;
 }
@@ -0,0 +1,670 @@
+/**
+ ** Name
+ **   hist.c
+ **
+ ** Purpose
+ **   Compressed measurement history in flash
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Period averages with a deadband, runtime period
+ **   18-Oct-2026 (SSB) [] Program entries as they fill, lazy erase
+ **/
+
+#include "hist.h"
+
+#include "adc.h"
+#include "crc.h"
+#include "event.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#define HIST_VARINT_MAX (5)     /* Bytes of a 32-bit varint */
+#define HIST_RUN_MAX    (3)     /* Bytes of a varint up to 0xFFFF */
+#define HIST_COUNT_MAX  (0xFFFF)
+#define HIST_CFG_MAGIC  ((uint32_t) 0x31464348) /* "HCF1" */
+#define HIST_SYNC_MS    ( 5UL * 60 * 1000 )     /* Longest run in RAM */
+
+/* Worst case entry, run and all channel deltas */
+#define HIST_ENTRY_MAX  ( HIST_RUN_MAX + ( HIST_CH_NUM * HIST_VARINT_MAX ))
+
+typedef struct
+{
+    Hist_Blk_Hdr_t hdr;
+    uint8_t        data[HIST_PAYLOAD_SIZE];
+} Hist_Blk_t;
+
+/* History configuration as stored in flash */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t period;        /* ms */
+} Hist_Cfg_t;
+
+/* Image of the open block. Its header goes to flash when the block opens
+ * (seq, time, boot, period) and closes (len, count, crc, magic), the
+ * payload half word by half word as it fills.
+ */
+static Hist_Blk_t   hist_blk;
+static int32_t      hist_prev[HIST_CH_NUM];
+static int32_t      hist_held[HIST_CH_NUM];  /* Last value past the deadband */
+static int64_t      hist_sum[HIST_CH_NUM];   /* Tick readings of the period */
+static uint32_t     hist_sum_cnt;
+static uint32_t     hist_run;           /* Repeats not yet in the payload */
+static uint32_t     hist_page;          /* Page the open block goes to */
+static uint32_t     hist_done;          /* Payload bytes in flash */
+static bool_t       hist_failed;        /* Open block lost a program */
+static uint32_t     hist_ms;            /* Time since the last sample */
+static uint32_t     hist_period = HIST_PERIOD_DEF_MS;
+static bool_t       hist_ready;
+static Hist_Stats_t hist_stats;
+
+static uint32_t hist_page_addr( uint32_t page )
+{
+    return HIST_ADDR + ( page * HIST_BLOCK_SIZE );
+}
+
+static uint16_t hist_crc( const Hist_Blk_Hdr_t* hdr, const uint8_t* data )
+{
+    uint16_t crc;
+
+    crc = crc16( CRC16_INIT, hdr, offsetof( Hist_Blk_Hdr_t, crc ));
+    crc = crc16( crc, data, hdr->len );
+
+    return crc;
+}
+
+/* Header of a valid block at page, NULL otherwise */
+static const Hist_Blk_Hdr_t* hist_page_blk( uint32_t page )
+{
+    const Hist_Blk_Hdr_t* ret = (const Hist_Blk_Hdr_t*) hist_page_addr( page );
+
+    if (( HIST_MAGIC != ret->magic )
+     || ( ret->len > HIST_PAYLOAD_SIZE )
+     || ( ret->crc != hist_crc( ret, (const uint8_t*)( ret + 1 ))))
+    {
+        ret = NULL;
+    }
+
+    return ret;
+}
+
+/* Program [offs, offs + size) of the block image to page, size even */
+static void hist_program( uint32_t page, uint32_t offs, uint32_t size )
+{
+    HAL_StatusTypeDef hret = HAL_OK;
+    const uint8_t*    src  = (const uint8_t*) &hist_blk;
+    uint32_t          i;
+
+    HAL_FLASH_Unlock();
+
+    for ( i = offs; ( i < ( offs + size )) && ( HAL_OK == hret ); i += 2 )
+    {
+        hret = HAL_FLASH_Program( FLASH_TYPEPROGRAM_HALFWORD
+                                , hist_page_addr( page ) + i
+                                , (uint16_t)( src[i] | ( src[i + 1] << 8 ))
+                                );
+    }
+
+    HAL_FLASH_Lock();
+
+    if ( HAL_OK != hret )
+    {
+        hist_stats.flash_errors++;
+        hist_failed = TRUE;
+    }
+}
+
+/* Header fields written when a block closes, magic last */
+static void hist_program_close( uint32_t page )
+{
+    hist_program( page, offsetof( Hist_Blk_Hdr_t, len ), sizeof( uint16_t ));
+    hist_program( page, offsetof( Hist_Blk_Hdr_t, count ), sizeof( uint16_t ));
+    hist_program( page, offsetof( Hist_Blk_Hdr_t, crc ), sizeof( uint16_t ));
+    hist_program( page, offsetof( Hist_Blk_Hdr_t, magic ), sizeof( uint16_t ));
+}
+
+/* Length of a varint at data, 0 if it does not end within size bytes */
+static uint32_t hist_varint_len( const uint8_t* data, uint32_t size )
+{
+    uint32_t ret = 0;
+    uint32_t i;
+
+    for ( i = 0; ( i < size ) && ( i < HIST_VARINT_MAX ); i++ )
+    {
+        if ( 0 == ( data[i] & 0x80 ))
+        {
+            ret = i + 1;
+            break;
+        }
+    }
+
+    return ret;
+}
+
+static uint32_t hist_get_varint( const uint8_t* data )
+{
+    uint32_t ret   = 0;
+    uint32_t shift = 0;
+
+    do
+    {
+        ret   |= (uint32_t)( *data & 0x7F ) << shift;
+        shift += 7;
+    } while ( 0 != ( *data++ & 0x80 ));
+
+    return ret;
+}
+
+/* Close a block left open by a power down. Its payload ends with the last
+ * complete entry, flash past the part entry after it has to be erased. The
+ * trailing run never made it to flash.
+ */
+static void hist_recover( uint32_t page )
+{
+    const Hist_Blk_Hdr_t* hdr   = (const Hist_Blk_Hdr_t*)
+                                  hist_page_addr( page );
+    const uint8_t*        data  = (const uint8_t*)( hdr + 1 );
+    uint32_t              len   = 0;
+    uint32_t              count = 0;
+    uint32_t              entry;
+    uint32_t              n;
+    uint32_t              i;
+
+    if (( 0xFFFF == hdr->magic ) && ( 0xFFFF == hdr->len )
+     && ( 0xFFFF == hdr->count ) && ( 0xFFFF == hdr->crc )
+     && ( 0xFFFFFFFF != hdr->seq ))
+    {
+        do
+        {
+            entry = 0;
+
+            for ( n = 0; n <= HIST_CH_NUM; n++ )
+            {
+                i      = hist_varint_len( &data[len + entry]
+                                        , HIST_PAYLOAD_SIZE - len - entry
+                                        );
+                entry += i;
+
+                if ( 0 == i )
+                {
+                    entry = 0;
+                    break;
+                }
+            }
+
+            if ( 0 != entry )
+            {
+                count += hist_get_varint( &data[len] ) + 1;
+                len   += entry;
+            }
+        } while (( 0 != entry ) && ( count < HIST_COUNT_MAX ));
+
+        for ( i = len + HIST_ENTRY_MAX; i < HIST_PAYLOAD_SIZE; i++ )
+        {
+            if ( 0xFF != data[i] )
+            {
+                count = 0;
+                break;
+            }
+        }
+
+        if ( 0 != count )
+        {
+            hist_blk.hdr       = *hdr;
+            hist_blk.hdr.magic = HIST_MAGIC;
+            hist_blk.hdr.len   = (uint16_t) len;
+            hist_blk.hdr.count = (uint16_t) count;
+            hist_blk.hdr.crc   = hist_crc( &hist_blk.hdr, data );
+
+            hist_program_close( page );
+        }
+    }
+}
+
+static uint32_t hist_put_varint( uint8_t* data, uint32_t val )
+{
+    uint32_t len = 0;
+
+    while ( val >= 0x80 )
+    {
+        data[len++] = (uint8_t)( val | 0x80 );
+        val       >>= 7;
+    }
+
+    data[len++] = (uint8_t) val;
+
+    return len;
+}
+
+/* Small deltas of either sign map to small unsigned values */
+static uint32_t hist_zigzag( int32_t val )
+{
+    return ((uint32_t) val << 1 ) ^ (uint32_t)( val >> 31 );
+}
+
+static const int32_t hist_db[HIST_CH_NUM] =
+{
+    HIST_DB_MV,
+    HIST_DB_MA,
+    HIST_DB_MW
+};
+
+/* Period mean, held while it stays within the deadband of the last value
+ * that left it
+ */
+static void hist_filter( int32_t* sample )
+{
+    int32_t  db;
+    int32_t  diff;
+    uint32_t ch;
+
+    for ( ch = 0; ch < HIST_CH_NUM; ch++ )
+    {
+        sample[ch]   = (int32_t)( hist_sum[ch] / (int32_t) hist_sum_cnt );
+        hist_sum[ch] = 0;
+
+        db   = hist_held[ch] >> HIST_DB_REL;
+        db   = ( db < 0 ) ? -db : db;
+        db   = ( db > hist_db[ch] ) ? db : hist_db[ch];
+        diff = sample[ch] - hist_held[ch];
+
+        if (( diff > db ) || ( diff < -db ))
+        {
+            hist_held[ch] = sample[ch];
+        }
+
+        sample[ch] = hist_held[ch];
+    }
+
+    hist_sum_cnt = 0;
+}
+
+static void hist_blk_reset( void )
+{
+    memset( &hist_blk.hdr, 0, sizeof( hist_blk.hdr ));
+    memset( hist_prev, 0, sizeof( hist_prev ));
+    hist_run = 0;
+}
+
+static void hist_erase( void )
+{
+    FLASH_EraseInitTypeDef erase = {0};
+    const Hist_Blk_Hdr_t*  old;
+    const uint32_t*        word;
+    uint32_t               page_error;
+    uint32_t               i;
+
+    old = hist_page_blk( hist_page );
+
+    if ( NULL != old )
+    {
+        hist_stats.blocks  -= 1;
+        hist_stats.samples -= old->count;
+    }
+
+    /* Skip the erase cycle on a blank page */
+    word = (const uint32_t*) hist_page_addr( hist_page );
+
+    for ( i = 0; i < ( HIST_BLOCK_SIZE / 4 ); i++ )
+    {
+        if ( FLASH_PAGE_ERASE_OK != word[i] )
+        {
+            break;
+        }
+    }
+
+    if ( i < ( HIST_BLOCK_SIZE / 4 ))
+    {
+        erase.TypeErase   = FLASH_TYPEERASE_PAGES;
+        erase.PageAddress = hist_page_addr( hist_page );
+        erase.NbPages     = 1;
+
+        HAL_FLASH_Unlock();
+
+        if (( HAL_OK != HAL_FLASHEx_Erase( &erase, &page_error ))
+         || ( FLASH_PAGE_ERASE_OK != page_error ))
+        {
+            hist_stats.flash_errors++;
+            hist_failed = TRUE;
+        }
+
+        HAL_FLASH_Lock();
+    }
+}
+
+/* Erase the page of the new block and write what is known of its header */
+static void hist_open( void )
+{
+    Time_t now;
+
+    hist_failed = FALSE;
+    hist_erase();
+
+    get_time( &now );
+    hist_blk.hdr.time   = now;
+    hist_blk.hdr.seq    = hist_stats.seq;
+    hist_blk.hdr.boot   = hist_stats.boot;
+    hist_blk.hdr.period = (uint16_t) hist_period;
+    hist_done           = 0;
+
+    hist_program( hist_page
+                , offsetof( Hist_Blk_Hdr_t, seq )
+                , offsetof( Hist_Blk_Hdr_t, count )
+                - offsetof( Hist_Blk_Hdr_t, seq )
+                );
+    hist_program( hist_page
+                , offsetof( Hist_Blk_Hdr_t, period )
+                , sizeof( uint16_t )
+                );
+}
+
+/* Program the payload half words up to end not yet in flash */
+static void hist_flush( uint32_t end )
+{
+    uint32_t size = ( end - hist_done ) & ~1UL;
+
+    if ( 0 != size )
+    {
+        hist_program( hist_page, sizeof( Hist_Blk_Hdr_t ) + hist_done, size );
+        hist_done += size;
+    }
+}
+
+/* Finish the open block and move on to the next page */
+static void hist_close( void )
+{
+    uint32_t end;
+
+    if ( 0 != hist_run )
+    {
+        hist_blk.hdr.len += hist_put_varint( &hist_blk.data[hist_blk.hdr.len]
+                                           , hist_run
+                                           );
+    }
+
+    /* The last half word padded like erased flash */
+    end = ( hist_blk.hdr.len + 1 ) & ~1UL;
+    memset( &hist_blk.data[hist_blk.hdr.len], 0xFF, end - hist_blk.hdr.len );
+    hist_flush( end );
+
+    hist_blk.hdr.magic = HIST_MAGIC;
+    hist_blk.hdr.crc   = hist_crc( &hist_blk.hdr, hist_blk.data );
+
+    hist_program_close( hist_page );
+
+    if ( !hist_failed )
+    {
+        hist_stats.blocks++;
+    }
+    else
+    {
+        hist_stats.samples -= hist_blk.hdr.count;
+    }
+
+    hist_stats.seq++;
+    hist_page = ( hist_page + 1 ) % HIST_PAGES;
+
+    hist_blk_reset();
+}
+
+static void hist_add( const int32_t* sample )
+{
+    uint32_t zz[HIST_CH_NUM];
+    uint32_t ch;
+    bool_t   same = TRUE;
+
+    /* Room for a worst case entry and the closing run */
+    if (( HIST_COUNT_MAX == hist_blk.hdr.count )
+     || (((uint32_t) hist_blk.hdr.len + HIST_ENTRY_MAX + HIST_RUN_MAX )
+            > HIST_PAYLOAD_SIZE ))
+    {
+        hist_close();
+    }
+
+    for ( ch = 0; ch < HIST_CH_NUM; ch++ )
+    {
+        zz[ch] = hist_zigzag( sample[ch] - hist_prev[ch] );
+        same   = ( 0 != zz[ch] ) ? FALSE : same;
+    }
+
+    if ( 0 == hist_blk.hdr.count )
+    {
+        hist_open();
+        same = FALSE;
+    }
+
+    /* A long run goes out as a repeat of the previous sample. A power down
+     * loses the run and the entry before it, at most 2 * HIST_SYNC_MS.
+     */
+    if ( same && ((( hist_run + 1 ) * hist_period ) < HIST_SYNC_MS ))
+    {
+        hist_run++;
+    }
+    else if ( same )
+    {
+        hist_blk.hdr.len += hist_put_varint( &hist_blk.data[hist_blk.hdr.len]
+                                           , hist_run
+                                           );
+
+        for ( ch = 0; ch < HIST_CH_NUM; ch++ )
+        {
+            hist_blk.data[hist_blk.hdr.len++] = 0;
+        }
+
+        hist_run = 0;
+    }
+    else
+    {
+        hist_blk.hdr.len += hist_put_varint( &hist_blk.data[hist_blk.hdr.len]
+                                           , hist_run
+                                           );
+
+        for ( ch = 0; ch < HIST_CH_NUM; ch++ )
+        {
+            hist_blk.hdr.len += hist_put_varint
+                                    ( &hist_blk.data[hist_blk.hdr.len]
+                                    , zz[ch]
+                                    );
+            hist_prev[ch] = sample[ch];
+        }
+
+        hist_run = 0;
+    }
+
+    hist_blk.hdr.count++;
+    hist_stats.samples++;
+
+    hist_flush( hist_blk.hdr.len );
+}
+
+static bool_t hist_period_valid( uint32_t period )
+{
+    return (( period >= EVENT_TICK_MS )
+         && ( period <= HIST_PERIOD_MAX_MS )
+         && ( 0 == ( period % EVENT_TICK_MS ))) ? TRUE : FALSE;
+}
+
+status_t hist_init( void )
+{
+    const Hist_Blk_Hdr_t* blk;
+    const Hist_Blk_Hdr_t* newest = NULL;
+    Hist_Cfg_t            cfg;
+    uint32_t              page;
+
+    memset( &hist_stats, 0, sizeof( hist_stats ));
+
+    if (( STATUS_OK == flash_read( &cfg, sizeof( cfg ), FLASH_OFFS_HIST_CFG ))
+     && ( HIST_CFG_MAGIC == cfg.magic )
+     && hist_period_valid( cfg.period ))
+    {
+        hist_period = cfg.period;
+    }
+    hist_page = 0;
+
+    for ( page = 0; page < HIST_PAGES; page++ )
+    {
+        blk = hist_page_blk( page );
+
+        if ( NULL == blk )
+        {
+            hist_recover( page );
+            blk = hist_page_blk( page );
+        }
+
+        if ( NULL != blk )
+        {
+            hist_stats.blocks++;
+            hist_stats.samples += blk->count;
+
+            if (( NULL == newest )
+             || ((int32_t)( blk->seq - newest->seq ) > 0 ))
+            {
+                newest    = blk;
+                hist_page = ( page + 1 ) % HIST_PAGES;
+            }
+        }
+    }
+
+    if ( NULL != newest )
+    {
+        hist_stats.seq  = newest->seq + 1;
+        hist_stats.boot = newest->boot + 1;
+    }
+
+    hist_blk_reset();
+    memset( hist_held, 0, sizeof( hist_held ));
+    memset( hist_sum, 0, sizeof( hist_sum ));
+    hist_sum_cnt = 0;
+    hist_ms      = 0;
+    hist_ready   = TRUE;
+
+    return STATUS_OK;
+}
+
+void hist_tick( void )
+{
+    Adc_Power_t power;
+    int32_t     sample[HIST_CH_NUM];
+
+    if ( hist_ready )
+    {
+        adc_get_power( &power );
+
+        hist_sum[0] += (int32_t) adc_get_milli( ADC_CH_V );
+        hist_sum[1] += (int32_t) adc_get_milli( ADC_CH_I );
+        hist_sum[2] += power.p;
+        hist_sum_cnt++;
+
+        hist_ms += EVENT_TICK_MS;
+
+        if ( hist_ms >= hist_period )
+        {
+            hist_ms -= hist_period;
+
+            hist_filter( sample );
+            hist_add( sample );
+        }
+    }
+}
+
+static bool_t hist_in_range( const Hist_Blk_Hdr_t* hdr
+                           , uint32_t              from
+                           , uint32_t              to
+                           )
+{
+    uint32_t start;
+    uint32_t end;
+
+    start = (uint32_t)( hdr->time / 1000000 );
+    end   = start + (uint32_t)(((uint64_t) hdr->count * hdr->period ) / 1000 );
+
+    return (( start <= to ) && ( end >= from )) ? TRUE : FALSE;
+}
+
+uint32_t hist_dump( uint32_t from, uint32_t to, Hist_Out_t out )
+{
+    const Hist_Blk_Hdr_t* blk;
+    Hist_Blk_Hdr_t        hdr;
+    uint32_t              ret = 0;
+    uint32_t              n;
+    uint32_t              page;
+
+    /* Oldest first, the page after the open block holds the oldest one */
+    for ( n = 1; n <= HIST_PAGES; n++ )
+    {
+        page = ( hist_page + n ) % HIST_PAGES;
+        blk  = hist_page_blk( page );
+
+        if (( NULL != blk ) && hist_in_range( blk, from, to ))
+        {
+            out( blk, (const uint8_t*)( blk + 1 ));
+            ret++;
+        }
+    }
+
+    if ( 0 != hist_blk.hdr.count )
+    {
+        /* Closing run goes to the reserved space, the open block keeps it
+         * pending.
+         */
+        hdr     = hist_blk.hdr;
+        hdr.len = hdr.len + (( 0 != hist_run )
+                             ? hist_put_varint( &hist_blk.data[hdr.len]
+                                              , hist_run
+                                              )
+                             : 0 );
+
+        hdr.magic  = HIST_MAGIC;
+        hdr.seq    = hist_stats.seq;
+        hdr.boot   = hist_stats.boot;
+        hdr.period = (uint16_t) hist_period;
+        hdr.crc    = hist_crc( &hdr, hist_blk.data );
+
+        if ( hist_in_range( &hdr, from, to ))
+        {
+            out( &hdr, hist_blk.data );
+            ret++;
+        }
+    }
+
+    return ret;
+}
+
+void hist_get_stats( Hist_Stats_t* stats )
+{
+    *stats            = hist_stats;
+    stats->open_bytes = hist_blk.hdr.len;
+}
+
+status_t hist_set_period( uint32_t period )
+{
+    status_t   ret = STATUS_ERROR;
+    Hist_Cfg_t cfg;
+
+    if ( hist_period_valid( period ))
+    {
+        if ( 0 != hist_blk.hdr.count )
+        {
+            hist_close();
+        }
+
+        memset( hist_sum, 0, sizeof( hist_sum ));
+        hist_sum_cnt = 0;
+        hist_ms      = 0;
+        hist_period  = period;
+
+        cfg.magic  = HIST_CFG_MAGIC;
+        cfg.period = period;
+
+        ret = flash_write( &cfg, sizeof( cfg ), FLASH_OFFS_HIST_CFG );
+    }
+
+    return ret;
+}
+
+uint32_t hist_get_period( void )
+{
+    return hist_period;
+}
@@ -0,0 +1,82 @@
+/**
+ ** Name
+ **   imath.c
+ **
+ ** Purpose
+ **   Integer math routines
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "imath.h"
+
+/* Both roots use the digit-by-digit method, one result bit per iteration,
+ * no divisions and no FPU.
+ */
+uint16_t isqrt32( uint32_t x )
+{
+    uint32_t res = 0;
+    uint32_t bit = (uint32_t) 1 << 30;
+
+    while ( bit > x )
+    {
+        bit >>= 2;
+    }
+
+    while ( 0 != bit )
+    {
+        if ( x >= ( res + bit ))
+        {
+            x   -= res + bit;
+            res  = ( res >> 1 ) + bit;
+        }
+        else
+        {
+            res >>= 1;
+        }
+
+        bit >>= 2;
+    }
+
+    return (uint16_t) res;
+}
+
+uint32_t isqrt64( uint64_t x )
+{
+    uint32_t ret;
+    uint64_t res = 0;
+    uint64_t bit = (uint64_t) 1 << 62;
+
+    if ( x <= 0xFFFFFFFFu )
+    {
+        /* Stay in 32-bit arithmetic whenever possible */
+        ret = isqrt32( (uint32_t) x );
+    }
+    else
+    {
+        while ( bit > x )
+        {
+            bit >>= 2;
+        }
+
+        while ( 0 != bit )
+        {
+            if ( x >= ( res + bit ))
+            {
+                x   -= res + bit;
+                res  = ( res >> 1 ) + bit;
+            }
+            else
+            {
+                res >>= 1;
+            }
+
+            bit >>= 2;
+        }
+
+        ret = (uint32_t) res;
+    }
+
+    return ret;
+}
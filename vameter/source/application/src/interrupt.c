@@ -7,12 +7,19 @@
  **
  ** Revision
  **   10-Oct-2020 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Add UART receive DMA channels
+ **   18-Oct-2026 (SSB) [] Add UART transmit DMA channels
+ **   18-Oct-2026 (SSB) [] Share DMA1 CH5 with PCD8544
+ **   18-Oct-2026 (SSB) [] Add 7-segment multiplex timer
  **/
 
 #include "interrupt.h"
 
 #include "adc.h"
+#include "display.h"
+#include "pcd8544.h"
 #include "tim.h"
+#include "uart.h"
 
 void NMI_Handler( void )
 {
@@ -59,6 +66,11 @@ void TIM2_IRQHandler( void )
     bsp_tmr_slave_irq_hdl();
 }
 
+void TIM4_IRQHandler( void )
+{
+    display_tmr_irq_hdl();
+}
+
 void TIM7_IRQHandler( void )
 {
     tmr_ms_irq_hdl();
@@ -68,3 +80,27 @@ void DMA1_Channel1_IRQHandler( void )
 {
     dma1_ch1_irq_hdl();
 }
+
+void DMA1_Channel4_IRQHandler( void )
+{
+    dma1_ch4_irq_hdl();
+}
+
+void DMA1_Channel5_IRQHandler( void )
+{
+#if ( PCD8544_DMA_ENABLED != 0 )
+    pcd8544_dma_irq_hdl();
+#else
+    dma1_ch5_irq_hdl();
+#endif
+}
+
+void DMA1_Channel6_IRQHandler( void )
+{
+    dma1_ch6_irq_hdl();
+}
+
+void DMA1_Channel7_IRQHandler( void )
+{
+    dma1_ch7_irq_hdl();
+}
@@ -7,6 +7,18 @@
  **
  ** Revision
  **   10-Oct-2020 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Initialize RMS window statistics
+ **   18-Oct-2026 (SSB) [] Measurement configuration from flash
+ **   18-Oct-2026 (SSB) [] Restore energy total
+ **   18-Oct-2026 (SSB) [] DMA half hand over by sequence number
+ **   18-Oct-2026 (SSB) [] Event driven main loop
+ **   18-Oct-2026 (SSB) [] Show voltage and current on the 7-segment displays
+ **   18-Oct-2026 (SSB) [] Settings log index built at boot
+ **   18-Oct-2026 (SSB) [] Measurement history
+ **   18-Oct-2026 (SSB) [] CLI next to the measurement, no CLI mode
+ **   18-Oct-2026 (SSB) [] Profiling
+ **   18-Oct-2026 (SSB) [] Event trace
+ **   18-Oct-2026 (SSB) [] ADC calibration from flash
  **/
 
 #include "main.h"
@@ -14,15 +26,45 @@
 #include "adc.h"
 #include "cli.h"
 #include "display.h"
+#include "event.h"
+#include "flash.h"
 #include "gpio.h"
+#include "hist.h"
+#include "prof.h"
 #include "ptypes.h"
 #include "tim.h"
+#include "trace.h"
 #include "uart.h"
 #include "state_machine.h"
 #include "system_init.h"
 
 #include <stdio.h>
 
+#if ( DISPLAY_ENABLED != 0 )
+/* Voltage on display 1 and current on display 2, in V and A */
+static void display_show_meas( void )
+{
+    PROF_BEGIN( PROF_DISP_SHOW );
+
+    (void) display_put_milli( 0, (int32_t) adc_get_milli( ADC_CH_V ));
+    (void) display_put_milli( 1, (int32_t) adc_get_milli( ADC_CH_I ));
+
+    PROF_END( PROF_DISP_SHOW );
+}
+#endif
+
+/* Periodic work of the measurement mode */
+static void main_tick( void )
+{
+#if ( DISPLAY_ENABLED != 0 )
+    display_show_meas();
+#endif
+
+#if ( HIST_ENABLED != 0 )
+    hist_tick();
+#endif
+}
+
 static void critical_error_handler( void )
 {
     sm_set_state( STATE_MACHINE_ERROR );
@@ -33,12 +75,12 @@ static void critical_error_handler( void )
 int main( void )
 {
     status_t  ret;
-    Adc_Rms_t rms[2] = {0};
-    bool_t    rms_start_calc;
 
     system_clk_cfg();
     HAL_Init();
     gpio_init();
+    prof_init();
+    trace_start();
 
     ret  = tmr_bsp_init();
     ret |= tmr_ms_init();
@@ -73,54 +115,42 @@ int main( void )
         critical_error_handler();
     }
 
-    GPIO_PinState user_pb_state;
+    /* DC mode over 128 samples or AC mode over whole mains periods,
+     * selected by the "meas" CLI commands. Falls back to defaults when the
+     * flash user page holds no valid configuration.
+     */
+    (void) flash_init();
+    (void) adc_cfg_load();
+    (void) adc_cal_load();
+    (void) adc_energy_load();
+
+#if ( HIST_ENABLED != 0 )
+    (void) hist_init();
+#endif
+
+    ret  = adc_init();
+    ret |= adc_start();
 
-    /* Since PB is manually pressed during the power-on cycle there is no need
-     * for full debouncing or usage of interrupt routine to read the state.
+#if ( DISPLAY_ENABLED != 0 )
+    ret |= display_init();
+#endif
+
+    /* Commands are assembled from receive events and run between half
+     * buffers, the measurement never stops for the CLI.
      */
-    user_pb_state = HAL_GPIO_ReadPin( CLI_PB_PORT, CLI_PB_PIN );
+    cli_init();
 
-    if ( GPIO_PIN_RESET == user_pb_state )
-    {
-        /* Do a primitive debouncing */
-        wait( 75, TIME_MSEC );
-
-        if ( GPIO_PIN_RESET == user_pb_state )
-        {
-            printf( "Info: Command Line Interface loaded.\r\n\r\n" );
-            sm_set_state( STATE_MACHINE_CLI );
-            cli_process();
-        }
-    }
-    else
-    {
-        ret  = adc_init();
-        ret |= adc_start();
-    }
+    event_register( EVENT_TICK, main_tick );
+    event_register( EVENT_UART1_RX, cli_process );
 
     if ( STATUS_OK != ret )
     {
         critical_error_handler();
     }
 
-    /* Evaluate RMS over 128 collected samples.
-     * As we are sensing the DC only the number of samples in choosen random.
-     * For the AC sensing, an exact number of samples has to be provided.
-     * Current ADC configuration samples at 2,4 KS/s.
-     */
-    rms[0].req_samples = 128;
-    rms[1].req_samples = 128;
-
-    for(;;)
-    {
-        rms_start_calc = adc_get_rms_flag();
-
-        if ( FALSE != rms_start_calc )
-        {
-            adc_calc_rms( rms );
-            adc_set_rms_flag( FALSE );
-        }
-    }
+    /* Sleeps between events, see event_loop() */
+    event_register( EVENT_ADC, adc_calc_rms );
+    event_loop();
 
     return 0;
 }
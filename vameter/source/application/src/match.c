@@ -0,0 +1,180 @@
+/**
+ ** Name
+ **   match.c
+ **
+ ** Purpose
+ **   Streaming multi-pattern matcher (Aho-Corasick)
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "match.h"
+
+#include <string.h>
+
+static uint8_t match_goto( const Match_t* match, uint8_t node, uint8_t ch )
+{
+    uint8_t ret = match->node[node].child;
+
+    while (( 0 != ret ) && ( ch != match->node[ret].ch ))
+    {
+        ret = match->node[ret].next;
+    }
+
+    return ret;
+}
+
+static status_t match_add( Match_t*       match
+                         , const uint8_t* pat
+                         , uint8_t        len
+                         , uint8_t        id
+                         )
+{
+    status_t ret  = STATUS_OK;
+    uint8_t  node = 0;
+    uint8_t  next;
+    uint8_t  i;
+
+    for ( i = 0; ( i < len ) && ( STATUS_OK == ret ); i++ )
+    {
+        next = match_goto( match, node, pat[i] );
+
+        if ( 0 == next )
+        {
+            if ( match->nodes < MATCH_NODE_MAX )
+            {
+                next = match->nodes++;
+
+                match->node[next].ch    = pat[i];
+                match->node[next].next  = match->node[node].child;
+                match->node[node].child = next;
+            }
+            else
+            {
+                ret = STATUS_ERROR;
+            }
+        }
+
+        node = next;
+    }
+
+    /* Same pattern twice keeps the first id */
+    if (( STATUS_OK == ret ) && ( 0 == match->node[node].out ))
+    {
+        match->node[node].out = id + 1;
+    }
+
+    return ret;
+}
+
+/* Fail links breadth first, a node's link is shallower than the node. A
+ * node without own pattern reports the one of its fail link, the longest
+ * pattern that is a suffix of it.
+ */
+static void match_link( Match_t* match )
+{
+    uint8_t queue[MATCH_NODE_MAX];
+    uint8_t head = 0;
+    uint8_t tail = 0;
+    uint8_t node;
+    uint8_t child;
+    uint8_t fail;
+
+    for ( child = match->node[0].child; 0 != child
+        ; child = match->node[child].next )
+    {
+        match->node[child].fail = 0;
+        queue[tail++]           = child;
+    }
+
+    while ( head != tail )
+    {
+        node = queue[head++];
+
+        for ( child = match->node[node].child; 0 != child
+            ; child = match->node[child].next )
+        {
+            fail = match->node[node].fail;
+
+            while (( 0 != fail )
+                && ( 0 == match_goto( match, fail, match->node[child].ch )))
+            {
+                fail = match->node[fail].fail;
+            }
+
+            match->node[child].fail = match_goto( match
+                                                , fail
+                                                , match->node[child].ch
+                                                );
+
+            if ( 0 == match->node[child].out )
+            {
+                match->node[child].out
+                    = match->node[match->node[child].fail].out;
+            }
+
+            queue[tail++] = child;
+        }
+    }
+}
+
+status_t match_init( Match_t*           match
+                   , const void* const* pat
+                   , const uint8_t*     len
+                   , uint8_t            num
+                   )
+{
+    status_t ret = STATUS_ERROR;
+    uint8_t  i;
+
+    if (( NULL != match ) && ( num > 0 ) && ( num <= MATCH_PAT_MAX ))
+    {
+        memset( match, 0, sizeof( Match_t ));
+
+        match->nodes = 1;
+        ret          = STATUS_OK;
+
+        for ( i = 0; ( i < num ) && ( STATUS_OK == ret ); i++ )
+        {
+            if ( 0 == len[i] )
+            {
+                ret = STATUS_ERROR;
+            }
+            else
+            {
+                match->len[i] = len[i];
+                ret = match_add( match, (const uint8_t*) pat[i], len[i], i );
+            }
+        }
+
+        match_link( match );
+        match_reset( match );
+    }
+
+    return ret;
+}
+
+void match_reset( Match_t* match )
+{
+    match->state  = 0;
+    match->hit_id = -1;
+}
+
+int8_t match_step( Match_t* match, uint8_t ch )
+{
+    uint8_t state = match->state;
+    uint8_t next;
+
+    next = match_goto( match, state, ch );
+
+    while (( 0 == next ) && ( 0 != state ))
+    {
+        state = match->node[state].fail;
+        next  = match_goto( match, state, ch );
+    }
+
+    match->state = next;
+
+    return (int8_t) match->node[next].out - 1;
+}
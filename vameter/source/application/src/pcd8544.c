@@ -7,16 +7,23 @@
  **
  ** Revision
  **   26-Oct-2020 (SB) [] Initial
+ **   18-Oct-2026 (SSB) [] DMA burst refresh
+ **   18-Oct-2026 (SSB) [] Column blit text rendering
+ **   18-Oct-2026 (SSB) [] Dirty column span per page
  **/
 
 #include "pcd8544.h"
 
+#include "tim.h"
+#include "uart.h"
+
 #include <stm32f1xx_hal.h>
 
-#define PCD8544_SPI_TIMEOUT ((uint16_t)1)
+#if ( PCD8544_DMA_ENABLED != 0 ) && ( UART1_RX_DMA_ENABLED != 0 )
+    #error "DMA1 CH5 is used by both PCD8544 refresh and USART1 receive"
+#endif
 
-#define PCD8544_WIDTH  84
-#define PCD8544_HEIGHT 48
+#define PCD8544_SPI_TIMEOUT ((uint16_t)1)
 
 /* General commands */
 #define PCD8544_POWERDOWN           0x04
@@ -41,6 +48,7 @@
 #define PCD8544_CHAR_3X5_WIDTH      4 /* 3x5 */
 #define PCD8544_CHAR_3X5_HEIGHT     6
 #define PCD8544_BUFF_SIZE           PCD8544_WIDTH * PCD8544_HEIGHT / 8
+#define PCD8544_PAGES               ( PCD8544_HEIGHT / 8 )
 
 typedef enum
 {
@@ -48,15 +56,48 @@ typedef enum
     PCD8544_WRITE_DATA
 } PCD8544_Write_t;
 
+/* Dirty column span of one page, clean while x_min > x_max */
+typedef struct
+{
+    uint8_t x_min;
+    uint8_t x_max;
+} PCD8544_Span_t;
+
+/* Inclusive pixel area, empty while x_min > x_max */
+typedef struct
+{
+    uint8_t x_min;
+    uint8_t x_max;
+    uint8_t y_min;
+    uint8_t y_max;
+} PCD8544_Area_t;
+
 static SPI_HandleTypeDef spi_hdl;
 
-static uint8_t pcd8544_buff[PCD8544_BUFF_SIZE];
-static uint8_t pcd8544_update_x_min;
-static uint8_t pcd8544_update_x_max;
-static uint8_t pcd8544_update_y_min;
-static uint8_t pcd8544_update_y_max;
-static uint8_t pcd8544_x;
-static uint8_t pcd8544_y;
+static uint8_t        pcd8544_buff[PCD8544_BUFF_SIZE];
+static PCD8544_Span_t pcd8544_dirty[PCD8544_PAGES];
+static uint8_t        pcd8544_x;
+static uint8_t        pcd8544_y;
+
+static PCD8544_Stats_t pcd8544_stats;
+
+#if ( PCD8544_DMA_ENABLED != 0 )
+/* Refresh in flight, owned by the DMA interrupt until busy is cleared.
+ * The dirty spans are latched at start so drawing may continue meanwhile.
+ */
+typedef struct
+{
+    volatile bool_t   busy;
+    uint8_t           page;                  /* Page being transferred */
+    PCD8544_Span_t    span[PCD8544_PAGES];   /* Latched dirty spans */
+    uint16_t          bytes;                 /* Bytes of this refresh */
+    Time_t            start;
+    PCD8544_Done_Cb_t done;
+} PCD8544_Xfer_t;
+
+static DMA_HandleTypeDef pcd8544_dma = { .Instance = DMA1_Channel5 };
+static PCD8544_Xfer_t    pcd8544_xfer;
+#endif
 
 static const uint8_t font_5x7 [97][PCD8544_CHAR_5X7_WIDTH] =
 {
@@ -350,6 +391,13 @@ static status_t pcd8544_write( PCD8544_Write_t cd, uint8_t data )
 {
     status_t ret = STATUS_OK;
 
+#if ( PCD8544_DMA_ENABLED != 0 )
+    /* D/C and CS belong to the running refresh */
+    while ( FALSE != pcd8544_xfer.busy )
+    {
+    }
+#endif
+
     switch ( cd )
     {
         case PCD8544_WRITE_DATA:
@@ -371,6 +419,192 @@ static status_t pcd8544_write( PCD8544_Write_t cd, uint8_t data )
     return ret;
 }
 
+/* Move the dirty spans to span and mark all pages clean, returns the
+ * number of bytes the refresh puts on the wire.
+ */
+static uint16_t pcd8544_dirty_take( PCD8544_Span_t* span )
+{
+    uint16_t bytes = 0;
+    uint8_t  i;
+
+    for ( i = 0; i < PCD8544_PAGES; i++ )
+    {
+        span[i] = pcd8544_dirty[i];
+
+        if ( span[i].x_min <= span[i].x_max )
+        {
+            /* Y and X address commands, then the data run */
+            bytes += 2 + span[i].x_max - span[i].x_min + 1;
+        }
+
+        pcd8544_dirty[i].x_min = PCD8544_WIDTH - 1;
+        pcd8544_dirty[i].x_max = 0;
+    }
+
+    return bytes;
+}
+
+static void pcd8544_refresh_done( Time_t start, uint16_t bytes )
+{
+    Time_t   now;
+    uint32_t elapsed;
+
+    get_time( &now );
+    elapsed = (uint32_t)( now - start );
+
+    pcd8544_stats.refreshes++;
+    pcd8544_stats.time_last    = elapsed;
+    pcd8544_stats.bytes_last   = bytes;
+    pcd8544_stats.bytes_total += bytes;
+
+    if ( elapsed > pcd8544_stats.time_max )
+    {
+        pcd8544_stats.time_max = elapsed;
+    }
+}
+
+#if ( PCD8544_DMA_ENABLED != 0 )
+/* Shift out one command byte while CS is held, D/C has to be low */
+static void pcd8544_spi_put_cmd( uint8_t cmd )
+{
+    while ( 0 == ( PCD8544_SPI->SR & SPI_SR_TXE ))
+    {
+    }
+
+    PCD8544_SPI->DR = cmd;
+
+    while ( 0 == ( PCD8544_SPI->SR & SPI_SR_TXE ))
+    {
+    }
+    while ( 0 != ( PCD8544_SPI->SR & SPI_SR_BSY ))
+    {
+    }
+}
+
+/* Address the next dirty page from page on and stream its column span,
+ * fails when no dirty page is left.
+ */
+static status_t pcd8544_dma_page_start( uint8_t page )
+{
+    status_t          ret = STATUS_ERROR;
+    HAL_StatusTypeDef hret;
+    PCD8544_Span_t*   span;
+
+    while (( page < PCD8544_PAGES )
+        && ( pcd8544_xfer.span[page].x_min > pcd8544_xfer.span[page].x_max ))
+    {
+        page++;
+    }
+
+    if ( page < PCD8544_PAGES )
+    {
+        span              = &pcd8544_xfer.span[page];
+        pcd8544_xfer.page = page;
+
+        HAL_GPIO_WritePin( PCD8544_DC_PORT, PCD8544_DC_PIN, GPIO_PIN_RESET );
+        pcd8544_spi_put_cmd( PCD8544_SETYADDR | page );
+        pcd8544_spi_put_cmd( PCD8544_SETXADDR | span->x_min );
+        HAL_GPIO_WritePin( PCD8544_DC_PORT, PCD8544_DC_PIN, GPIO_PIN_SET );
+
+        hret = HAL_DMA_Start_IT
+                    ( &pcd8544_dma
+                    , (uint32_t) &pcd8544_buff[( page * PCD8544_WIDTH )
+                                               + span->x_min]
+                    , (uint32_t) &PCD8544_SPI->DR
+                    , span->x_max - span->x_min + 1
+                    );
+
+        if ( HAL_OK == hret )
+        {
+            ret = STATUS_OK;
+        }
+    }
+
+    return ret;
+}
+
+static void pcd8544_dma_xfer_end( void )
+{
+    PCD8544_Done_Cb_t done = pcd8544_xfer.done;
+
+    pcd8544_spi_cs_disable();
+    pcd8544_refresh_done( pcd8544_xfer.start, pcd8544_xfer.bytes );
+    pcd8544_xfer.busy = FALSE;
+
+    if ( NULL != done )
+    {
+        done();
+    }
+}
+
+static void pcd8544_dma_xfer_cb( DMA_HandleTypeDef* dma )
+{
+    status_t ret;
+
+    (void) dma;
+
+    /* Last byte is still in the shift register */
+    while ( 0 == ( PCD8544_SPI->SR & SPI_SR_TXE ))
+    {
+    }
+    while ( 0 != ( PCD8544_SPI->SR & SPI_SR_BSY ))
+    {
+    }
+
+    ret = pcd8544_dma_page_start( pcd8544_xfer.page + 1 );
+
+    if ( STATUS_OK != ret )
+    {
+        pcd8544_dma_xfer_end();
+    }
+}
+
+static void pcd8544_dma_xfer_err_cb( DMA_HandleTypeDef* dma )
+{
+    (void) dma;
+
+    pcd8544_dma_xfer_end();
+}
+
+static status_t pcd8544_dma_init( void )
+{
+    status_t          ret = STATUS_OK;
+    HAL_StatusTypeDef hret;
+
+    pcd8544_dma.Init.Direction           = DMA_MEMORY_TO_PERIPH;
+    pcd8544_dma.Init.PeriphInc           = DMA_PINC_DISABLE;
+    pcd8544_dma.Init.MemInc              = DMA_MINC_ENABLE;
+    pcd8544_dma.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    pcd8544_dma.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+    pcd8544_dma.Init.Mode                = DMA_NORMAL;
+    pcd8544_dma.Init.Priority            = DMA_PRIORITY_LOW;
+
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    hret = HAL_DMA_Init( &pcd8544_dma );
+
+    pcd8544_dma.XferCpltCallback  = pcd8544_dma_xfer_cb;
+    pcd8544_dma.XferErrorCallback = pcd8544_dma_xfer_err_cb;
+
+    /* Below the ADC DMA, the display can always wait */
+    HAL_NVIC_SetPriority( DMA1_Channel5_IRQn, 3, 0 );
+    HAL_NVIC_EnableIRQ( DMA1_Channel5_IRQn );
+
+    if ( HAL_OK != hret )
+    {
+        ret = STATUS_ERROR;
+    }
+    else
+    {
+        __HAL_SPI_ENABLE( &spi_hdl );
+        PCD8544_SPI->CR2 |= SPI_CR2_TXDMAEN;
+    }
+
+    return ret;
+}
+
+#endif
+
 status_t pcd8544_init( uint8_t contrast )
 {
     status_t ret;
@@ -378,6 +612,13 @@ status_t pcd8544_init( uint8_t contrast )
     pcd8544_gpio_init();
     ret = pcd8544_spi_init( PCD8544_SPI );
 
+#if ( PCD8544_DMA_ENABLED != 0 )
+    if ( STATUS_ERROR != ret )
+    {
+        ret = pcd8544_dma_init();
+    }
+#endif
+
     if ( STATUS_ERROR != ret )
     {
         /* Reset the device */
@@ -508,31 +749,109 @@ status_t pcd8544_invert( PCD8544_Invert_t invert )
     return ret;
 }
 
-status_t pcd8544_refresh( void )
+#if ( PCD8544_DMA_ENABLED != 0 )
+status_t pcd8544_refresh_async( PCD8544_Done_Cb_t done )
 {
-    status_t ret = STATUS_OK;
-    uint8_t  i;
-    uint8_t  j;
+    status_t ret = STATUS_ERROR;
 
-    for ( i = 0; i < 6; i++ )
+    if ( FALSE == pcd8544_xfer.busy )
     {
-        /* Not in range yet */
-        if ( pcd8544_update_y_min > (( i + 1 ) * 8 ))
+        ret = STATUS_OK;
+
+        get_time( &pcd8544_xfer.start );
+        pcd8544_xfer.bytes = pcd8544_dirty_take( pcd8544_xfer.span );
+
+        if ( 0 != pcd8544_xfer.bytes )
         {
-            continue;
+            pcd8544_xfer.busy = TRUE;
+            pcd8544_xfer.done = done;
+
+            /* CS stays low for the whole refresh */
+            pcd8544_spi_cs_enable();
+            ret = pcd8544_dma_page_start( 0 );
+
+            if ( STATUS_OK != ret )
+            {
+                pcd8544_dma_xfer_end();
+            }
         }
-        /* Over range, stop */
-        if (( i * 8 ) > pcd8544_update_y_max )
+        else if ( NULL != done )
         {
-            break;
+            done();
+        }
+    }
+
+    return ret;
+}
+
+bool_t pcd8544_is_busy( void )
+{
+    return pcd8544_xfer.busy;
+}
+
+status_t pcd8544_refresh( void )
+{
+    status_t ret;
+
+    ret = pcd8544_refresh_async( NULL );
+
+    while ( FALSE != pcd8544_xfer.busy )
+    {
+    }
+
+    return ret;
+}
+
+void pcd8544_dma_irq_hdl( void )
+{
+    HAL_DMA_IRQHandler( &pcd8544_dma );
+}
+#else
+status_t pcd8544_refresh_async( PCD8544_Done_Cb_t done )
+{
+    status_t ret;
+
+    ret = pcd8544_refresh();
+
+    if ( NULL != done )
+    {
+        done();
+    }
+
+    return ret;
+}
+
+bool_t pcd8544_is_busy( void )
+{
+    return FALSE;
+}
+
+status_t pcd8544_refresh( void )
+{
+    status_t       ret = STATUS_OK;
+    PCD8544_Span_t span[PCD8544_PAGES];
+    uint16_t       bytes;
+    uint8_t        i;
+    uint8_t        j;
+    Time_t         start;
+
+    get_time( &start );
+    bytes = pcd8544_dirty_take( span );
+
+    for ( i = 0; i < PCD8544_PAGES; i++ )
+    {
+        /* Clean page */
+        if ( span[i].x_min > span[i].x_max )
+        {
+            continue;
         }
 
         ret |= pcd8544_write( PCD8544_WRITE_CMD, PCD8544_SETYADDR | i );
         ret |= pcd8544_write( PCD8544_WRITE_CMD
-                            , PCD8544_SETXADDR | pcd8544_update_x_min
+                            , PCD8544_SETXADDR | span[i].x_min
                             );
 
-        for ( j = pcd8544_update_x_min; j <= pcd8544_update_x_max; j++ )
+        for ( j = span[i].x_min; j <= span[i].x_max; j++ )
         {
             ret |= pcd8544_write( PCD8544_WRITE_DATA
                                 , pcd8544_buff[( i * PCD8544_WIDTH ) + j]
@@ -540,13 +859,19 @@ status_t pcd8544_refresh( void )
         }
     }
 
-    pcd8544_update_x_min = PCD8544_WIDTH - 1;
-    pcd8544_update_x_max = 0;
-    pcd8544_update_y_min = PCD8544_HEIGHT - 1;
-    pcd8544_update_y_max = 0;
+    pcd8544_refresh_done( start, bytes );
 
     return ret;
 }
+#endif
+
+void pcd8544_get_stats( PCD8544_Stats_t* stats )
+{
+    if ( NULL != stats )
+    {
+        *stats = pcd8544_stats;
+    }
+}
 
 void pcd8544_update_area( uint8_t xmin
                         , uint8_t ymin
@@ -554,21 +879,27 @@ void pcd8544_update_area( uint8_t xmin
                         , uint8_t ymax
                         )
 {
-    if ( xmin < pcd8544_update_x_min )
-    {
-        pcd8544_update_x_min = xmin;
-    }
-    if ( xmax > pcd8544_update_x_max )
+    uint8_t page;
+
+    if ( xmax >= PCD8544_WIDTH )
     {
-        pcd8544_update_x_max = xmax;
+        xmax = PCD8544_WIDTH - 1;
     }
-    if ( ymin < pcd8544_update_y_min )
+    if ( ymax >= PCD8544_HEIGHT )
     {
-        pcd8544_update_y_min = ymin;
+        ymax = PCD8544_HEIGHT - 1;
     }
-    if ( ymax > pcd8544_update_y_max )
+
+    for ( page = ymin / 8; page <= ( ymax / 8 ); page++ )
     {
-        pcd8544_update_y_max = ymax;
+        if ( xmin < pcd8544_dirty[page].x_min )
+        {
+            pcd8544_dirty[page].x_min = xmin;
+        }
+        if ( xmax > pcd8544_dirty[page].x_max )
+        {
+            pcd8544_dirty[page].x_max = xmax;
+        }
     }
 }
 
@@ -578,17 +909,91 @@ void pcd8544_goto_xy( uint8_t x, uint8_t y )
     pcd8544_y = y;
 }
 
-status_t pcd8544_putc( char                ch
-                     , PCD8544_Pixel_t     color
-                     , PCD8544_Font_Size_t size
-                     )
+/* Write the low height bits of a glyph column at x, y. A page aligned y is
+ * a single masked byte store, otherwise the column straddles two pages.
+ */
+static status_t pcd8544_blit_column( uint8_t x
+                                   , uint8_t y
+                                   , uint8_t bits
+                                   , uint8_t height
+                                   )
 {
-    status_t ret;
-    uint8_t c_height;
-    uint8_t c_width;
-    uint8_t i;
-    uint8_t b;
-    uint8_t j;
+    status_t ret   = STATUS_OK;
+    uint8_t  mask  = (uint8_t)(( 1u << height ) - 1 );
+    uint8_t  shift = y % 8;
+    uint8_t* col;
+
+    if (( x >= PCD8544_WIDTH ) || ( y >= PCD8544_HEIGHT ))
+    {
+        ret = STATUS_ERROR;
+    }
+    else
+    {
+        bits &= mask;
+        col   = &pcd8544_buff[x + ( y / 8 ) * PCD8544_WIDTH];
+
+        if ( 0 == shift )
+        {
+            *col = ( *col & ~mask ) | bits;
+        }
+        else
+        {
+            *col = ( *col & ~( mask << shift )) | (uint8_t)( bits << shift );
+
+            if (( y / 8 ) < ( PCD8544_PAGES - 1 ))
+            {
+                col += PCD8544_WIDTH;
+                *col = ( *col & ~( mask >> ( 8 - shift )))
+                     | ( bits >> ( 8 - shift ));
+            }
+        }
+
+        if (( y + height ) > PCD8544_HEIGHT )
+        {
+            /* Clipped at the bottom */
+            ret = STATUS_ERROR;
+        }
+    }
+
+    return ret;
+}
+
+static void pcd8544_update_text_area( PCD8544_Area_t* area )
+{
+    if (( area->x_min <= area->x_max ) && ( area->y_min <= area->y_max ))
+    {
+        pcd8544_update_area( area->x_min
+                           , area->y_min
+                           , area->x_max
+                           , area->y_max
+                           );
+    }
+
+    area->x_min = 0xFF;
+    area->x_max = 0;
+    area->y_min = 0xFF;
+    area->y_max = 0;
+}
+
+/* Render one character at the cursor, the drawn cells are added to area.
+ * The area is only flushed to the dirty spans on a line wrap, so the
+ * lines of a wrapped string do not widen each other's spans.
+ */
+static status_t pcd8544_render_char( char                ch
+                                   , PCD8544_Pixel_t     color
+                                   , PCD8544_Font_Size_t size
+                                   , PCD8544_Area_t*     area
+                                   )
+{
+    status_t ret = STATUS_OK;
+    uint8_t  c_height;
+    uint8_t  c_width;
+    uint8_t  idx  = (uint8_t) ch - 32;
+    uint8_t  inv  = 0x00;
+    uint8_t  x0   = PCD8544_WIDTH;
+    uint8_t  x1   = 0;
+    uint8_t  i;
+    uint8_t  b;
 
     if ( PCD8544_FONT_SIZE_3X5 == size )
     {
@@ -601,60 +1006,89 @@ status_t pcd8544_putc( char                ch
         c_height = PCD8544_CHAR_5X7_HEIGHT;
     }
 
+    if ( PCD8544_PIXEL_SET != color )
+    {
+        inv = 0xFF;
+    }
+
     if (( pcd8544_x + c_width ) > PCD8544_WIDTH )
     {
         /* If at the end of a line of display, go to new line
          * and set x to 0 position
          */
+        pcd8544_update_text_area( area );
         pcd8544_y += c_height;
         pcd8544_x  = 0;
     }
 
     for ( i = 0; i < c_width - 1; i++ )
     {
-        if ( ch < 32 )
-        {   b = 0; /* Avoid compiler warning */
-            /* Example: b = _custom_chars[_font_size][(uint8_t)chr][i]; */
-        }
-        else if ( PCD8544_FONT_SIZE_3X5 == size )
+        /* Control characters wrap around to an index past the table */
+        if ( PCD8544_FONT_SIZE_3X5 == size )
         {
-            b = font_3x5[ch - 32][i];
+            b = ( idx < ( sizeof( font_3x5 ) / sizeof( font_3x5[0] )))
+              ? font_3x5[idx][i] : 0;
         }
         else
         {
-            b = font_5x7[ch - 32][i];
+            b = ( idx < ( sizeof( font_5x7 ) / sizeof( font_5x7[0] )))
+              ? font_5x7[idx][i] : 0;
         }
 
+        /* Empty columns are dropped, except for blanks */
         if ( b == 0x00 && (( ch != 0 ) && ( ch != 32 )))
         {
             continue;
         }
 
-        for ( j = 0; j < c_height; j++ )
+        if (( pcd8544_x < PCD8544_WIDTH ) && ( pcd8544_y < PCD8544_HEIGHT ))
         {
-            if ( PCD8544_PIXEL_SET == color )
-            {
-                ret = pcd8544_draw_pixel
-                            ( pcd8544_x
-                            , ( pcd8544_y + j )
-                            , (( b >> j ) & 1 ) ? \
-                              PCD8544_PIXEL_SET : PCD8544_PIXEL_CLEAR
-                            );
-            }
-            else
+            if ( pcd8544_x < x0 )
             {
-                ret = pcd8544_draw_pixel
-                            ( pcd8544_x
-                            , ( pcd8544_y + j )
-                            , (( b >> j ) & 1 ) ? \
-                              PCD8544_PIXEL_CLEAR : PCD8544_PIXEL_SET
-                            );
+                x0 = pcd8544_x;
             }
+            x1 = pcd8544_x;
         }
+
+        ret |= pcd8544_blit_column( pcd8544_x, pcd8544_y, b ^ inv, c_height );
         pcd8544_x++;
     }
     pcd8544_x++;
 
+    if ( x0 <= x1 )
+    {
+        if ( x0 < area->x_min )
+        {
+            area->x_min = x0;
+        }
+        if ( x1 > area->x_max )
+        {
+            area->x_max = x1;
+        }
+        if ( pcd8544_y < area->y_min )
+        {
+            area->y_min = pcd8544_y;
+        }
+        if (( pcd8544_y + c_height - 1 ) > area->y_max )
+        {
+            area->y_max = pcd8544_y + c_height - 1;
+        }
+    }
+
+    return ret;
+}
+
+status_t pcd8544_putc( char                ch
+                     , PCD8544_Pixel_t     color
+                     , PCD8544_Font_Size_t size
+                     )
+{
+    status_t       ret;
+    PCD8544_Area_t area = { 0xFF, 0, 0xFF, 0 };
+
+    ret = pcd8544_render_char( ch, color, size, &area );
+    pcd8544_update_text_area( &area );
+
     return ret;
 }
 
@@ -663,14 +1097,20 @@ status_t pcd8544_puts( char*               ch
                      , PCD8544_Font_Size_t size
                      )
 {
-    status_t ret = STATUS_ERROR;
+    status_t       ret  = STATUS_ERROR;
+    PCD8544_Area_t area = { 0xFF, 0, 0xFF, 0 };
 
     if ( NULL != ch )
     {
+        ret = STATUS_OK;
+
         while ( *ch )
         {
-            ret = pcd8544_putc( *ch++, color, size );
+            ret |= pcd8544_render_char( *ch++, color, size, &area );
         }
+
+        /* One dirty area update for the whole string */
+        pcd8544_update_text_area( &area );
     }
 
     return ret;
@@ -0,0 +1,133 @@
+/**
+ ** Name
+ **   prof.c
+ **
+ ** Purpose
+ **   Cycle counter profiling of code sections
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Time base also without probes, used by trace
+ **/
+
+#include "prof.h"
+
+#include <string.h>
+
+static const char* const prof_name[PROF_NUM] =
+{
+    "adc",
+    "disp show",
+    "disp irq",
+    "uart1 irq",
+    "uart2 irq",
+    "uart1 tx"
+};
+
+bool_t prof_dwt = FALSE;
+
+#if ( PROF_ENABLED != 0 )
+static Prof_Scope_t prof_scope[PROF_NUM];
+#endif /* PROF_ENABLED */
+
+/*
+ * Start the DWT cycle counter. Cores without one leave CYCCNT at zero, the
+ * probes use get_time() then.
+ */
+void prof_init( void )
+{
+    uint32_t start;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+
+    if ( 0 == ( DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk ))
+    {
+        DWT->CYCCNT  = 0;
+        DWT->CTRL   |= DWT_CTRL_CYCCNTENA_Msk;
+
+        start = DWT->CYCCNT;
+        __NOP();
+        __NOP();
+
+        prof_dwt = ( start != DWT->CYCCNT ) ? TRUE : FALSE;
+    }
+
+    prof_reset();
+}
+
+#if ( PROF_ENABLED != 0 )
+
+void prof_add( Prof_Id_t id, uint32_t ticks )
+{
+    Prof_Scope_t* scope = &prof_scope[id];
+    uint32_t      bin   = 0;
+
+    while (( ticks >> ( bin + 1 )) && ( bin < ( PROF_HIST_BINS - 1 )))
+    {
+        bin++;
+    }
+
+    if ( 0xFFFF != scope->hist[bin] )
+    {
+        scope->hist[bin]++;
+    }
+
+    scope->min    = ( ticks < scope->min ) ? ticks : scope->min;
+    scope->max    = ( ticks > scope->max ) ? ticks : scope->max;
+    scope->total += ticks;
+    scope->count++;
+}
+
+#endif /* PROF_ENABLED */
+
+const char* prof_get_name( Prof_Id_t id )
+{
+    return prof_name[id % PROF_NUM];
+}
+
+/* Tick rate of the probes */
+uint32_t prof_get_hz( void )
+{
+    uint32_t ret = 1000000;
+
+    if ( FALSE != prof_dwt )
+    {
+        ret = SystemCoreClock;
+    }
+
+    return ret;
+}
+
+/*
+ * Copy of a scope, probes in interrupts can't tear it
+ */
+void prof_get( Prof_Id_t id, Prof_Scope_t* scope )
+{
+    memset( scope, 0, sizeof( Prof_Scope_t ));
+
+#if ( PROF_ENABLED != 0 )
+    __disable_irq();
+    *scope = prof_scope[id % PROF_NUM];
+    __enable_irq();
+#else
+    (void) id;
+#endif
+}
+
+void prof_reset( void )
+{
+#if ( PROF_ENABLED != 0 )
+    uint8_t id;
+
+    __disable_irq();
+
+    memset( prof_scope, 0, sizeof( prof_scope ));
+
+    for ( id = 0; id < PROF_NUM; id++ )
+    {
+        prof_scope[id].min = 0xFFFFFFFF;
+    }
+
+    __enable_irq();
+#endif
+}
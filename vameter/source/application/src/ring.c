@@ -0,0 +1,191 @@
+/**
+ ** Name
+ **   ring.c
+ **
+ ** Purpose
+ **   Lock-free single producer / single consumer byte ring
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Zero-copy spans and line extraction
+ **   18-Oct-2026 (SSB) [] Second copy only when the data wraps
+ **/
+
+#include "ring.h"
+
+#include <string.h>
+
+status_t ring_init( Ring_t* ring, uint32_t size, void* storage )
+{
+    status_t ret = STATUS_ERROR;
+
+    if (( NULL != ring ) && ( NULL != storage ) && RING_IS_POW2( size ))
+    {
+        ring->data = (uint8_t*) storage;
+        ring->mask = size - 1;
+        ring->head = 0;
+        ring->tail = 0;
+
+        ret = STATUS_OK;
+    }
+
+    return ret;
+}
+
+uint32_t ring_write( Ring_t* ring, const void* data, uint32_t count )
+{
+    uint32_t head;
+    uint32_t free;
+    uint32_t idx;
+    uint32_t tocopy;
+
+    head = ring->head;
+    free = ring_size( ring ) - ( head - RING_LOAD_ACQUIRE( &ring->tail ));
+
+    if ( count > free )
+    {
+        count = free;
+    }
+
+    if ( count > 0 )
+    {
+        idx    = head & ring->mask;
+        tocopy = ring_size( ring ) - idx;
+
+        if ( tocopy > count )
+        {
+            tocopy = count;
+        }
+
+        memcpy( &ring->data[idx], data, tocopy );
+
+        if ( count > tocopy )
+        {
+            memcpy( ring->data
+                  , (const uint8_t*) data + tocopy
+                  , count - tocopy
+                  );
+        }
+
+        RING_STORE_RELEASE( &ring->head, head + count );
+    }
+
+    return count;
+}
+
+uint32_t ring_peek( Ring_t* ring, void* data, uint32_t count, uint32_t offset )
+{
+    uint32_t full;
+    uint32_t idx;
+    uint32_t tocopy;
+
+    full = ring_count( ring );
+
+    if ( offset >= full )
+    {
+        count = 0;
+    }
+    else if ( count > ( full - offset ))
+    {
+        count = full - offset;
+    }
+
+    if ( count > 0 )
+    {
+        idx    = ( ring->tail + offset ) & ring->mask;
+        tocopy = ring_size( ring ) - idx;
+
+        if ( tocopy > count )
+        {
+            tocopy = count;
+        }
+
+        memcpy( data, &ring->data[idx], tocopy );
+
+        if ( count > tocopy )
+        {
+            memcpy( (uint8_t*) data + tocopy, ring->data, count - tocopy );
+        }
+    }
+
+    return count;
+}
+
+uint32_t ring_read( Ring_t* ring, void* data, uint32_t count )
+{
+    count = ring_peek( ring, data, count, 0 );
+
+    if ( count > 0 )
+    {
+        RING_STORE_RELEASE( &ring->tail, ring->tail + count );
+    }
+
+    return count;
+}
+
+uint32_t ring_skip( Ring_t* ring, uint32_t count )
+{
+    uint32_t full;
+
+    full = ring_count( ring );
+
+    if ( count > full )
+    {
+        count = full;
+    }
+
+    RING_STORE_RELEASE( &ring->tail, ring->tail + count );
+
+    return count;
+}
+
+uint32_t ring_spans( Ring_t* ring, Ring_Span_t* span )
+{
+    const uint32_t full = ring_count( ring );
+    const uint32_t idx  = ring->tail & ring->mask;
+    uint32_t       first;
+
+    first = ring_size( ring ) - idx;
+    first = ( first > full ) ? full : first;
+
+    span[0].data = &ring->data[idx];
+    span[0].size = first;
+    span[1].data = ring->data;
+    span[1].size = full - first;
+
+    return full;
+}
+
+uint32_t ring_line( Ring_t* ring, uint8_t delim, Ring_Span_t* span )
+{
+    uint32_t       ret = 0;
+    const uint8_t* end;
+
+    (void) ring_spans( ring, span );
+
+    end = memchr( span[0].data, delim, span[0].size );
+
+    if ( NULL != end )
+    {
+        span[0].size = (uint32_t)( end - span[0].data ) + 1;
+        span[1].size = 0;
+        ret          = span[0].size;
+    }
+    else
+    {
+        end = memchr( span[1].data, delim, span[1].size );
+
+        if ( NULL != end )
+        {
+            span[1].size = (uint32_t)( end - span[1].data ) + 1;
+            ret          = span[0].size + span[1].size;
+        }
+    }
+
+    return ret;
+}
+
+void ring_flush( Ring_t* ring )
+{
+    RING_STORE_RELEASE( &ring->tail, RING_LOAD_ACQUIRE( &ring->head ));
+}
@@ -0,0 +1,226 @@
+/**
+ ** Name
+ **   stream.c
+ **
+ ** Purpose
+ **   Binary sample streaming
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "stream.h"
+
+#include "crc.h"
+#include "uart.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#if ( STREAM_WIRE_SIZE > UART1_TX_BUFFER_SIZE )
+    #error "Stream frame does not fit into the UART1 transmit ring"
+#endif
+
+typedef struct
+{
+    Stream_Hdr_t hdr;
+    uint16_t     data[STREAM_FRAME_PAIRS * ADC_CH_NUM];
+    uint16_t     crc;
+} Stream_Frame_t;
+
+typedef struct
+{
+    bool_t   active;
+    uint8_t  dec;
+    uint8_t  dec_shift;     /* log2( dec ) */
+    uint8_t  acc_cnt;       /* Pairs summed into acc */
+    uint32_t acc[ADC_CH_NUM];
+    uint16_t pairs;         /* Pairs in the frame */
+    uint16_t seq;
+} Stream_t;
+
+static Stream_t       stream;
+static Stream_Frame_t stream_frame;
+static Stream_Stats_t stream_stats;
+static uint8_t        stream_wire[STREAM_WIRE_SIZE];
+
+/* Consistent overhead byte stuffing, the output holds no zero byte. Each
+ * code byte tells the distance to the next zero, 0xFF marks a full run of
+ * 254 non-zero bytes without one. Returns encoded size.
+ */
+static uint32_t stream_cobs( const uint8_t* in, uint32_t size, uint8_t* out )
+{
+    uint32_t code_pos = 0;
+    uint32_t pos      = 1;
+    uint8_t  code     = 1;
+    uint32_t i;
+
+    for ( i = 0; i < size; i++ )
+    {
+        if ( 0 != in[i] )
+        {
+            out[pos++] = in[i];
+            code++;
+        }
+
+        if (( 0 == in[i] ) || ( 0xFF == code ))
+        {
+            out[code_pos] = code;
+            code_pos      = pos++;
+            code          = 1;
+        }
+    }
+
+    out[code_pos] = code;
+
+    return pos;
+}
+
+static void stream_send( void )
+{
+    Uart_Tx_Stats_t tx;
+    uint32_t        size;
+    uint32_t        dropped;
+
+    stream_frame.hdr.ver    = STREAM_VER;
+    stream_frame.hdr.ch_num = ADC_CH_NUM;
+    stream_frame.hdr.seq    = stream.seq++;
+    stream_frame.hdr.fs     = adc_get_fs();
+    stream_frame.hdr.shift  = (uint8_t) adc_get_rms( 0 )->shift;
+    stream_frame.hdr.dec    = stream.dec;
+    stream_frame.hdr.count  = stream.pairs;
+
+    stream_frame.crc = crc16( CRC16_INIT
+                            , &stream_frame
+                            , offsetof( Stream_Frame_t, crc )
+                            );
+
+    size = stream_cobs( (const uint8_t*) &stream_frame
+                      , STREAM_FRAME_SIZE
+                      , stream_wire
+                      );
+    stream_wire[size++] = 0;
+
+    /* Drop policy, the frame is queued whole or not at all */
+    uart_get_tx_stats( STREAM_UART, &tx );
+    dropped = tx.dropped;
+
+    uart_send( STREAM_UART, stream_wire, (uint16_t) size );
+
+    uart_get_tx_stats( STREAM_UART, &tx );
+
+    if ( tx.dropped != dropped )
+    {
+        stream_stats.dropped++;
+    }
+    else
+    {
+        stream_stats.bytes += size;
+    }
+
+    stream_stats.frames++;
+    stream.pairs = 0;
+}
+
+status_t stream_start( uint8_t dec )
+{
+    status_t ret  = STATUS_ERROR;
+    uint8_t  zero = 0;
+
+    if (( 0 != dec )
+     && ( dec <= STREAM_DEC_MAX )
+     && ( 0 == ( dec & ( dec - 1 ))))
+    {
+        memset( &stream, 0, sizeof( stream ));
+        memset( &stream_stats, 0, sizeof( stream_stats ));
+
+        stream.dec = dec;
+
+        while (( 1U << stream.dec_shift ) < dec )
+        {
+            stream.dec_shift++;
+        }
+
+        uart_flush( STREAM_UART );
+        uart_set_tx_policy( STREAM_UART, UART_TX_POLICY_DROP );
+        uart_send( STREAM_UART, &zero, 1 );
+
+        stream.active = TRUE;
+        ret           = STATUS_OK;
+    }
+
+    return ret;
+}
+
+void stream_stop( void )
+{
+    stream.active = FALSE;
+
+    uart_flush( STREAM_UART );
+    uart_set_tx_policy( STREAM_UART, UART_TX_DEFAULT_POLICY );
+}
+
+bool_t stream_is_active( void )
+{
+    return stream.active;
+}
+
+uint32_t stream_get_rate( uint8_t dec )
+{
+    uint32_t frames;
+
+    /* Frames per second rounded up, payload is two bytes per sample */
+    frames = ( adc_get_fs() + ( dec * STREAM_FRAME_PAIRS ) - 1 )
+           / ( dec * STREAM_FRAME_PAIRS );
+
+    return frames * STREAM_WIRE_SIZE;
+}
+
+/* Boxcar over dec pairs, like the ADC decimation. The sum is rounded and
+ * scaled back, so samples keep the ADC fractional bits. The state carries
+ * over half buffers, their length need not be a multiple of dec.
+ */
+void stream_feed( const uint16_t* frame, uint32_t pairs )
+{
+    const uint32_t round = ( 1UL << stream.dec_shift ) >> 1;
+    uint16_t*      out;
+    uint32_t       i;
+    uint32_t       ch;
+
+    if ( stream.active )
+    {
+        for ( i = 0; i < pairs; i++ )
+        {
+            for ( ch = 0; ch < ADC_CH_NUM; ch++ )
+            {
+                stream.acc[ch] += frame[ch];
+            }
+
+            frame += ADC_CH_NUM;
+
+            if ( ++stream.acc_cnt >= stream.dec )
+            {
+                out = &stream_frame.data[stream.pairs * ADC_CH_NUM];
+
+                for ( ch = 0; ch < ADC_CH_NUM; ch++ )
+                {
+                    out[ch]        = (uint16_t)(( stream.acc[ch] + round )
+                                                >> stream.dec_shift );
+                    stream.acc[ch] = 0;
+                }
+
+                stream.acc_cnt = 0;
+
+                if ( ++stream.pairs >= STREAM_FRAME_PAIRS )
+                {
+                    stream_send();
+                }
+            }
+        }
+    }
+}
+
+void stream_get_stats( Stream_Stats_t* stats )
+{
+    *stats = stream_stats;
+}
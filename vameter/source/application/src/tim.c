@@ -7,16 +7,81 @@
  **
  ** Revision
  **   10-Oct-2020 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Runtime ADC trigger rate
+ **   18-Oct-2026 (SSB) [] Post periodic tick event
+ **   18-Oct-2026 (SSB) [] Load the new ADC trigger prescaler at once
  **/
 
 #include "tim.h"
 
+#include "event.h"
+
 static TIM_HandleTypeDef adc_tmr;
 static TIM_HandleTypeDef ms_tmr;
 static TIM_HandleTypeDef master_tmr;
 static TIM_HandleTypeDef slave_tmr;
 
 static volatile uint32_t system_timer_hi = 0;
+static uint32_t          tmr_ms_tick     = 0;
+
+/* ADC trigger, 24 MHz / 100 / 100 = 2.4 kS/s until set otherwise */
+static uint32_t adc_tmr_psc = 99;
+static uint32_t adc_tmr_arr = 99;
+
+static uint32_t tmr_adc_get_clk( void )
+{
+    uint32_t ret = HAL_RCC_GetPCLK2Freq();
+
+    /* Timer clock is doubled when APB2 is divided */
+    if ( 0 != ( RCC->CFGR & RCC_CFGR_PPRE2 ))
+    {
+        ret *= 2;
+    }
+
+    return ret;
+}
+
+/* Split the timer clock divider into prescaler and period, the prescaler
+ * is kept as small as possible for the best rate resolution. Applied
+ * immediately when the timer is already running.
+ */
+status_t tmr_adc_set_rate( uint32_t rate )
+{
+    status_t ret = STATUS_ERROR;
+    uint32_t div;
+
+    if ( rate > 0 )
+    {
+        div = tmr_adc_get_clk() / rate;
+
+        if ( div >= 2 )
+        {
+            adc_tmr_psc = ( div - 1 ) / 0x10000;
+            adc_tmr_arr = ( div / ( adc_tmr_psc + 1 )) - 1;
+
+            if ( NULL != adc_tmr.Instance )
+            {
+                __HAL_TIM_SET_PRESCALER( &adc_tmr, adc_tmr_psc );
+                __HAL_TIM_SET_AUTORELOAD( &adc_tmr, adc_tmr_arr );
+
+                /* PSC is preloaded, the update event loads it now instead
+                 * of after one more period at the old rate, and clears the
+                 * counter
+                 */
+                adc_tmr.Instance->EGR = TIM_EGR_UG;
+            }
+
+            ret = STATUS_OK;
+        }
+    }
+
+    return ret;
+}
+
+uint32_t tmr_adc_get_rate( void )
+{
+    return tmr_adc_get_clk() / (( adc_tmr_psc + 1 ) * ( adc_tmr_arr + 1 ));
+}
 
 static HAL_StatusTypeDef timebase_master_init( void )
 {
@@ -102,9 +167,9 @@ status_t tmr_adc_init( void )
     TIM_BreakDeadTimeConfigTypeDef break_dead_cfg = {0};
 
     adc_tmr.Instance               = TIM1;
-    adc_tmr.Init.Prescaler         = 99;
+    adc_tmr.Init.Prescaler         = adc_tmr_psc;
     adc_tmr.Init.CounterMode       = TIM_COUNTERMODE_UP;
-    adc_tmr.Init.Period            = 99;
+    adc_tmr.Init.Period            = adc_tmr_arr;
     adc_tmr.Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
     adc_tmr.Init.RepetitionCounter = 0;
     adc_tmr.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
@@ -285,6 +350,12 @@ void HAL_TIM_PeriodElapsedCallback( TIM_HandleTypeDef* tmr )
     }
     if ( TIM7 == tmr->Instance )
     {
-        /* Do nothing here as another routine is called directly from IT */
+        tmr_ms_tick++;
+
+        if ( tmr_ms_tick >= EVENT_TICK_MS )
+        {
+            tmr_ms_tick = 0;
+            event_post( EVENT_TICK );
+        }
     }
 }
@@ -0,0 +1,114 @@
+/**
+ ** Name
+ **   trace.c
+ **
+ ** Purpose
+ **   Timestamped event trace in RAM
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "trace.h"
+
+#include "uart.h"
+
+#include <string.h>
+
+#if ( TRACE_ENABLED != 0 )
+
+volatile bool_t trace_on = FALSE;
+uint32_t        trace_head;
+Trace_Rec_t     trace_buff[TRACE_SIZE];
+
+#endif /* TRACE_ENABLED */
+
+/*
+ * Clear the ring and record from now on, the ring keeps the newest records
+ */
+void trace_start( void )
+{
+#if ( TRACE_ENABLED != 0 )
+    trace_on = FALSE;
+
+    __disable_irq();
+    trace_head = 0;
+    memset( trace_buff, 0, sizeof( trace_buff ));
+    __enable_irq();
+
+    trace_on = TRUE;
+#endif
+}
+
+/*
+ * Freeze the ring, e.g. right after an anomaly
+ */
+void trace_stop( void )
+{
+#if ( TRACE_ENABLED != 0 )
+    trace_on = FALSE;
+#endif
+}
+
+/*
+ * Send header and records raw to the PC, oldest first. Recording pauses
+ * meanwhile, so the dump doesn't trace itself. Returns records sent.
+ */
+uint32_t trace_dump( void )
+{
+    Trace_Hdr_t hdr;
+    uint32_t    ret = 0;
+
+#if ( TRACE_ENABLED != 0 )
+    const bool_t on = trace_on;
+    uint32_t     head;
+    uint32_t     first;
+    uint32_t     idx;
+    uint32_t     n;
+
+    trace_on = FALSE;
+
+    /* Interrupts that passed the check before have finished their write */
+    head  = trace_head;
+    ret   = ( head > TRACE_SIZE ) ? TRACE_SIZE : head;
+    first = head - ret;
+
+    hdr.magic = TRACE_MAGIC;
+    hdr.ver   = TRACE_VER;
+    hdr.count = (uint16_t) ret;
+    hdr.hz    = prof_get_hz();
+
+    uart_send( UART_TO_PC, (uint8_t*) &hdr, sizeof( hdr ));
+
+    /* Oldest up to the end of the ring, then the wrapped rest */
+    idx = first % TRACE_SIZE;
+    n   = TRACE_SIZE - idx;
+    n   = ( n > ret ) ? ret : n;
+
+    uart_send( UART_TO_PC
+             , (uint8_t*) &trace_buff[idx]
+             , (uint16_t)( n * sizeof( Trace_Rec_t ))
+             );
+
+    if ( ret > n )
+    {
+        uart_send( UART_TO_PC
+                 , (uint8_t*) &trace_buff[0]
+                 , (uint16_t)(( ret - n ) * sizeof( Trace_Rec_t ))
+                 );
+    }
+
+    uart_flush( UART_TO_PC );
+
+    trace_on = on;
+#else
+    memset( &hdr, 0, sizeof( hdr ));
+    hdr.magic = TRACE_MAGIC;
+    hdr.ver   = TRACE_VER;
+
+    uart_send( UART_TO_PC, (uint8_t*) &hdr, sizeof( hdr ));
+    uart_flush( UART_TO_PC );
+#endif
+
+    return ret;
+}
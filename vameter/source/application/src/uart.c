@@ -7,11 +7,24 @@
  **
  ** Revision
  **   27-Aug-2020 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Push received bytes through SPSC ring
+ **   18-Oct-2026 (SSB) [] Add circular DMA receive with IDLE detection
+ **   18-Oct-2026 (SSB) [] Add non-blocking DMA transmit
+ **   18-Oct-2026 (SSB) [] Post receive events
+ **   18-Oct-2026 (SSB) [] Profiling probes
+ **   18-Oct-2026 (SSB) [] Trace interrupts
+ **   18-Oct-2026 (SSB) [] Incremental string search
+ **   18-Oct-2026 (SSB) [] Received data in place
+ **   18-Oct-2026 (SSB) [] Long search strings fall back to a plain scan
+ **   18-Oct-2026 (SSB) [] Drop the ring on DMA overrun, keep head on DMA
  **/
 
 #include "uart.h"
 
 #include "buffer.h"
+#include "event.h"
+#include "prof.h"
+#include "trace.h"
 
 #include <string.h>
 
@@ -21,26 +34,251 @@
     #define PUTCHAR_PROTOTYPE int fputc(int ch, FILE *f)
 #endif /* __GNUC__ */
 
-static uint8_t  uart1_received_data[64];
+static uint8_t  uart1_received_data[UART1_BUFFER_SIZE];
 static uint8_t  uart2_received_data[UART_BUFFER_SIZE];
 
-static Buffer_t uart1_buffer =
+static Buffer_t uart1_buffer = BUFFER_INIT( uart1_received_data
+                                          , UART_STRING_DELIMITER
+                                          );
+
+static Buffer_t uart2_buffer = BUFFER_INIT( uart2_received_data
+                                          , UART_STRING_DELIMITER
+                                          );
+
+/* In DMA receive mode the ring storage is the circular DMA target and the
+ * ring head is moved in bulk from the IDLE line, half and full transfer
+ * interrupts. The UART and its DMA channel share the same NVIC priority so
+ * the two producer paths never preempt each other.
+ */
+typedef struct
+{
+    Buffer_t*         buff;      /* Receive buffer fed by DMA */
+    DMA_HandleTypeDef dma;       /* Receive DMA channel */
+    uint32_t          overrun;   /* Number of detected ring overruns */
+    volatile bool_t   resync;    /* Overrun not yet dropped by consumer */
+} Uart_Rx_Dma_t;
+
+#if ( UART1_RX_DMA_ENABLED != 0 )
+static Uart_Rx_Dma_t uart1_rx_dma =
+{
+    .buff = &uart1_buffer,
+    .dma  = { .Instance = DMA1_Channel5 }
+};
+#endif
+
+#if ( UART2_RX_DMA_ENABLED != 0 )
+static Uart_Rx_Dma_t uart2_rx_dma =
+{
+    .buff = &uart2_buffer,
+    .dma  = { .Instance = DMA1_Channel6 }
+};
+#endif
+
+/* Transmit ring is filled from the main loop and drained by DMA, the DMA
+ * transfer complete interrupt is the only consumer. Printing from ISRs is
+ * not supported.
+ */
+typedef struct
+{
+    Ring_t            ring;      /* Transmit ring */
+    DMA_HandleTypeDef dma;       /* Transmit DMA channel */
+    USART_TypeDef*    uart;      /* Owner UART */
+    volatile uint32_t xfer_len;  /* Bytes handed to DMA, 0 when idle */
+    Uart_Tx_Policy_t  policy;    /* Full buffer policy */
+    uint32_t          dropped;   /* Number of dropped bytes */
+    uint32_t          hwm;       /* Ring usage high-water mark */
+} Uart_Tx_Dma_t;
+
+#if ( UART1_TX_DMA_ENABLED != 0 )
+static uint8_t uart1_transmit_data[UART1_TX_BUFFER_SIZE];
+
+static Uart_Tx_Dma_t uart1_tx_dma =
 {
-    .size      = 64,
-    .in        = 0,
-    .out       = 0,
-    .data      = uart1_received_data,
-    .delimiter = UART_STRING_DELIMITER
+    .ring   = RING_INIT( uart1_transmit_data ),
+    .dma    = { .Instance = DMA1_Channel4 },
+    .uart   = USART1,
+    .policy = UART_TX_DEFAULT_POLICY
 };
+#endif
 
-static Buffer_t uart2_buffer =
+#if ( UART2_TX_DMA_ENABLED != 0 )
+static uint8_t uart2_transmit_data[UART2_TX_BUFFER_SIZE];
+
+static Uart_Tx_Dma_t uart2_tx_dma =
 {
-    .size      = UART_BUFFER_SIZE,
-    .in        = 0,
-    .out       = 0,
-    .data      = uart2_received_data,
-    .delimiter = UART_STRING_DELIMITER
+    .ring   = RING_INIT( uart2_transmit_data ),
+    .dma    = { .Instance = DMA1_Channel7 },
+    .uart   = USART2,
+    .policy = UART_TX_DEFAULT_POLICY
 };
+#endif
+
+static Uart_Tx_Dma_t* uart_get_tx_dma_hdl( USART_TypeDef* uart )
+{
+    Uart_Tx_Dma_t* tx_dma = NULL;
+
+#if ( UART1_TX_DMA_ENABLED != 0 )
+    if ( USART1 == uart )
+    {
+        tx_dma = &uart1_tx_dma;
+    }
+#endif
+#if ( UART2_TX_DMA_ENABLED != 0 )
+    if ( USART2 == uart )
+    {
+        tx_dma = &uart2_tx_dma;
+    }
+#endif
+
+    (void) uart;
+
+    return tx_dma;
+}
+
+/* Hand the next contiguous ring chunk to DMA, if DMA is idle */
+static void uart_tx_dma_kick( Uart_Tx_Dma_t* tx_dma )
+{
+    HAL_StatusTypeDef hret;
+    uint32_t          count;
+    uint32_t          idx;
+    uint32_t          len;
+
+    if ( 0 == tx_dma->xfer_len )
+    {
+        count = ring_count( &tx_dma->ring );
+
+        if ( 0 != count )
+        {
+            idx = tx_dma->ring.tail & tx_dma->ring.mask;
+            len = ring_size( &tx_dma->ring ) - idx;
+
+            if ( len > count )
+            {
+                len = count;
+            }
+
+            hret = HAL_DMA_Start_IT( &tx_dma->dma
+                                   , (uint32_t) &tx_dma->ring.data[idx]
+                                   , (uint32_t) &tx_dma->uart->DR
+                                   , len
+                                   );
+
+            if ( HAL_OK == hret )
+            {
+                tx_dma->xfer_len = len;
+            }
+        }
+    }
+}
+
+static void uart_tx_dma_xfer_cb( DMA_HandleTypeDef* dma )
+{
+    Uart_Tx_Dma_t* tx_dma = (Uart_Tx_Dma_t*) dma->Parent;
+
+    (void) ring_skip( &tx_dma->ring, tx_dma->xfer_len );
+    tx_dma->xfer_len = 0;
+
+    uart_tx_dma_kick( tx_dma );
+}
+
+static status_t uart_tx_dma_start( USART_TypeDef* uart )
+{
+    status_t          ret = STATUS_OK;
+    HAL_StatusTypeDef hret;
+    IRQn_Type         dma_irqn;
+    Uart_Tx_Dma_t*    tx_dma;
+
+    tx_dma = uart_get_tx_dma_hdl( uart );
+
+    if ( NULL != tx_dma )
+    {
+        if ( DMA1_Channel4 == tx_dma->dma.Instance )
+        {
+            dma_irqn = DMA1_Channel4_IRQn;
+        }
+        else
+        {
+            dma_irqn = DMA1_Channel7_IRQn;
+        }
+
+        tx_dma->dma.Init.Direction           = DMA_MEMORY_TO_PERIPH;
+        tx_dma->dma.Init.PeriphInc           = DMA_PINC_DISABLE;
+        tx_dma->dma.Init.MemInc              = DMA_MINC_ENABLE;
+        tx_dma->dma.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+        tx_dma->dma.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+        tx_dma->dma.Init.Mode                = DMA_NORMAL;
+        tx_dma->dma.Init.Priority            = DMA_PRIORITY_LOW;
+
+        __HAL_RCC_DMA1_CLK_ENABLE();
+
+        hret = HAL_DMA_Init( &tx_dma->dma );
+
+        tx_dma->dma.Parent           = tx_dma;
+        tx_dma->dma.XferCpltCallback = uart_tx_dma_xfer_cb;
+        tx_dma->xfer_len             = 0;
+
+        HAL_NVIC_SetPriority( dma_irqn, 2, 2 );
+        HAL_NVIC_EnableIRQ( dma_irqn );
+
+        if ( HAL_OK != hret )
+        {
+            ret = STATUS_ERROR;
+        }
+        else
+        {
+            uart->CR3 |= USART_CR3_DMAT;
+        }
+    }
+
+    return ret;
+}
+
+static uint16_t uart_tx_dma_write( Uart_Tx_Dma_t* tx_dma
+                                 , const uint8_t* data
+                                 , uint16_t       count
+                                 )
+{
+    uint32_t         written = 0;
+    uint32_t         used;
+    uint32_t         primask;
+    Uart_Tx_Policy_t policy  = tx_dma->policy;
+
+    /* Nobody would drain the ring while interrupts are masked */
+    if (( UART_TX_POLICY_BLOCK == policy )
+     && (( 0 != __get_PRIMASK()) || ( 0 != __get_IPSR())))
+    {
+        policy = UART_TX_POLICY_TRUNCATE;
+    }
+
+    if (( UART_TX_POLICY_DROP == policy )
+     && ( count > ring_free( &tx_dma->ring )))
+    {
+        count = 0;
+    }
+
+    do
+    {
+        written += ring_write( &tx_dma->ring
+                             , &data[written]
+                             , count - written
+                             );
+
+        used = ring_count( &tx_dma->ring );
+
+        if ( used > tx_dma->hwm )
+        {
+            tx_dma->hwm = used;
+        }
+
+        primask = __get_PRIMASK();
+        __disable_irq();
+        uart_tx_dma_kick( tx_dma );
+        __set_PRIMASK( primask );
+
+    } while (( UART_TX_POLICY_BLOCK == policy ) && ( written < count ));
+
+    return (uint16_t) written;
+}
 
 static __INLINE void uart_putc( USART_TypeDef* uart, volatile char c )
 {
@@ -52,10 +290,46 @@ static __INLINE void uart_putc( USART_TypeDef* uart, volatile char c )
     }
 }
 
+static Uart_Rx_Dma_t* uart_get_rx_dma_hdl( USART_TypeDef* uart )
+{
+    Uart_Rx_Dma_t* rx_dma = NULL;
+
+#if ( UART1_RX_DMA_ENABLED != 0 )
+    if ( USART1 == uart )
+    {
+        rx_dma = &uart1_rx_dma;
+    }
+#endif
+#if ( UART2_RX_DMA_ENABLED != 0 )
+    if ( USART2 == uart )
+    {
+        rx_dma = &uart2_rx_dma;
+    }
+#endif
+
+    (void) uart;
+
+    return rx_dma;
+}
+
+/* Drop what an overrun left in the ring, the producer only flags it as
+ * dropping has to move the consumer index
+ */
+static void uart_rx_dma_resync( Uart_Rx_Dma_t* rx_dma )
+{
+    if (( NULL != rx_dma ) && ( FALSE != rx_dma->resync ))
+    {
+        rx_dma->resync = FALSE;
+        ring_flush( &rx_dma->buff->ring );
+    }
+}
+
 Buffer_t* uart_get_buff_hdl( USART_TypeDef* uart )
 {
     Buffer_t* buff = NULL;
 
+    uart_rx_dma_resync( uart_get_rx_dma_hdl( uart ));
+
     if ( USART1 == uart )
     {
         buff = &uart1_buffer;
@@ -68,6 +342,139 @@ Buffer_t* uart_get_buff_hdl( USART_TypeDef* uart )
     return buff;
 }
 
+/* Move the ring head up to the current DMA write position */
+static void uart_rx_dma_update( Uart_Rx_Dma_t* rx_dma )
+{
+    Ring_t*  ring = &rx_dma->buff->ring;
+    uint32_t head = ring->head;
+    uint32_t pos;
+    uint32_t delta;
+
+    pos   = ring_size( ring ) - __HAL_DMA_GET_COUNTER( &rx_dma->dma );
+    delta = ( pos - head ) & ring->mask;
+
+    if ( 0 != delta )
+    {
+        head += delta;
+
+        /* Consumer fell behind and DMA already overwrote unread data. The
+         * ring holds new and old bytes out of order, head stays on the DMA
+         * write position and the consumer drops it all, see
+         * uart_rx_dma_resync().
+         */
+        if (( head - RING_LOAD_ACQUIRE( &ring->tail )) > ring_size( ring ))
+        {
+            head  = RING_LOAD_ACQUIRE( &ring->tail );
+            head += ( pos - head ) & ring->mask;
+
+            rx_dma->resync = TRUE;
+            rx_dma->overrun++;
+        }
+
+        RING_STORE_RELEASE( &ring->head, head );
+    }
+}
+
+static void uart_rx_dma_xfer_cb( DMA_HandleTypeDef* dma )
+{
+    uart_rx_dma_update( (Uart_Rx_Dma_t*) dma->Parent );
+}
+
+static status_t uart_rx_dma_start( USART_TypeDef* uart )
+{
+    status_t          ret    = STATUS_OK;
+    HAL_StatusTypeDef hret;
+    IRQn_Type         dma_irqn;
+    Uart_Rx_Dma_t*    rx_dma;
+    Ring_t*           ring;
+
+    rx_dma = uart_get_rx_dma_hdl( uart );
+
+    if ( NULL != rx_dma )
+    {
+        ring = &rx_dma->buff->ring;
+
+        if ( DMA1_Channel5 == rx_dma->dma.Instance )
+        {
+            dma_irqn = DMA1_Channel5_IRQn;
+        }
+        else
+        {
+            dma_irqn = DMA1_Channel6_IRQn;
+        }
+
+        rx_dma->dma.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+        rx_dma->dma.Init.PeriphInc           = DMA_PINC_DISABLE;
+        rx_dma->dma.Init.MemInc              = DMA_MINC_ENABLE;
+        rx_dma->dma.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+        rx_dma->dma.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+        rx_dma->dma.Init.Mode                = DMA_CIRCULAR;
+        rx_dma->dma.Init.Priority            = DMA_PRIORITY_MEDIUM;
+
+        __HAL_RCC_DMA1_CLK_ENABLE();
+
+        hret = HAL_DMA_Init( &rx_dma->dma );
+
+        rx_dma->dma.Parent               = rx_dma;
+        rx_dma->dma.XferHalfCpltCallback = uart_rx_dma_xfer_cb;
+        rx_dma->dma.XferCpltCallback     = uart_rx_dma_xfer_cb;
+
+        ring->head      = 0;
+        ring->tail      = 0;
+        rx_dma->overrun = 0;
+        rx_dma->resync  = FALSE;
+
+        /* Same priority as the UART IRQ, see Uart_Rx_Dma_t */
+        HAL_NVIC_SetPriority( dma_irqn, 2, 1 );
+        HAL_NVIC_EnableIRQ( dma_irqn );
+
+        hret |= HAL_DMA_Start_IT( &rx_dma->dma
+                                , (uint32_t) &uart->DR
+                                , (uint32_t) ring->data
+                                , ring_size( ring )
+                                );
+
+        if ( HAL_OK != hret )
+        {
+            ret = STATUS_ERROR;
+        }
+        else
+        {
+            uart->CR3 |= USART_CR3_DMAR;
+            uart->CR1 |= USART_CR1_IDLEIE;
+        }
+    }
+    else
+    {
+        /* No DMA for this UART, fall back to interrupt per byte */
+        uart->CR1 |= USART_CR1_RXNEIE;
+    }
+
+    return ret;
+}
+
+static __INLINE void uart_rx_irq_hdl( USART_TypeDef* uart, Buffer_t* buff )
+{
+    uint32_t sr = uart->SR;
+
+    if ( 0 != ( uart->CR1 & USART_CR1_RXNEIE ))
+    {
+        /* Reading DR clears RXNE together with the error flags */
+        if ( 0 != ( sr & ( USART_SR_RXNE | USART_SR_ORE )))
+        {
+            (void) ring_put( &buff->ring, (uint8_t) UART_READ_DATA( uart ));
+            event_post(( USART1 == uart ) ? EVENT_UART1_RX : EVENT_UART2_RX );
+        }
+    }
+    else if ( 0 != ( sr & USART_SR_IDLE ))
+    {
+        /* SR read followed by DR read clears IDLE */
+        (void) UART_READ_DATA( uart );
+        uart_rx_dma_update( uart_get_rx_dma_hdl( uart ));
+        event_post(( USART1 == uart ) ? EVENT_UART1_RX : EVENT_UART2_RX );
+    }
+}
+
 static void uart_clear_all_flags( USART_TypeDef* uart, IRQn_Type irq )
 {
     UART_HandleTypeDef uart_hdl;
@@ -83,11 +490,6 @@ static void uart_clear_all_flags( USART_TypeDef* uart, IRQn_Type irq )
     HAL_NVIC_ClearPendingIRQ( irq );
 }
 
-static void uart_insert_to_buffer( Buffer_t* buff, uint8_t ch )
-{
-    buffer_write( buff, &ch, 1 );
-}
-
 status_t uart_init( USART_TypeDef* uart, uint32_t baudrate )
 {
     status_t           ret  = STATUS_OK;
@@ -130,8 +532,9 @@ status_t uart_init( USART_TypeDef* uart, uint32_t baudrate )
 
         uart_clear_all_flags( uart, irqn );
 
-        /* Enable RX interrupt */
-        uart->CR1 |= USART_CR1_RXNEIE;
+        /* Enable RX DMA or RX interrupt */
+        ret  = uart_rx_dma_start( uart );
+        ret |= uart_tx_dma_start( uart );
 
         /* Enable USART peripheral */
         uart->CR1 |= USART_CR1_UE;
@@ -143,26 +546,103 @@ status_t uart_init( USART_TypeDef* uart, uint32_t baudrate )
 
 void uart_puts( USART_TypeDef* uart, char* str )
 {
-    while ( *str )
+    uart_send( uart, (uint8_t*) str, strlen( str ));
+}
+
+void uart_send( USART_TypeDef* uart, uint8_t* data, uint16_t count )
+{
+    Uart_Tx_Dma_t* tx_dma;
+    uint16_t       written;
+
+    if ( 0 != ( uart->CR1 & USART_CR1_UE ))
     {
-        UART_WAIT(uart);
-        UART_WRITE_DATA(uart, (uint16_t)(*str));
-        UART_WAIT(uart);
+        tx_dma = uart_get_tx_dma_hdl( uart );
+
+        if ( NULL != tx_dma )
+        {
+            written = uart_tx_dma_write( tx_dma, data, count );
+            tx_dma->dropped += count - written;
+        }
+        else
+        {
+            while ( count > 0 )
+            {
+                uart_putc( uart, (char) *data );
 
-        str++;
+                data++;
+                count--;
+            }
+        }
     }
 }
 
-void uart_send( USART_TypeDef* uart, uint8_t* data, uint16_t count )
+void uart_flush( USART_TypeDef* uart )
 {
-    while ( count > 0 )
+    Uart_Tx_Dma_t* tx_dma;
+
+    tx_dma = uart_get_tx_dma_hdl( uart );
+
+    if (( NULL != tx_dma ) && ( 0 != ( uart->CR1 & USART_CR1_UE )))
     {
-        UART_WAIT(uart);
-        UART_WRITE_DATA(uart, (uint16_t)(*data));
-        UART_WAIT(uart);
+        /* DMA completion can't be awaited with interrupts masked */
+        if (( 0 == __get_PRIMASK()) && ( 0 == __get_IPSR()))
+        {
+            while (( 0 != ring_count( &tx_dma->ring ))
+                || ( 0 != tx_dma->xfer_len ))
+            {
+            }
+        }
+    }
 
-        data++;
-        count--;
+    /* Wait for the last frame to leave the shift register */
+    while ( 0 == ( uart->SR & USART_SR_TC ))
+    {
+    }
+}
+
+void uart_set_tx_policy( USART_TypeDef* uart, Uart_Tx_Policy_t policy )
+{
+    Uart_Tx_Dma_t* tx_dma;
+
+    tx_dma = uart_get_tx_dma_hdl( uart );
+
+    if ( NULL != tx_dma )
+    {
+        tx_dma->policy = policy;
+    }
+}
+
+void uart_get_tx_stats( USART_TypeDef* uart, Uart_Tx_Stats_t* stats )
+{
+    Uart_Tx_Dma_t* tx_dma;
+
+    tx_dma = uart_get_tx_dma_hdl( uart );
+
+    if ( NULL != stats )
+    {
+        memset( stats, 0, sizeof( Uart_Tx_Stats_t ));
+
+        if ( NULL != tx_dma )
+        {
+            stats->policy  = tx_dma->policy;
+            stats->size    = ring_size( &tx_dma->ring );
+            stats->pending = ring_count( &tx_dma->ring );
+            stats->dropped = tx_dma->dropped;
+            stats->hwm     = tx_dma->hwm;
+        }
+    }
+}
+
+void uart_reset_tx_stats( USART_TypeDef* uart )
+{
+    Uart_Tx_Dma_t* tx_dma;
+
+    tx_dma = uart_get_tx_dma_hdl( uart );
+
+    if ( NULL != tx_dma )
+    {
+        tx_dma->dropped = 0;
+        tx_dma->hwm     = 0;
     }
 }
 
@@ -206,6 +686,21 @@ int16_t uart_find_char( USART_TypeDef* uart, uint8_t ch )
     return ret;
 }
 
+uint32_t uart_get_spans( USART_TypeDef* uart, Ring_Span_t* span )
+{
+    return buffer_get_spans( uart_get_buff_hdl( uart ), span );
+}
+
+uint32_t uart_get_line( USART_TypeDef* uart, Ring_Span_t* span )
+{
+    return buffer_get_line( uart_get_buff_hdl( uart ), span );
+}
+
+void uart_skip( USART_TypeDef* uart, uint32_t count )
+{
+    (void) buffer_skip( uart_get_buff_hdl( uart ), count );
+}
+
 bool_t uart_buff_empty( USART_TypeDef* uart )
 {
     bool_t    ret = TRUE;
@@ -267,40 +762,127 @@ void uart_set_custom_string_delimiter( USART_TypeDef* uart, uint8_t delim )
     buffer_set_string_delimiter( buff, delim );
 }
 
+/* Polled for the same string while the answer trickles in, the matcher
+ * is kept and rebuilt only when UART or string change. Longer strings than
+ * the matcher takes are left to the plain scan of buffer_find().
+ */
 int16_t uart_find_string( USART_TypeDef* uart, char* str )
+{
+    static Match_t        match;
+    static USART_TypeDef* match_uart = NULL;
+    static char           match_str[MATCH_NODE_MAX];
+
+    int16_t     ret = -1;
+    const void* pat = match_str;
+    uint8_t     len;
+
+    len = (uint8_t) strnlen( str, MATCH_NODE_MAX );
+
+    if ( len >= MATCH_NODE_MAX )
+    {
+        ret = (int16_t) buffer_find( uart_get_buff_hdl( uart )
+                                   , str
+                                   , strnlen( str, UART_BUFFER_SIZE )
+                                   );
+    }
+    else
+    {
+        if (( uart != match_uart )
+         || ( 0 != strncmp( str, match_str, MATCH_NODE_MAX )))
+        {
+            match_uart = NULL;
+
+            memcpy( match_str, str, len + 1 );
+
+            if ( STATUS_OK == match_init( &match, &pat, &len, 1 ))
+            {
+                match_uart = uart;
+            }
+        }
+
+        if ( uart == match_uart )
+        {
+            ret = uart_match( uart, &match, NULL );
+        }
+    }
+
+    return ret;
+}
+
+int16_t uart_match( USART_TypeDef* uart, Match_t* match, int8_t* id )
 {
     int16_t   ret;
     Buffer_t* buff;
 
     buff = uart_get_buff_hdl( uart );
-    ret  = (int16_t) buffer_find( buff
-                                , (uint8_t*) str
-                                , strnlen( str, UART_BUFFER_SIZE )
-                                );
+    ret  = (int16_t) buffer_match( buff, match, id );
 
     return ret;
 }
 
 void USART2_IRQHandler( void )
 {
-    /* Check if interrupt occurred because data is received */
-    if ( 0 != ( USART2->SR & USART_SR_RXNE ))
-    {
-        uart_insert_to_buffer( &uart2_buffer, UART_READ_DATA( USART2 ));
-    }
-
-    uart_clear_all_flags( USART2, USART2_IRQn );
+    PROF_BEGIN( PROF_UART2_IRQ );
+    TRACE_BEGIN( TRACE_UART2_IRQ, 0 );
+    uart_rx_irq_hdl( USART2, &uart2_buffer );
+    TRACE_END( TRACE_UART2_IRQ, 0 );
+    PROF_END( PROF_UART2_IRQ );
 }
 
 void USART1_IRQHandler( void )
 {
-    /* Check if interrupt occurred because data is received */
-    if ( 0 != ( USART1->SR & USART_SR_RXNE ))
+    PROF_BEGIN( PROF_UART1_IRQ );
+    TRACE_BEGIN( TRACE_UART1_IRQ, 0 );
+    uart_rx_irq_hdl( USART1, &uart1_buffer );
+    TRACE_END( TRACE_UART1_IRQ, 0 );
+    PROF_END( PROF_UART1_IRQ );
+}
+
+void dma1_ch4_irq_hdl( void )
+{
+#if ( UART1_TX_DMA_ENABLED != 0 )
+    PROF_BEGIN( PROF_UART1_TX );
+    TRACE_BEGIN( TRACE_UART1_TX, 0 );
+    HAL_DMA_IRQHandler( &uart1_tx_dma.dma );
+    TRACE_END( TRACE_UART1_TX, 0 );
+    PROF_END( PROF_UART1_TX );
+#endif
+}
+
+void dma1_ch5_irq_hdl( void )
+{
+#if ( UART1_RX_DMA_ENABLED != 0 )
+    HAL_DMA_IRQHandler( &uart1_rx_dma.dma );
+#endif
+}
+
+void dma1_ch6_irq_hdl( void )
+{
+#if ( UART2_RX_DMA_ENABLED != 0 )
+    HAL_DMA_IRQHandler( &uart2_rx_dma.dma );
+#endif
+}
+
+uint32_t uart_get_rx_overrun( USART_TypeDef* uart )
+{
+    uint32_t       ret    = 0;
+    Uart_Rx_Dma_t* rx_dma;
+
+    rx_dma = uart_get_rx_dma_hdl( uart );
+
+    if ( NULL != rx_dma )
     {
-        uart_insert_to_buffer( &uart1_buffer, UART_READ_DATA( USART1 ));
+        ret = rx_dma->overrun;
     }
 
-    uart_clear_all_flags( USART1, USART1_IRQn );
+    return ret;
+}
+
+void dma1_ch7_irq_hdl( void )
+{
+#if ( UART2_TX_DMA_ENABLED != 0 )
+    HAL_DMA_IRQHandler( &uart2_tx_dma.dma );
+#endif
 }
 
 void HAL_UART_MspInit( UART_HandleTypeDef* huart )
@@ -343,6 +925,15 @@ void HAL_UART_MspInit( UART_HandleTypeDef* huart )
 
 PUTCHAR_PROTOTYPE
 {
-    uart_putc( UART_TO_PC, ch );
+    uint8_t c = (uint8_t) ch;
+
+    uart_send( UART_TO_PC, &c, 1 );
     return ch;
 }
+
+/* Whole stdout chunks, so the full buffer policy applies per message */
+int __io_write( char* ptr, int len )
+{
+    uart_send( UART_TO_PC, (uint8_t*) ptr, (uint16_t) len );
+    return len;
+}
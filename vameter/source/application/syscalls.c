@@ -11,6 +11,7 @@
 extern int errno;
 extern int __io_putchar(int ch) __attribute__((weak));
 extern int __io_getchar(void) __attribute__((weak));
+extern int __io_write(char *ptr, int len) __attribute__((weak));
 
 register char * stack_ptr asm("sp");
 
@@ -54,6 +55,11 @@ int _write(int file, char *ptr, int len)
 {
     int DataIdx;
 
+    if (__io_write)
+    {
+        return __io_write(ptr, len);
+    }
+
     for (DataIdx = 0; DataIdx < len; DataIdx++)
     {
        __io_putchar( *ptr++ );
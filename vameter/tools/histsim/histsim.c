@@ -0,0 +1,326 @@
+/**
+ ** Name
+ **   histsim.c
+ **
+ ** Purpose
+ **   Host simulation of the measurement history capacity under load models
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Half word programming, power down recovery
+ **/
+
+#include "adc.h"
+#include "event.h"
+#include "hist.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HISTSIM_DAYS_MAX (120)      /* Simulated time limit per load */
+#define HISTSIM_WRAPS    (2)        /* Ring passes before measuring */
+#define HISTSIM_DOWN_S   (3 * 3600) /* Power down at most this far in */
+
+/* Counts of the nominal front end, see adc.h */
+#define HISTSIM_MV_COUNT ( ADC_V_SCALE_UV / 1000.0 )
+#define HISTSIM_MA_COUNT ( ADC_I_SCALE_UA / 1000.0 )
+
+typedef struct
+{
+    const char* name;
+    double      noise;          /* Reading noise, ADC counts rms */
+    uint32_t    step_min;       /* Load step interval, s, 0 is none */
+    uint32_t    step_max;
+    double      drift;          /* Voltage swing over 10 min, mV */
+} Histsim_Load_t;
+
+/* Window readings of a 12 V supply at 1.5 A */
+static const Histsim_Load_t histsim_load[] =
+{
+    { "steady, 1 count noise",          1.0, 0,  0,   0.0   },
+    { "noisy, 3 counts noise",          3.0, 0,  0,   0.0   },
+    { "noisy, 200 mV drift",            3.0, 0,  0,   200.0 },
+    { "noisy, load steps 30..300 s",    3.0, 30, 300, 200.0 },
+    { "noisy, load steps 5..30 s",      3.0, 5,  30,  200.0 }
+};
+
+#define HISTSIM_LOAD_NUM ( sizeof( histsim_load ) / sizeof( histsim_load[0] ))
+
+static uint8_t  histsim_flash[HIST_PAGES * HIST_BLOCK_SIZE]
+                __attribute__(( aligned( 4 )));
+uint32_t        histsim_addr;
+
+static Time_t   histsim_time;
+static uint64_t histsim_rng = 88172645463325252ULL;
+static double   histsim_mv;
+static double   histsim_ma;
+static double   histsim_amps;
+static uint64_t histsim_next_step;
+
+/* Flash model, a half word is programmed once per erase like the real one,
+ * the word type programs two of them
+ */
+HAL_StatusTypeDef HAL_FLASH_Unlock( void )
+{
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock( void )
+{
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase( FLASH_EraseInitTypeDef* erase
+                                   , uint32_t*               page_error
+                                   )
+{
+    memset( &histsim_flash[erase->PageAddress - histsim_addr]
+          , 0xFF
+          , erase->NbPages * FLASH_PAGE_SIZE
+          );
+    *page_error = 0xFFFFFFFF;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program( uint32_t type
+                                   , uint32_t address
+                                   , uint64_t data
+                                   )
+{
+    uint16_t*         half = (uint16_t*) &histsim_flash[address - histsim_addr];
+    uint32_t          n    = ( FLASH_TYPEPROGRAM_WORD == type ) ? 2 : 1;
+    HAL_StatusTypeDef ret  = HAL_OK;
+    uint32_t          i;
+
+    for ( i = 0; i < n; i++ )
+    {
+        if ( 0xFFFF != half[i] )
+        {
+            ret = HAL_ERROR;
+        }
+
+        half[i] &= (uint16_t)( data >> ( 16 * i ));
+    }
+
+    return ret;
+}
+
+/* No settings log, the period is set by the simulation */
+status_t flash_read( void* buff, uint32_t size, uint32_t offset )
+{
+    (void) buff;
+    (void) size;
+    (void) offset;
+
+    return STATUS_ERROR;
+}
+
+status_t flash_write( void* buff, uint32_t size, uint32_t offset )
+{
+    (void) buff;
+    (void) size;
+    (void) offset;
+
+    return STATUS_OK;
+}
+
+void get_time( Time_t* tv )
+{
+    *tv = histsim_time;
+}
+
+uint32_t adc_get_milli( uint8_t ch )
+{
+    return (uint32_t)(( ADC_CH_V == ch ) ? histsim_mv : histsim_ma );
+}
+
+void adc_get_power( Adc_Power_t* power )
+{
+    memset( power, 0, sizeof( Adc_Power_t ));
+    power->p = (int32_t)( histsim_mv * histsim_ma / 1000.0 );
+}
+
+static double histsim_uniform( void )
+{
+    histsim_rng ^= histsim_rng << 13;
+    histsim_rng ^= histsim_rng >> 7;
+    histsim_rng ^= histsim_rng << 17;
+
+    return (double)( histsim_rng >> 11 ) / 9007199254740992.0;
+}
+
+static double histsim_gauss( void )
+{
+    const double u = histsim_uniform() + 1e-12;
+
+    return sqrt( -2.0 * log( u ))
+         * cos( 2.0 * M_PI * histsim_uniform());
+}
+
+/* Payload bytes and samples of the blocks in flash */
+static void histsim_count( uint64_t* bytes, uint64_t* samples )
+{
+    const Hist_Blk_Hdr_t* hdr;
+    uint32_t              page;
+
+    *bytes   = 0;
+    *samples = 0;
+
+    for ( page = 0; page < HIST_PAGES; page++ )
+    {
+        hdr = (const Hist_Blk_Hdr_t*) &histsim_flash[page * HIST_BLOCK_SIZE];
+
+        if ( HIST_MAGIC == hdr->magic )
+        {
+            *bytes   += hdr->len;
+            *samples += hdr->count;
+        }
+    }
+}
+
+/* Readings of the load model at tick, then one hist_tick() */
+static void histsim_tick( const Histsim_Load_t* load, uint64_t tick )
+{
+    const double secs = (double) tick * EVENT_TICK_MS / 1000.0;
+
+    if (( 0 != load->step_max ) && ( secs >= (double) histsim_next_step ))
+    {
+        histsim_amps       = 200.0 + 4800.0 * histsim_uniform();
+        histsim_next_step += load->step_min
+                           + (uint64_t)(( load->step_max - load->step_min )
+                                        * histsim_uniform());
+    }
+
+    histsim_mv = 12000.0
+               + load->drift * sin( 2.0 * M_PI * secs / 600.0 )
+               + load->noise * HISTSIM_MV_COUNT * histsim_gauss();
+    histsim_ma = histsim_amps
+               + load->noise * HISTSIM_MA_COUNT * histsim_gauss();
+
+    histsim_time = (Time_t) tick * EVENT_TICK_MS * 1000;
+    hist_tick();
+}
+
+/* Keep sampling for a while, then power down without closing the block.
+ * Returns the samples missing after the next hist_init().
+ */
+static uint32_t histsim_down( const Histsim_Load_t* load, uint64_t tick )
+{
+    const uint64_t end = tick
+                       + (uint64_t)( HISTSIM_DOWN_S * histsim_uniform())
+                       * ( 1000 / EVENT_TICK_MS );
+    Hist_Stats_t   stats;
+    uint32_t       samples;
+
+    hist_get_stats( &stats );
+
+    for ( ; ( tick < end ) && ( 0 != stats.open_bytes ); tick++ )
+    {
+        histsim_tick( load, tick );
+        hist_get_stats( &stats );
+    }
+
+    samples = stats.samples;
+    (void) hist_init();
+    hist_get_stats( &stats );
+
+    if ( 0 != stats.flash_errors )
+    {
+        fprintf( stderr, "histsim: flash errors\n" );
+        exit( EXIT_FAILURE );
+    }
+
+    return samples - stats.samples;
+}
+
+static void histsim_run( const Histsim_Load_t* load, uint32_t period )
+{
+    const uint64_t tick_max = (uint64_t) HISTSIM_DAYS_MAX * 86400
+                            * ( 1000 / EVENT_TICK_MS );
+    Hist_Stats_t   stats;
+    uint64_t       tick;
+    uint64_t       bytes;
+    uint64_t       samples;
+    double         hours;
+    double         kept;
+    uint32_t       lost;
+
+    memset( histsim_flash, 0xFF, sizeof( histsim_flash ));
+    histsim_time      = 0;
+    histsim_amps      = 1500.0;
+    histsim_next_step = 0;
+    (void) hist_init();
+    (void) hist_set_period( period );
+
+    for ( tick = 0; tick < tick_max; tick++ )
+    {
+        histsim_tick( load, tick );
+        hist_get_stats( &stats );
+
+        if ( stats.seq >= ( HISTSIM_WRAPS * HIST_PAGES ))
+        {
+            break;
+        }
+    }
+
+    histsim_count( &bytes, &samples );
+    lost = histsim_down( load, tick );
+
+    /* Samples kept once the ring wrapped, extrapolated from the bytes per
+     * sample otherwise
+     */
+    if ( tick < tick_max )
+    {
+        hours = (double) samples * period / 3600000.0;
+    }
+    else
+    {
+        /* Blocks close at 0xFFFF samples whatever their size */
+        kept  = (double) HIST_PAGES * HIST_PAYLOAD_SIZE * samples / bytes;
+        kept  = ( kept > HIST_PAGES * 65535.0 ) ? HIST_PAGES * 65535.0 : kept;
+        hours = kept * period / 3600000.0;
+    }
+
+    printf( "%-30s %3u s %6.3f B/sample %8.1f h %6.1f days %5u s lost%s\n"
+          , load->name
+          , (unsigned) ( period / 1000 )
+          , ( 0 == samples ) ? 0.0 : (double) bytes / (double) samples
+          , hours
+          , hours / 24.0
+          , (unsigned)( lost * ( period / 1000 ))
+          , ( tick < tick_max ) ? "" : " (extrapolated)"
+          );
+}
+
+int main( void )
+{
+    static const uint32_t period[] = { 1000, 10000 };
+    uint32_t              i;
+    uint32_t              n;
+
+    histsim_addr = (uint32_t)(uintptr_t) histsim_flash;
+
+    if ((uintptr_t) histsim_addr != (uintptr_t) histsim_flash )
+    {
+        fprintf( stderr, "histsim: flash model above 4 GB, link -no-pie\n" );
+        return EXIT_FAILURE;
+    }
+
+    printf( "%u pages of %u payload bytes, load, period, retained\n"
+          , (unsigned) HIST_PAGES
+          , (unsigned) HIST_PAYLOAD_SIZE
+          );
+
+    for ( n = 0; n < ( sizeof( period ) / sizeof( period[0] )); n++ )
+    {
+        for ( i = 0; i < HISTSIM_LOAD_NUM; i++ )
+        {
+            histsim_run( &histsim_load[i], period[n] );
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,57 @@
+/**
+ ** Name
+ **   stm32f1xx_hal.h
+ **
+ ** Purpose
+ **   Host replacement of the HAL subset used by the measurement history
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Half word programming
+ **/
+
+#ifndef __STM32F1XX_HAL_H__
+#define __STM32F1XX_HAL_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define __IO     volatile
+#define __INLINE inline
+
+typedef enum
+{
+    HAL_OK = 0,
+    HAL_ERROR,
+    HAL_BUSY,
+    HAL_TIMEOUT
+} HAL_StatusTypeDef;
+
+/* Flash */
+#define FLASH_PAGE_SIZE        (0x400)
+#define FLASH_TYPEERASE_PAGES  (0x00)
+#define FLASH_TYPEPROGRAM_HALFWORD (0x01)
+#define FLASH_TYPEPROGRAM_WORD     (0x02)
+
+typedef struct
+{
+    uint32_t TypeErase;
+    uint32_t Banks;
+    uint32_t PageAddress;
+    uint32_t NbPages;
+} FLASH_EraseInitTypeDef;
+
+HAL_StatusTypeDef HAL_FLASH_Unlock( void );
+HAL_StatusTypeDef HAL_FLASH_Lock( void );
+HAL_StatusTypeDef HAL_FLASHEx_Erase( FLASH_EraseInitTypeDef* erase
+                                   , uint32_t*               page_error
+                                   );
+HAL_StatusTypeDef HAL_FLASH_Program( uint32_t type
+                                   , uint32_t address
+                                   , uint64_t data
+                                   );
+
+/* History pages live in a host array, see histsim.c */
+extern uint32_t histsim_addr;
+
+#endif /* __STM32F1XX_HAL_H__ */
@@ -0,0 +1,178 @@
+/**
+ ** Name
+ **   hal_host.c
+ **
+ ** Purpose
+ **   Host HAL routing the PCD8544 pins and SPI/DMA traffic to the model
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] HAL call counters
+ **/
+
+#include "hal_host.h"
+
+#include "pcd8544.h"
+#include "tim.h"
+
+#include <time.h>
+
+/* Any DR value above a byte means nothing pending */
+#define HAL_HOST_DR_IDLE (0xFFFFFFFFu)
+
+GPIO_TypeDef        host_gpioa;
+GPIO_TypeDef        host_gpiob;
+DMA_Channel_TypeDef host_dma1_ch5;
+
+Lcd_Model_t      hal_host_lcd;
+uint32_t         hal_host_spi_bytes;
+Hal_Host_Calls_t hal_host_calls;
+
+static SPI_TypeDef hal_host_spi = { .SR = SPI_SR_TXE, .DR = HAL_HOST_DR_IDLE };
+
+extern void HAL_SPI_MspInit( SPI_HandleTypeDef* spi_hdl );
+
+static bool_t hal_host_pin( GPIO_TypeDef* port, uint16_t pin )
+{
+    return ( 0 != ( port->ODR & pin ));
+}
+
+/* A byte reaches the controller only while it is selected */
+static void hal_host_spi_byte( uint8_t byte )
+{
+    hal_host_spi_bytes++;
+
+    if ( FALSE == hal_host_pin( PCD8544_CS_PORT, PCD8544_CS_PIN ))
+    {
+        lcd_model_write( &hal_host_lcd
+                       , hal_host_pin( PCD8544_DC_PORT, PCD8544_DC_PIN )
+                       , byte
+                       );
+    }
+}
+
+SPI_TypeDef* host_spi2( void )
+{
+    /* Collect a direct register write before it is overwritten */
+    if ( HAL_HOST_DR_IDLE != hal_host_spi.DR )
+    {
+        hal_host_spi_byte( (uint8_t) hal_host_spi.DR );
+        hal_host_spi.DR = HAL_HOST_DR_IDLE;
+    }
+
+    return &hal_host_spi;
+}
+
+void HAL_GPIO_Init( GPIO_TypeDef* port, GPIO_InitTypeDef* init )
+{
+    (void) port;
+    (void) init;
+}
+
+void HAL_GPIO_WritePin( GPIO_TypeDef* port, uint16_t pin, GPIO_PinState state )
+{
+    bool_t rst_low;
+
+    (void) host_spi2();
+    hal_host_calls.gpio++;
+
+    rst_low = (( PCD8544_RST_PORT == port )
+            && ( PCD8544_RST_PIN == pin )
+            && ( FALSE == hal_host_pin( port, pin )));
+
+    if ( GPIO_PIN_RESET != state )
+    {
+        port->ODR |= pin;
+
+        if ( FALSE != rst_low )
+        {
+            lcd_model_reset( &hal_host_lcd );
+        }
+    }
+    else
+    {
+        port->ODR &= ~(uint32_t) pin;
+    }
+}
+
+HAL_StatusTypeDef HAL_SPI_Init( SPI_HandleTypeDef* hspi )
+{
+    HAL_SPI_MspInit( hspi );
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit( SPI_HandleTypeDef* hspi
+                                  , uint8_t*           data
+                                  , uint16_t           size
+                                  , uint32_t           timeout
+                                  )
+{
+    (void) hspi;
+    (void) timeout;
+
+    hal_host_calls.spi++;
+
+    while ( size-- > 0 )
+    {
+        hal_host_spi_byte( *data++ );
+    }
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Init( DMA_HandleTypeDef* hdma )
+{
+    (void) hdma;
+
+    return HAL_OK;
+}
+
+/* The transfer completes at once, the completion callback runs nested */
+HAL_StatusTypeDef HAL_DMA_Start_IT( DMA_HandleTypeDef* hdma
+                                  , uint32_t           src
+                                  , uint32_t           dst
+                                  , uint32_t           len
+                                  )
+{
+    HAL_StatusTypeDef ret = HAL_ERROR;
+    const uint8_t*    data = (const uint8_t*)(uintptr_t) src;
+
+    hal_host_calls.dma++;
+
+    if ( (uint32_t)(uintptr_t) &hal_host_spi.DR == dst )
+    {
+        while ( len-- > 0 )
+        {
+            hal_host_spi_byte( *data++ );
+        }
+
+        ret = HAL_OK;
+
+        if ( NULL != hdma->XferCpltCallback )
+        {
+            hdma->XferCpltCallback( hdma );
+        }
+    }
+
+    return ret;
+}
+
+void HAL_DMA_IRQHandler( DMA_HandleTypeDef* hdma )
+{
+    (void) hdma;
+}
+
+void HAL_Delay( uint32_t ms )
+{
+    (void) ms;
+}
+
+void get_time( Time_t* tv )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    *tv = (Time_t) ts.tv_sec * 1000000 + (Time_t) ts.tv_nsec / 1000;
+}
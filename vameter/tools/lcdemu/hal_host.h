@@ -0,0 +1,37 @@
+/**
+ ** Name
+ **   hal_host.h
+ **
+ ** Purpose
+ **   Host HAL routing the PCD8544 pins and SPI/DMA traffic to the model
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] HAL call counters
+ **/
+
+#ifndef __HAL_HOST_H__
+#define __HAL_HOST_H__
+
+#include "ptypes.h"
+#include "lcd_model.h"
+
+#include <stm32f1xx_hal.h>
+
+/* Controller on the far side of SPI2 */
+extern Lcd_Model_t hal_host_lcd;
+
+/* All bytes clocked out on SPI2, selected or not */
+extern uint32_t hal_host_spi_bytes;
+
+/* HAL calls made by the driver, each one costs CPU time on the target */
+typedef struct
+{
+    uint32_t gpio;              /* HAL_GPIO_WritePin() */
+    uint32_t spi;               /* HAL_SPI_Transmit() */
+    uint32_t dma;               /* HAL_DMA_Start_IT(), one interrupt each */
+} Hal_Host_Calls_t;
+
+extern Hal_Host_Calls_t hal_host_calls;
+
+#endif /* __HAL_HOST_H__ */
@@ -0,0 +1,204 @@
+/**
+ ** Name
+ **   stm32f1xx_hal.h
+ **
+ ** Purpose
+ **   Host replacement of the HAL subset used by the PCD8544 driver
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#ifndef __STM32F1XX_HAL_H__
+#define __STM32F1XX_HAL_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define __IO     volatile
+#define __INLINE inline
+
+typedef enum
+{
+    HAL_OK = 0,
+    HAL_ERROR,
+    HAL_BUSY,
+    HAL_TIMEOUT
+} HAL_StatusTypeDef;
+
+typedef enum
+{
+    DMA1_Channel5_IRQn = 15
+} IRQn_Type;
+
+/* GPIO */
+typedef struct
+{
+    __IO uint32_t ODR;
+} GPIO_TypeDef;
+
+typedef struct
+{
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+} GPIO_InitTypeDef;
+
+typedef enum
+{
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+extern GPIO_TypeDef host_gpioa;
+extern GPIO_TypeDef host_gpiob;
+
+#define GPIOA (&host_gpioa)
+#define GPIOB (&host_gpiob)
+
+#define GPIO_PIN_4  ((uint16_t) 0x0010)
+#define GPIO_PIN_5  ((uint16_t) 0x0020)
+#define GPIO_PIN_12 ((uint16_t) 0x1000)
+#define GPIO_PIN_13 ((uint16_t) 0x2000)
+#define GPIO_PIN_14 ((uint16_t) 0x4000)
+#define GPIO_PIN_15 ((uint16_t) 0x8000)
+
+#define GPIO_MODE_INPUT       0
+#define GPIO_MODE_OUTPUT_PP   1
+#define GPIO_MODE_AF_PP       2
+#define GPIO_NOPULL           0
+#define GPIO_SPEED_FREQ_LOW   2
+#define GPIO_SPEED_FREQ_HIGH  3
+
+void HAL_GPIO_Init( GPIO_TypeDef* port, GPIO_InitTypeDef* init );
+void HAL_GPIO_WritePin( GPIO_TypeDef* port, uint16_t pin, GPIO_PinState state );
+
+/* USART, only referenced by declarations */
+typedef struct
+{
+    __IO uint32_t SR;
+    __IO uint32_t DR;
+} USART_TypeDef;
+
+/* DMA */
+typedef struct
+{
+    __IO uint32_t CCR;
+    __IO uint32_t CNDTR;
+    __IO uint32_t CPAR;
+    __IO uint32_t CMAR;
+} DMA_Channel_TypeDef;
+
+typedef struct
+{
+    uint32_t Direction;
+    uint32_t PeriphInc;
+    uint32_t MemInc;
+    uint32_t PeriphDataAlignment;
+    uint32_t MemDataAlignment;
+    uint32_t Mode;
+    uint32_t Priority;
+} DMA_InitTypeDef;
+
+typedef struct __DMA_HandleTypeDef
+{
+    DMA_Channel_TypeDef* Instance;
+    DMA_InitTypeDef      Init;
+    void*                Parent;
+    void (*XferCpltCallback)( struct __DMA_HandleTypeDef* hdma );
+    void (*XferErrorCallback)( struct __DMA_HandleTypeDef* hdma );
+} DMA_HandleTypeDef;
+
+extern DMA_Channel_TypeDef host_dma1_ch5;
+
+#define DMA1_Channel5 (&host_dma1_ch5)
+
+#define DMA_MEMORY_TO_PERIPH 1
+#define DMA_PINC_DISABLE     0
+#define DMA_MINC_ENABLE      1
+#define DMA_PDATAALIGN_BYTE  0
+#define DMA_MDATAALIGN_BYTE  0
+#define DMA_NORMAL           0
+#define DMA_PRIORITY_LOW     0
+
+HAL_StatusTypeDef HAL_DMA_Init( DMA_HandleTypeDef* hdma );
+HAL_StatusTypeDef HAL_DMA_Start_IT( DMA_HandleTypeDef* hdma
+                                  , uint32_t           src
+                                  , uint32_t           dst
+                                  , uint32_t           len
+                                  );
+void HAL_DMA_IRQHandler( DMA_HandleTypeDef* hdma );
+
+/* SPI, every access through SPI2 lets the host model collect a byte
+ * written to DR since the previous access.
+ */
+typedef struct
+{
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t SR;
+    __IO uint32_t DR;
+} SPI_TypeDef;
+
+typedef struct
+{
+    uint32_t Mode;
+    uint32_t Direction;
+    uint32_t DataSize;
+    uint32_t CLKPolarity;
+    uint32_t CLKPhase;
+    uint32_t NSS;
+    uint32_t BaudRatePrescaler;
+    uint32_t FirstBit;
+    uint32_t TIMode;
+    uint32_t CRCCalculation;
+    uint32_t CRCPolynomial;
+} SPI_InitTypeDef;
+
+typedef struct
+{
+    SPI_TypeDef*    Instance;
+    SPI_InitTypeDef Init;
+} SPI_HandleTypeDef;
+
+SPI_TypeDef* host_spi2( void );
+
+#define SPI2 (host_spi2())
+
+#define SPI_MODE_MASTER            1
+#define SPI_DIRECTION_2LINES       0
+#define SPI_DATASIZE_8BIT          0
+#define SPI_POLARITY_LOW           0
+#define SPI_PHASE_1EDGE            0
+#define SPI_NSS_SOFT               1
+#define SPI_BAUDRATEPRESCALER_8    2
+#define SPI_FIRSTBIT_MSB           0
+#define SPI_TIMODE_DISABLE         0
+#define SPI_CRCCALCULATION_DISABLE 0
+
+#define SPI_SR_TXE      0x0002u
+#define SPI_SR_BSY      0x0080u
+#define SPI_CR2_TXDMAEN 0x0002u
+
+#define __HAL_SPI_ENABLE(h) ((h)->Instance->CR1 |= 0x0040u)
+
+HAL_StatusTypeDef HAL_SPI_Init( SPI_HandleTypeDef* hspi );
+HAL_StatusTypeDef HAL_SPI_Transmit( SPI_HandleTypeDef* hspi
+                                  , uint8_t*           data
+                                  , uint16_t           size
+                                  , uint32_t           timeout
+                                  );
+
+/* Clocks, NVIC and delays have no host counterpart */
+#define __HAL_RCC_GPIOA_CLK_ENABLE() do { } while ( 0 )
+#define __HAL_RCC_GPIOB_CLK_ENABLE() do { } while ( 0 )
+#define __HAL_RCC_SPI2_CLK_ENABLE()  do { } while ( 0 )
+#define __HAL_RCC_DMA1_CLK_ENABLE()  do { } while ( 0 )
+
+#define HAL_NVIC_SetPriority(irq, pre, sub) do { } while ( 0 )
+#define HAL_NVIC_EnableIRQ(irq)             do { } while ( 0 )
+
+void HAL_Delay( uint32_t ms );
+
+#endif /* __STM32F1XX_HAL_H__ */
@@ -0,0 +1,202 @@
+/**
+ ** Name
+ **   lcd_model.c
+ **
+ ** Purpose
+ **   PCD8544 controller model
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "lcd_model.h"
+
+#include <stdio.h>
+
+static void lcd_model_cmd( Lcd_Model_t* lcd, uint8_t cmd )
+{
+    if ( 0x20 == ( cmd & 0xF8 ))
+    {
+        /* Function set, valid in both instruction sets */
+        lcd->pd = ( 0 != ( cmd & 0x04 ));
+        lcd->v  = ( 0 != ( cmd & 0x02 ));
+        lcd->h  = ( 0 != ( cmd & 0x01 ));
+    }
+    else if ( 0x00 == cmd )
+    {
+        /* NOP */
+    }
+    else if ( FALSE == lcd->h )
+    {
+        if ( 0 != ( cmd & 0x80 ))
+        {
+            if (( cmd & 0x7F ) < LCD_MODEL_WIDTH )
+            {
+                lcd->x = cmd & 0x7F;
+            }
+            else
+            {
+                lcd->bad_cmds++;
+            }
+        }
+        else if ( 0x40 == ( cmd & 0xC0 ))
+        {
+            if (( cmd & 0x07 ) < LCD_MODEL_PAGES )
+            {
+                lcd->y = cmd & 0x07;
+            }
+            else
+            {
+                lcd->bad_cmds++;
+            }
+        }
+        else if ( 0x08 == ( cmd & 0xF8 ))
+        {
+            /* D and E bits */
+            switch ( cmd & 0x05 )
+            {
+                case 0x00: lcd->disp = LCD_MODEL_DISP_BLANK;    break;
+                case 0x01: lcd->disp = LCD_MODEL_DISP_ALL_ON;   break;
+                case 0x04: lcd->disp = LCD_MODEL_DISP_NORMAL;   break;
+                default:   lcd->disp = LCD_MODEL_DISP_INVERTED; break;
+            }
+        }
+        else
+        {
+            lcd->bad_cmds++;
+        }
+    }
+    else
+    {
+        if ( 0 != ( cmd & 0x80 ))
+        {
+            lcd->vop = cmd & 0x7F;
+        }
+        else if ( 0x10 == ( cmd & 0xF8 ))
+        {
+            lcd->bias = cmd & 0x07;
+        }
+        else if ( 0x04 == ( cmd & 0xFC ))
+        {
+            lcd->temp = cmd & 0x03;
+        }
+        else
+        {
+            lcd->bad_cmds++;
+        }
+    }
+}
+
+static void lcd_model_data( Lcd_Model_t* lcd, uint8_t data )
+{
+    lcd->ram[lcd->y][lcd->x] = data;
+
+    if ( FALSE == lcd->v )
+    {
+        if ( ++lcd->x >= LCD_MODEL_WIDTH )
+        {
+            lcd->x = 0;
+
+            if ( ++lcd->y >= LCD_MODEL_PAGES )
+            {
+                lcd->y = 0;
+            }
+        }
+    }
+    else
+    {
+        if ( ++lcd->y >= LCD_MODEL_PAGES )
+        {
+            lcd->y = 0;
+
+            if ( ++lcd->x >= LCD_MODEL_WIDTH )
+            {
+                lcd->x = 0;
+            }
+        }
+    }
+}
+
+void lcd_model_reset( Lcd_Model_t* lcd )
+{
+    /* RAM content is undefined after reset, keep whatever was there */
+    lcd->x          = 0;
+    lcd->y          = 0;
+    lcd->pd         = TRUE;
+    lcd->v          = FALSE;
+    lcd->h          = FALSE;
+    lcd->disp       = LCD_MODEL_DISP_BLANK;
+    lcd->vop        = 0;
+    lcd->bias       = 0;
+    lcd->temp       = 0;
+    lcd->cmd_bytes  = 0;
+    lcd->data_bytes = 0;
+    lcd->bad_cmds   = 0;
+}
+
+void lcd_model_write( Lcd_Model_t* lcd, bool_t data, uint8_t byte )
+{
+    if ( FALSE != data )
+    {
+        lcd->data_bytes++;
+        lcd_model_data( lcd, byte );
+    }
+    else
+    {
+        lcd->cmd_bytes++;
+        lcd_model_cmd( lcd, byte );
+    }
+}
+
+bool_t lcd_model_pixel( const Lcd_Model_t* lcd, uint8_t x, uint8_t y )
+{
+    bool_t on = FALSE;
+
+    if (( FALSE == lcd->pd )
+     && ( x < LCD_MODEL_WIDTH )
+     && ( y < LCD_MODEL_HEIGHT ))
+    {
+        on = ( 0 != ( lcd->ram[y / 8][x] & ( 1 << ( y % 8 ))));
+
+        switch ( lcd->disp )
+        {
+            case LCD_MODEL_DISP_BLANK:    on = FALSE; break;
+            case LCD_MODEL_DISP_ALL_ON:   on = TRUE;  break;
+            case LCD_MODEL_DISP_INVERTED: on = !on;   break;
+            default:                                  break;
+        }
+    }
+
+    return on;
+}
+
+status_t lcd_model_save_pbm( const Lcd_Model_t* lcd, const char* path )
+{
+    status_t ret = STATUS_ERROR;
+    FILE*    fp;
+    uint8_t  x;
+    uint8_t  y;
+
+    fp = fopen( path, "w" );
+
+    if ( NULL != fp )
+    {
+        fprintf( fp, "P1\n%u %u\n", LCD_MODEL_WIDTH, LCD_MODEL_HEIGHT );
+
+        for ( y = 0; y < LCD_MODEL_HEIGHT; y++ )
+        {
+            for ( x = 0; x < LCD_MODEL_WIDTH; x++ )
+            {
+                fputc( lcd_model_pixel( lcd, x, y ) ? '1' : '0', fp );
+            }
+            fputc( '\n', fp );
+        }
+
+        if ( 0 == fclose( fp ))
+        {
+            ret = STATUS_OK;
+        }
+    }
+
+    return ret;
+}
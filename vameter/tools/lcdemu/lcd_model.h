@@ -0,0 +1,66 @@
+/**
+ ** Name
+ **   lcd_model.h
+ **
+ ** Purpose
+ **   PCD8544 controller model
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#ifndef __LCD_MODEL_H__
+#define __LCD_MODEL_H__
+
+#include "ptypes.h"
+
+#define LCD_MODEL_WIDTH  (84)
+#define LCD_MODEL_HEIGHT (48)
+#define LCD_MODEL_PAGES  ( LCD_MODEL_HEIGHT / 8 )
+
+typedef enum
+{
+    LCD_MODEL_DISP_BLANK = 0,
+    LCD_MODEL_DISP_ALL_ON,
+    LCD_MODEL_DISP_NORMAL,
+    LCD_MODEL_DISP_INVERTED
+} Lcd_Model_Disp_t;
+
+typedef struct
+{
+    uint8_t          ram[LCD_MODEL_PAGES][LCD_MODEL_WIDTH];
+    uint8_t          x;          /* Column address */
+    uint8_t          y;          /* Page address */
+    bool_t           pd;         /* Power down */
+    bool_t           v;          /* Vertical addressing */
+    bool_t           h;          /* Extended instruction set */
+    Lcd_Model_Disp_t disp;
+    uint8_t          vop;
+    uint8_t          bias;
+    uint8_t          temp;
+    uint32_t         cmd_bytes;  /* Command bytes received */
+    uint32_t         data_bytes; /* Data bytes received */
+    uint32_t         bad_cmds;   /* Undefined or out of range commands */
+} Lcd_Model_t;
+
+/*
+ * Controller state after a reset pulse
+ */
+void lcd_model_reset( Lcd_Model_t* lcd );
+
+/*
+ * Feed one byte latched with D/C low (command) or high (data)
+ */
+void lcd_model_write( Lcd_Model_t* lcd, bool_t data, uint8_t byte );
+
+/*
+ * Visible pixel at x, y, display mode applied
+ */
+bool_t lcd_model_pixel( const Lcd_Model_t* lcd, uint8_t x, uint8_t y );
+
+/*
+ * Write the visible image as plain PBM (P1)
+ */
+status_t lcd_model_save_pbm( const Lcd_Model_t* lcd, const char* path );
+
+#endif /* __LCD_MODEL_H__ */
@@ -0,0 +1,405 @@
+/**
+ ** Name
+ **   lcdemu.c
+ **
+ ** Purpose
+ **   Host run of the PCD8544 driver against the controller model
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **   18-Oct-2026 (SSB) [] Full frame refresh cost
+ **/
+
+#include "hal_host.h"
+#include "lcd_model.h"
+
+#include "pcd8544.h"
+#include "tim.h"
+
+#include <linux/perf_event.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define LCDEMU_CONTRAST    (0x38)
+#define LCDEMU_BENCH_CALLS (1000)
+
+typedef void (*Lcdemu_Draw_t)( void );
+
+typedef struct
+{
+    const char*   name;
+    Lcdemu_Draw_t draw;
+} Lcdemu_Item_t;
+
+static void scene_text( void )
+{
+    pcd8544_goto_xy( 0, 0 );
+    pcd8544_puts( "ABCDEFGHIJKLMN", PCD8544_PIXEL_SET, PCD8544_FONT_SIZE_5X7 );
+    pcd8544_goto_xy( 0, 8 );
+    pcd8544_puts( "0123456789.:-+", PCD8544_PIXEL_SET, PCD8544_FONT_SIZE_5X7 );
+    pcd8544_goto_xy( 0, 19 );
+    pcd8544_puts( "inverse", PCD8544_PIXEL_CLEAR, PCD8544_FONT_SIZE_5X7 );
+    pcd8544_goto_xy( 0, 30 );
+    pcd8544_puts( "small 3x5 font ABC 123"
+                , PCD8544_PIXEL_SET
+                , PCD8544_FONT_SIZE_3X5
+                );
+}
+
+static void scene_lines( void )
+{
+    uint8_t i;
+
+    for ( i = 0; i < PCD8544_WIDTH; i += 12 )
+    {
+        pcd8544_draw_line( i, 0, PCD8544_WIDTH - 1 - i, PCD8544_HEIGHT - 1
+                         , PCD8544_PIXEL_SET
+                         );
+    }
+
+    pcd8544_draw_line( 0, 24, PCD8544_WIDTH - 1, 24, PCD8544_PIXEL_SET );
+    pcd8544_draw_line( 42, 0, 42, PCD8544_HEIGHT - 1, PCD8544_PIXEL_SET );
+}
+
+static void scene_rectangles( void )
+{
+    pcd8544_draw_rectangle( 0, 0, 83, 47, PCD8544_PIXEL_SET );
+    pcd8544_draw_rectangle( 4, 4, 40, 20, PCD8544_PIXEL_SET );
+    pcd8544_draw_filled_rectangle( 44, 4, 79, 20, PCD8544_PIXEL_SET );
+    pcd8544_draw_filled_rectangle( 50, 8, 73, 16, PCD8544_PIXEL_CLEAR );
+    pcd8544_draw_filled_rectangle( 4, 26, 79, 43, PCD8544_PIXEL_SET );
+}
+
+static void scene_circles( void )
+{
+    pcd8544_draw_circle( 20, 23, 18, PCD8544_PIXEL_SET );
+    pcd8544_draw_circle( 20, 23, 8, PCD8544_PIXEL_SET );
+    pcd8544_draw_filled_circle( 62, 23, 18, PCD8544_PIXEL_SET );
+    pcd8544_draw_filled_circle( 62, 23, 6, PCD8544_PIXEL_CLEAR );
+}
+
+static void scene_dashboard( void )
+{
+    pcd8544_goto_xy( 0, 0 );
+    pcd8544_puts( "12.345V", PCD8544_PIXEL_SET, PCD8544_FONT_SIZE_5X7 );
+    pcd8544_goto_xy( 0, 8 );
+    pcd8544_puts( "0.512A", PCD8544_PIXEL_SET, PCD8544_FONT_SIZE_5X7 );
+    pcd8544_draw_rectangle( 50, 40, 83, 47, PCD8544_PIXEL_SET );
+    pcd8544_draw_filled_rectangle( 51, 41, 70, 47, PCD8544_PIXEL_SET );
+}
+
+static const Lcdemu_Item_t lcdemu_scenes[] =
+{
+    { "text",       scene_text       },
+    { "lines",      scene_lines      },
+    { "rectangles", scene_rectangles },
+    { "circles",    scene_circles    },
+    { "dashboard",  scene_dashboard  }
+};
+
+static void draw_putc_5x7( void )
+{
+    pcd8544_goto_xy( 10, 8 );
+    pcd8544_putc( '8', PCD8544_PIXEL_SET, PCD8544_FONT_SIZE_5X7 );
+}
+
+static void draw_putc_5x7_unaligned( void )
+{
+    pcd8544_goto_xy( 10, 11 );
+    pcd8544_putc( '8', PCD8544_PIXEL_SET, PCD8544_FONT_SIZE_5X7 );
+}
+
+static void draw_putc_3x5( void )
+{
+    pcd8544_goto_xy( 10, 8 );
+    pcd8544_putc( '8', PCD8544_PIXEL_SET, PCD8544_FONT_SIZE_3X5 );
+}
+
+static void draw_puts_reading( void )
+{
+    pcd8544_goto_xy( 0, 0 );
+    pcd8544_puts( "12.345V", PCD8544_PIXEL_SET, PCD8544_FONT_SIZE_5X7 );
+}
+
+static void draw_pixel( void )
+{
+    pcd8544_draw_pixel( 40, 20, PCD8544_PIXEL_SET );
+}
+
+static void draw_line( void )
+{
+    pcd8544_draw_line( 0, 0, 83, 47, PCD8544_PIXEL_SET );
+}
+
+static void draw_hline( void )
+{
+    pcd8544_draw_line( 0, 20, 83, 20, PCD8544_PIXEL_SET );
+}
+
+static void draw_rectangle( void )
+{
+    pcd8544_draw_rectangle( 10, 10, 60, 40, PCD8544_PIXEL_SET );
+}
+
+static void draw_filled_rectangle( void )
+{
+    pcd8544_draw_filled_rectangle( 10, 10, 60, 40, PCD8544_PIXEL_SET );
+}
+
+static void draw_circle( void )
+{
+    pcd8544_draw_circle( 40, 23, 20, PCD8544_PIXEL_SET );
+}
+
+static void draw_filled_circle( void )
+{
+    pcd8544_draw_filled_circle( 40, 23, 20, PCD8544_PIXEL_SET );
+}
+
+static const Lcdemu_Item_t lcdemu_draws[] =
+{
+    { "putc 5x7",              draw_putc_5x7           },
+    { "putc 5x7 unaligned",    draw_putc_5x7_unaligned },
+    { "putc 3x5",              draw_putc_3x5           },
+    { "puts \"12.345V\"",      draw_puts_reading       },
+    { "pixel",                 draw_pixel              },
+    { "line diagonal",         draw_line               },
+    { "line horizontal",       draw_hline              },
+    { "rectangle 51x31",       draw_rectangle          },
+    { "filled rectangle 51x31", draw_filled_rectangle  },
+    { "circle r20",            draw_circle             },
+    { "filled circle r20",     draw_filled_circle      }
+};
+
+#define LCDEMU_NUM(a) ( sizeof( a ) / sizeof( a[0] ))
+
+/* User space instruction counter, -1 when perf events are not available */
+static int lcdemu_perf_open( void )
+{
+    struct perf_event_attr attr;
+
+    memset( &attr, 0, sizeof( attr ));
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof( attr );
+    attr.config         = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+
+    return (int) syscall( SYS_perf_event_open, &attr, 0, -1, -1, 0 );
+}
+
+/* Instructions (or ns without perf) per call of draw */
+static uint64_t lcdemu_measure( int perf_fd, Lcdemu_Draw_t draw )
+{
+    uint64_t count = 0;
+    Time_t   start;
+    Time_t   stop;
+    uint32_t i;
+
+    draw();
+
+    if ( perf_fd >= 0 )
+    {
+        ioctl( perf_fd, PERF_EVENT_IOC_RESET, 0 );
+        ioctl( perf_fd, PERF_EVENT_IOC_ENABLE, 0 );
+    }
+    get_time( &start );
+
+    for ( i = 0; i < LCDEMU_BENCH_CALLS; i++ )
+    {
+        draw();
+    }
+
+    get_time( &stop );
+
+    if ( perf_fd >= 0 )
+    {
+        ioctl( perf_fd, PERF_EVENT_IOC_DISABLE, 0 );
+
+        if ( sizeof( count ) != read( perf_fd, &count, sizeof( count )))
+        {
+            count = 0;
+        }
+    }
+    else
+    {
+        count = ( stop - start ) * 1000;
+    }
+
+    return count / LCDEMU_BENCH_CALLS;
+}
+
+static uint32_t lcdemu_refresh_bytes( void )
+{
+    PCD8544_Stats_t stats;
+    uint32_t        spi = hal_host_spi_bytes;
+
+    pcd8544_refresh();
+    pcd8544_get_stats( &stats );
+
+    if ( stats.bytes_last != ( hal_host_spi_bytes - spi ))
+    {
+        printf( "warning: driver counted %lu bytes, SPI carried %lu\n"
+              , (unsigned long) stats.bytes_last
+              , (unsigned long) ( hal_host_spi_bytes - spi )
+              );
+    }
+
+    return stats.bytes_last;
+}
+
+static int lcdemu_render( const char* dir )
+{
+    int     ret = 0;
+    char    path[256];
+    uint8_t i;
+
+    for ( i = 0; i < LCDEMU_NUM( lcdemu_scenes ); i++ )
+    {
+        pcd8544_clear();
+        lcdemu_scenes[i].draw();
+        pcd8544_refresh();
+
+        snprintf( path, sizeof( path ), "%s/%s.pbm", dir, lcdemu_scenes[i].name );
+
+        if ( STATUS_OK != lcd_model_save_pbm( &hal_host_lcd, path ))
+        {
+            printf( "Error: writing %s failed!\n", path );
+            ret = 1;
+        }
+        else
+        {
+            printf( "%s\n", path );
+        }
+    }
+
+    if ( 0 != hal_host_lcd.bad_cmds )
+    {
+        printf( "Error: %lu invalid commands sent\n"
+              , (unsigned long) hal_host_lcd.bad_cmds
+              );
+        ret = 1;
+    }
+
+    return ret;
+}
+
+static void refresh_full_frame( void )
+{
+    pcd8544_update_area( 0, 0, PCD8544_WIDTH - 1, PCD8544_HEIGHT - 1 );
+    pcd8544_refresh();
+}
+
+/* HAL calls of one blocking full frame refresh and the host cost of the
+ * whole call, the wire time is the same for both refresh paths
+ */
+static void lcdemu_full_frame( int perf_fd )
+{
+    const Hal_Host_Calls_t start = hal_host_calls;
+    const uint32_t         spi   = hal_host_spi_bytes;
+    Hal_Host_Calls_t       calls;
+    uint32_t               bytes;
+
+    refresh_full_frame();
+
+    bytes       = hal_host_spi_bytes - spi;
+    calls.gpio  = hal_host_calls.gpio - start.gpio;
+    calls.spi   = hal_host_calls.spi - start.spi;
+    calls.dma   = hal_host_calls.dma - start.dma;
+
+    printf( "\n%-24s %10s %6s %6s %6s %10s\n", "full frame refresh"
+          , "SPI bytes", "GPIO", "SPI", "DMA"
+          , ( perf_fd >= 0 ) ? "instr/call" : "ns/call"
+          );
+    printf( "%-24s %10lu %6lu %6lu %6lu %10lu\n"
+          , ( 0 != PCD8544_DMA_ENABLED ) ? "DMA bursts" : "byte by byte"
+          , (unsigned long) bytes
+          , (unsigned long) calls.gpio
+          , (unsigned long) calls.spi
+          , (unsigned long) calls.dma
+          , (unsigned long) lcdemu_measure( perf_fd, refresh_full_frame )
+          );
+}
+
+static int lcdemu_bench( void )
+{
+    int     perf_fd;
+    uint8_t i;
+
+    perf_fd = lcdemu_perf_open();
+
+    printf( "%-24s %10s\n", "draw call"
+          , ( perf_fd >= 0 ) ? "instr/call" : "ns/call"
+          );
+
+    for ( i = 0; i < LCDEMU_NUM( lcdemu_draws ); i++ )
+    {
+        pcd8544_clear();
+
+        printf( "%-24s %10lu\n"
+              , lcdemu_draws[i].name
+              , (unsigned long) lcdemu_measure( perf_fd, lcdemu_draws[i].draw )
+              );
+    }
+
+    lcdemu_full_frame( perf_fd );
+
+    if ( perf_fd >= 0 )
+    {
+        close( perf_fd );
+    }
+
+    printf( "\n%-24s %10s\n", "refresh", "SPI bytes" );
+
+    pcd8544_update_area( 0, 0, PCD8544_WIDTH - 1, PCD8544_HEIGHT - 1 );
+    printf( "%-24s %10lu\n", "full frame"
+          , (unsigned long) lcdemu_refresh_bytes()
+          );
+
+    for ( i = 0; i < LCDEMU_NUM( lcdemu_scenes ); i++ )
+    {
+        pcd8544_clear();
+        lcdemu_scenes[i].draw();
+        printf( "%-24s %10lu\n", lcdemu_scenes[i].name
+              , (unsigned long) lcdemu_refresh_bytes()
+              );
+    }
+
+    /* Only the readout changes between two dashboard frames */
+    pcd8544_goto_xy( 0, 0 );
+    pcd8544_puts( "12.346V", PCD8544_PIXEL_SET, PCD8544_FONT_SIZE_5X7 );
+    printf( "%-24s %10lu\n", "dashboard readout"
+          , (unsigned long) lcdemu_refresh_bytes()
+          );
+
+    return 0;
+}
+
+int main( int argc, char* argv[] )
+{
+    int ret = 2;
+
+    if ( STATUS_OK != pcd8544_init( LCDEMU_CONTRAST ))
+    {
+        printf( "Error: PCD8544 init failed!\n" );
+        ret = 1;
+    }
+    else if (( 3 == argc ) && ( 0 == strcmp( argv[1], "render" )))
+    {
+        ret = lcdemu_render( argv[2] );
+    }
+    else if (( 2 == argc ) && ( 0 == strcmp( argv[1], "bench" )))
+    {
+        ret = lcdemu_bench();
+    }
+    else
+    {
+        printf( "Usage: %s render <dir> | bench\n", argv[0] );
+    }
+
+    return ret;
+}
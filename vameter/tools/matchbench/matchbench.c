@@ -0,0 +1,244 @@
+/**
+ ** Name
+ **   matchbench.c
+ **
+ ** Purpose
+ **   Host benchmark of the incremental matcher against a rescanning search
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "buffer.h"
+#include "match.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MATCHBENCH_STREAM (64u * 1024u)
+#define MATCHBENCH_RING   (256)
+#define MATCHBENCH_KEEP   (16)      /* Unmatched bytes kept when full */
+#define MATCHBENCH_MAX    (4096)    /* Matches recorded */
+
+typedef int32_t (*Matchbench_Find_t)( Buffer_t* buff, int8_t* id );
+
+typedef struct
+{
+    uint32_t pos[MATCHBENCH_MAX];
+    int8_t   id[MATCHBENCH_MAX];
+    uint32_t num;
+} Matchbench_Hits_t;
+
+static const char* const matchbench_pat[] = { "OK\r\n", "ERROR", "FAIL" };
+
+#define MATCHBENCH_PAT_NUM \
+    ( sizeof( matchbench_pat ) / sizeof( matchbench_pat[0] ))
+
+static uint8_t  matchbench_stream[MATCHBENCH_STREAM];
+static uint8_t  matchbench_storage[MATCHBENCH_RING];
+static Buffer_t matchbench_buff = BUFFER_INIT( matchbench_storage, '\n' );
+static Match_t  matchbench_match;
+static uint64_t matchbench_cmp;
+
+/* Modem like traffic, responses among echo and URC text */
+static void matchbench_fill( uint32_t seed )
+{
+    static const char text[] = "AT+CSQ +CREG: 0,1 RING 0123456789 OKAY ERR";
+    uint32_t          i = 0;
+    const char*       pat;
+
+    srand( seed );
+
+    while ( i < MATCHBENCH_STREAM )
+    {
+        if ( 0 == ( rand() % 24 ))
+        {
+            pat = matchbench_pat[rand() % MATCHBENCH_PAT_NUM];
+
+            while (( '\0' != *pat ) && ( i < MATCHBENCH_STREAM ))
+            {
+                matchbench_stream[i++] = (uint8_t) *pat++;
+            }
+        }
+        else
+        {
+            matchbench_stream[i++] = (uint8_t) text[rand()
+                                                    % ( sizeof( text ) - 1 )];
+        }
+    }
+}
+
+/* What polling each pattern with a stateless search costs, every call
+ * starts over at the consumer index
+ */
+static int32_t matchbench_rescan( Buffer_t* buff, int8_t* id )
+{
+    const uint32_t num = ring_count( &buff->ring );
+    int32_t        ret = -1;
+    uint32_t       len;
+    uint32_t       out;
+    uint32_t       i;
+    uint8_t        p;
+
+    for ( p = 0; p < MATCHBENCH_PAT_NUM; p++ )
+    {
+        len = strlen( matchbench_pat[p] );
+
+        for ( out = 0; ( out + len ) <= num; out++ )
+        {
+            if (( ret >= 0 ) && ( out >= (uint32_t) ret ))
+            {
+                break;
+            }
+
+            for ( i = 0; i < len; i++ )
+            {
+                matchbench_cmp++;
+
+                if ( ring_at( &buff->ring, out + i )
+                     != (uint8_t) matchbench_pat[p][i] )
+                {
+                    break;
+                }
+            }
+
+            if ( i == len )
+            {
+                ret = (int32_t) out;
+                *id = (int8_t) p;
+                break;
+            }
+        }
+    }
+
+    return ret;
+}
+
+static int32_t matchbench_match_find( Buffer_t* buff, int8_t* id )
+{
+    const uint32_t tail = buff->ring.tail;
+    uint32_t       pos  = matchbench_match.pos;
+    int32_t        ret;
+
+    /* Scanning restarts at the consumer index after a flush */
+    pos = ((int32_t)( pos - tail ) < 0 ) ? tail : pos;
+    ret = buffer_match( buff, &matchbench_match, id );
+
+    matchbench_cmp += matchbench_match.pos - pos;
+
+    return ret;
+}
+
+/* Bytes arrive in chunks of 1 to 8, the consumer polls after each chunk
+ * and drops everything up to the end of a match
+ */
+static double matchbench_run( Matchbench_Find_t find, Matchbench_Hits_t* hits )
+{
+    struct timespec start;
+    struct timespec stop;
+    uint32_t        in       = 0;
+    uint32_t        consumed = 0;
+    uint32_t        chunk;
+    uint32_t        count;
+    int32_t         off;
+    int8_t          id;
+
+    buffer_reset( &matchbench_buff );
+    hits->num      = 0;
+    matchbench_cmp = 0;
+    srand( 1 );
+
+    clock_gettime( CLOCK_MONOTONIC, &start );
+
+    while ( in < MATCHBENCH_STREAM )
+    {
+        chunk = 1 + ( rand() % 8 );
+        chunk = ( chunk > ( MATCHBENCH_STREAM - in ))
+              ? ( MATCHBENCH_STREAM - in ) : chunk;
+
+        if ( buffer_get_free( &matchbench_buff ) < chunk )
+        {
+            count     = buffer_get_full( &matchbench_buff ) - MATCHBENCH_KEEP;
+            consumed += ring_skip( &matchbench_buff.ring, count );
+        }
+
+        in += buffer_write( &matchbench_buff, &matchbench_stream[in], chunk );
+
+        while ( 0 <= ( off = find( &matchbench_buff, &id )))
+        {
+            if ( hits->num < MATCHBENCH_MAX )
+            {
+                hits->pos[hits->num] = consumed + (uint32_t) off;
+                hits->id[hits->num]  = id;
+                hits->num++;
+            }
+
+            count     = (uint32_t) off + strlen( matchbench_pat[id] );
+            consumed += ring_skip( &matchbench_buff.ring, count );
+        }
+    }
+
+    clock_gettime( CLOCK_MONOTONIC, &stop );
+
+    return (double)( stop.tv_sec - start.tv_sec ) * 1e3
+         + (double)( stop.tv_nsec - start.tv_nsec ) / 1e6;
+}
+
+int main( void )
+{
+    static Matchbench_Hits_t rescan;
+    static Matchbench_Hits_t match;
+    const void*              pat[MATCHBENCH_PAT_NUM];
+    uint8_t                  len[MATCHBENCH_PAT_NUM];
+    uint64_t                 cmp;
+    double                   ms;
+    uint32_t                 i;
+
+    for ( i = 0; i < MATCHBENCH_PAT_NUM; i++ )
+    {
+        pat[i] = matchbench_pat[i];
+        len[i] = (uint8_t) strlen( matchbench_pat[i] );
+    }
+
+    if ( STATUS_OK != match_init( &matchbench_match, pat, len
+                                , MATCHBENCH_PAT_NUM ))
+    {
+        fprintf( stderr, "matchbench: patterns don't fit\n" );
+        return EXIT_FAILURE;
+    }
+
+    matchbench_fill( 7 );
+
+    ms  = matchbench_run( matchbench_rescan, &rescan );
+    cmp = matchbench_cmp;
+
+    printf( "rescan:  %u matches, %llu byte compares, %.3f ms\n"
+          , rescan.num
+          , (unsigned long long) cmp
+          , ms
+          );
+
+    ms = matchbench_run( matchbench_match_find, &match );
+
+    printf( "matcher: %u matches, %llu bytes stepped, %.3f ms\n"
+          , match.num
+          , (unsigned long long) matchbench_cmp
+          , ms
+          );
+
+    if (( rescan.num != match.num )
+     || ( 0 != memcmp( rescan.pos, match.pos, match.num * sizeof( uint32_t )))
+     || ( 0 != memcmp( rescan.id, match.id, match.num )))
+    {
+        printf( "MISMATCH\n" );
+        return EXIT_FAILURE;
+    }
+
+    printf( "same matches, %.1fx fewer byte visits\n"
+          , (double) cmp / (double) matchbench_cmp
+          );
+
+    return EXIT_SUCCESS;
+}
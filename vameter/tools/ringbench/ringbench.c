@@ -0,0 +1,188 @@
+/**
+ ** Name
+ **   ringbench.c
+ **
+ ** Purpose
+ **   Host benchmark of the lock-free ring against the baseline buffer
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "buffer.h"
+#include "ring.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define RINGBENCH_SIZE   (1024)     /* UART_BUFFER_SIZE */
+#define RINGBENCH_BATCH  (1000)     /* Bytes per round, moves the wrap */
+#define RINGBENCH_ROUNDS (20000)
+
+/* Baseline receive path, uart_insert_to_buffer() as it was */
+static Buffer_t ringbench_buff;
+static uint8_t  ringbench_buff_data[RINGBENCH_SIZE];
+
+static uint8_t  ringbench_ring_data[RINGBENCH_SIZE];
+static Ring_t   ringbench_ring = RING_INIT( ringbench_ring_data );
+
+static uint8_t  ringbench_in[RINGBENCH_BATCH];
+static uint8_t  ringbench_out[RINGBENCH_BATCH];
+
+typedef struct
+{
+    double push;                /* ns in 1-byte pushes */
+    double pop;                 /* ns in bulk pops */
+} Ringbench_Time_t;
+
+static double ringbench_ns( const struct timespec* start
+                          , const struct timespec* stop
+                          )
+{
+    return (double)( stop->tv_sec - start->tv_sec ) * 1e9
+         + (double)( stop->tv_nsec - start->tv_nsec );
+}
+
+static void ringbench_check( const char* name )
+{
+    if ( 0 != memcmp( ringbench_in, ringbench_out, RINGBENCH_BATCH ))
+    {
+        fprintf( stderr, "ringbench: %s lost data\n", name );
+        exit( EXIT_FAILURE );
+    }
+}
+
+static void ringbench_buffer( uint32_t chunk, Ringbench_Time_t* t )
+{
+    struct timespec start;
+    struct timespec mid;
+    struct timespec stop;
+    uint32_t        round;
+    uint32_t        i;
+
+    (void) buffer_init( &ringbench_buff
+                      , sizeof( ringbench_buff_data )
+                      , ringbench_buff_data
+                      );
+    t->push = 0.0;
+    t->pop  = 0.0;
+
+    for ( round = 0; round < RINGBENCH_ROUNDS; round++ )
+    {
+        clock_gettime( CLOCK_MONOTONIC, &start );
+
+        for ( i = 0; i < RINGBENCH_BATCH; i++ )
+        {
+            (void) buffer_write( &ringbench_buff, &ringbench_in[i], 1 );
+        }
+
+        clock_gettime( CLOCK_MONOTONIC, &mid );
+
+        for ( i = 0; i < RINGBENCH_BATCH; i += chunk )
+        {
+            (void) buffer_read( &ringbench_buff, &ringbench_out[i]
+                              , ( chunk < ( RINGBENCH_BATCH - i ))
+                              ? chunk : ( RINGBENCH_BATCH - i )
+                              );
+        }
+
+        clock_gettime( CLOCK_MONOTONIC, &stop );
+
+        t->push += ringbench_ns( &start, &mid );
+        t->pop  += ringbench_ns( &mid, &stop );
+
+        ringbench_check( "buffer" );
+    }
+}
+
+static void ringbench_ring_run( uint32_t chunk, Ringbench_Time_t* t )
+{
+    struct timespec start;
+    struct timespec mid;
+    struct timespec stop;
+    uint32_t        round;
+    uint32_t        i;
+
+    ring_flush( &ringbench_ring );
+    t->push = 0.0;
+    t->pop  = 0.0;
+
+    for ( round = 0; round < RINGBENCH_ROUNDS; round++ )
+    {
+        clock_gettime( CLOCK_MONOTONIC, &start );
+
+        for ( i = 0; i < RINGBENCH_BATCH; i++ )
+        {
+            (void) ring_put( &ringbench_ring, ringbench_in[i] );
+        }
+
+        clock_gettime( CLOCK_MONOTONIC, &mid );
+
+        for ( i = 0; i < RINGBENCH_BATCH; i += chunk )
+        {
+            (void) ring_read( &ringbench_ring, &ringbench_out[i]
+                            , ( chunk < ( RINGBENCH_BATCH - i ))
+                            ? chunk : ( RINGBENCH_BATCH - i )
+                            );
+        }
+
+        clock_gettime( CLOCK_MONOTONIC, &stop );
+
+        t->push += ringbench_ns( &start, &mid );
+        t->pop  += ringbench_ns( &mid, &stop );
+
+        ringbench_check( "ring" );
+    }
+}
+
+int main( void )
+{
+    static const uint32_t chunk[] = { 1, 16, RINGBENCH_BATCH };
+    const double          bytes   = (double) RINGBENCH_BATCH
+                                  * RINGBENCH_ROUNDS;
+    Ringbench_Time_t      base;
+    Ringbench_Time_t      ring;
+    uint32_t              i;
+
+    srand( 1 );
+
+    for ( i = 0; i < RINGBENCH_BATCH; i++ )
+    {
+        ringbench_in[i] = (uint8_t) rand();
+    }
+
+    printf( "%u byte ring, %u bytes per round, %u rounds, ns/byte\n"
+          , (unsigned) RINGBENCH_SIZE
+          , (unsigned) RINGBENCH_BATCH
+          , (unsigned) RINGBENCH_ROUNDS
+          );
+    printf( "%-22s %10s %10s %8s\n", "", "buffer", "ring", "speedup" );
+
+    for ( i = 0; i < ( sizeof( chunk ) / sizeof( chunk[0] )); i++ )
+    {
+        ringbench_buffer( chunk[i], &base );
+        ringbench_ring_run( chunk[i], &ring );
+
+        /* The push loop is the same for every chunk size */
+        if ( 0 == i )
+        {
+            printf( "%-22s %10.3f %10.3f %7.1fx\n"
+                  , "1-byte ISR push"
+                  , base.push / bytes
+                  , ring.push / bytes
+                  , base.push / ring.push
+                  );
+        }
+
+        printf( "bulk pop, %4u B chunk %10.3f %10.3f %7.1fx\n"
+              , (unsigned) chunk[i]
+              , base.pop / bytes
+              , ring.pop / bytes
+              , base.pop / ring.pop
+              );
+    }
+
+    return EXIT_SUCCESS;
+}
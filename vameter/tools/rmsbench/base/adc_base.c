@@ -0,0 +1,77 @@
+/**
+ ** Name
+ **   adc_base.c
+ **
+ ** Purpose
+ **   Baseline RMS calculation of the 10-Oct-2020 adc.c
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "adc_base.h"
+
+#include "adc.h"
+
+#include <math.h>
+
+static uint16_t ch_idx = 0;
+
+void adc_base_reset( void )
+{
+    ch_idx = 0;
+}
+
+/* Loop of adc_calc_rms() as it was, the DMA half is passed in instead of
+ * being selected by adc_get_dma_buff_ready()
+ */
+void adc_base_calc_rms( const uint16_t* frame_r, Adc_Base_Rms_t* rms )
+{
+    uint16_t i;
+
+    for ( i = 0; i < ADC_DMA_BUFF_SIZE / 2; i++ )
+    {
+        if ( rms[ch_idx].curr_cnt < rms[ch_idx].req_samples )
+        {
+            uint32_t value;
+
+            if ( 0 == ch_idx )
+            {
+                /* For the current sensing with ACS71240 zero is a Vref/2 */
+                if ( frame_r[i] >= 2048 )
+                {
+                    value = frame_r[i] - 2048;
+                }
+                else
+                {
+                    value = 2048 - frame_r[i];
+                }
+            }
+            else
+            {
+                value = frame_r[i];
+            }
+
+            rms[ch_idx].sum += ( value * value );
+            rms[ch_idx].curr_cnt++;
+        }
+        else
+        {
+            /* Do the math if enough number of samples is collected
+             * for the RMS evaluation
+             */
+            uint32_t tmp;
+
+            tmp = rms[ch_idx].sum
+                / rms[ch_idx].req_samples;
+
+            rms[ch_idx].last = sqrt( tmp );
+
+            rms[ch_idx].curr_cnt = 0;
+            rms[ch_idx].sum      = 0;
+        }
+
+        ch_idx++;
+        ch_idx = ch_idx % 2;
+    }
+}
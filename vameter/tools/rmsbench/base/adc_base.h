@@ -0,0 +1,39 @@
+/**
+ ** Name
+ **   adc_base.h
+ **
+ ** Purpose
+ **   Baseline RMS calculation of the 10-Oct-2020 adc.c
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#ifndef __ADC_BASE_H__
+#define __ADC_BASE_H__
+
+#include "ptypes.h"
+
+/* Adc_Rms_t as it was */
+typedef struct
+{
+    uint32_t last;          /* Last valid calculated RMS */
+    uint32_t max;           /* Max measured RMS value - test purpose only */
+    uint32_t min;           /* Min measured RMS value - test purpose only */
+    uint32_t curr_cnt;      /* Current sample counter */
+    uint32_t req_samples;   /* No of samples required to evaluate RMS */
+    uint64_t sum;           /* Current samples sum value */
+} Adc_Base_Rms_t;
+
+/*
+ * Restart the channel alternation, windows are reset by the caller
+ */
+void adc_base_reset( void );
+
+/*
+ * Baseline adc_calc_rms() on a DMA half buffer of ADC_DMA_BUFF_SIZE / 2
+ * interleaved samples
+ */
+void adc_base_calc_rms( const uint16_t* frame_r, Adc_Base_Rms_t* rms );
+
+#endif /* __ADC_BASE_H__ */
@@ -0,0 +1,187 @@
+/**
+ ** Name
+ **   stm32f1xx_hal.h
+ **
+ ** Purpose
+ **   Host replacement of the HAL subset used by the ADC pipeline
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#ifndef __STM32F1XX_HAL_H__
+#define __STM32F1XX_HAL_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define __IO     volatile
+#define __INLINE inline
+
+#define DISABLE  (0)
+#define ENABLE   (1)
+
+typedef enum
+{
+    HAL_OK = 0,
+    HAL_ERROR,
+    HAL_BUSY,
+    HAL_TIMEOUT
+} HAL_StatusTypeDef;
+
+typedef enum
+{
+    DMA1_Channel1_IRQn = 11
+} IRQn_Type;
+
+/* Interrupts are not taken on the host */
+#define __disable_irq()
+#define __enable_irq()
+
+#define __HAL_RCC_ADC1_CLK_ENABLE()
+#define __HAL_RCC_DMA1_CLK_ENABLE()
+#define __HAL_RCC_GPIOA_CLK_ENABLE()
+
+/* Cycle counter of prof.h, not read with profiling disabled */
+typedef struct
+{
+    __IO uint32_t CYCCNT;
+} DWT_Type;
+
+extern DWT_Type host_dwt;
+
+#define DWT (&host_dwt)
+
+void HAL_NVIC_SetPriority( IRQn_Type irq, uint32_t prio, uint32_t sub );
+void HAL_NVIC_EnableIRQ( IRQn_Type irq );
+
+/* GPIO */
+typedef struct
+{
+    __IO uint32_t ODR;
+} GPIO_TypeDef;
+
+typedef struct
+{
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+} GPIO_InitTypeDef;
+
+extern GPIO_TypeDef host_gpioa;
+
+#define GPIOA (&host_gpioa)
+
+#define GPIO_PIN_0        ((uint16_t) 0x0001)
+#define GPIO_PIN_2        ((uint16_t) 0x0004)
+#define GPIO_MODE_ANALOG  3
+
+void HAL_GPIO_Init( GPIO_TypeDef* port, GPIO_InitTypeDef* init );
+
+/* DMA */
+typedef struct
+{
+    __IO uint32_t CCR;
+} DMA_Channel_TypeDef;
+
+typedef struct
+{
+    uint32_t Direction;
+    uint32_t PeriphInc;
+    uint32_t MemInc;
+    uint32_t PeriphDataAlignment;
+    uint32_t MemDataAlignment;
+    uint32_t Mode;
+    uint32_t Priority;
+} DMA_InitTypeDef;
+
+typedef struct
+{
+    DMA_Channel_TypeDef* Instance;
+    DMA_InitTypeDef      Init;
+    void*                Parent;
+} DMA_HandleTypeDef;
+
+extern DMA_Channel_TypeDef host_dma1_ch1;
+
+#define DMA1_Channel1 (&host_dma1_ch1)
+
+#define DMA_PERIPH_TO_MEMORY    0
+#define DMA_PINC_DISABLE        0
+#define DMA_MINC_ENABLE         1
+#define DMA_PDATAALIGN_HALFWORD 1
+#define DMA_MDATAALIGN_HALFWORD 1
+#define DMA_CIRCULAR            1
+#define DMA_PRIORITY_LOW        0
+
+HAL_StatusTypeDef HAL_DMA_Init( DMA_HandleTypeDef* hdma );
+void HAL_DMA_IRQHandler( DMA_HandleTypeDef* hdma );
+
+/* ADC */
+typedef struct
+{
+    __IO uint32_t DR;
+} ADC_TypeDef;
+
+typedef struct
+{
+    uint32_t DataAlign;
+    uint32_t ScanConvMode;
+    uint32_t ContinuousConvMode;
+    uint32_t NbrOfConversion;
+    uint32_t DiscontinuousConvMode;
+    uint32_t ExternalTrigConv;
+} ADC_InitTypeDef;
+
+typedef struct
+{
+    uint32_t Channel;
+    uint32_t Rank;
+    uint32_t SamplingTime;
+} ADC_ChannelConfTypeDef;
+
+typedef struct
+{
+    ADC_TypeDef*       Instance;
+    ADC_InitTypeDef    Init;
+    DMA_HandleTypeDef* DMA_Handle;
+} ADC_HandleTypeDef;
+
+extern ADC_TypeDef host_adc1;
+
+#define ADC1 (&host_adc1)
+
+#define ADC_SCAN_ENABLE             1
+#define ADC_EXTERNALTRIGCONV_T1_CC1 0
+#define ADC_DATAALIGN_RIGHT         0
+#define ADC_CHANNEL_0               0
+#define ADC_CHANNEL_2               2
+#define ADC_REGULAR_RANK_1          1
+#define ADC_REGULAR_RANK_2          2
+#define ADC_SAMPLETIME_7CYCLES_5    1
+
+#define __HAL_LINKDMA( parent, field, dma )     \
+    do                                          \
+    {                                           \
+        ( parent )->field = &( dma );           \
+        ( dma ).Parent    = ( parent );         \
+    } while ( 0 )
+
+HAL_StatusTypeDef HAL_ADC_Init( ADC_HandleTypeDef* adc );
+HAL_StatusTypeDef HAL_ADC_ConfigChannel( ADC_HandleTypeDef*      adc
+                                       , ADC_ChannelConfTypeDef* cfg
+                                       );
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start( ADC_HandleTypeDef* adc );
+HAL_StatusTypeDef HAL_ADC_Start_DMA( ADC_HandleTypeDef* adc
+                                   , uint32_t*          data
+                                   , uint32_t           len
+                                   );
+HAL_StatusTypeDef HAL_ADC_Stop_DMA( ADC_HandleTypeDef* adc );
+void HAL_ADC_ConvHalfCpltCallback( ADC_HandleTypeDef* adc );
+void HAL_ADC_ConvCpltCallback( ADC_HandleTypeDef* adc );
+
+/* Flash, only the page size is used by flash.h */
+#define FLASH_PAGE_SIZE (0x400)
+
+#endif /* __STM32F1XX_HAL_H__ */
@@ -0,0 +1,457 @@
+/**
+ ** Name
+ **   rmsbench.c
+ **
+ ** Purpose
+ **   Host check and benchmark of the integer RMS pipeline against the
+ **   baseline double precision calculation
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "adc.h"
+#include "adc_base.h"
+#include "event.h"
+#include "flash.h"
+#include "tim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+    #include <x86intrin.h>
+    #define RMSBENCH_TSC() __rdtsc()
+#else
+    #define RMSBENCH_TSC() ((uint64_t) 0)
+#endif
+
+#define RMSBENCH_CONFIGS (500)      /* Random window configurations */
+#define RMSBENCH_EXTRA   (16)       /* Half buffers past two windows, max */
+#define RMSBENCH_HALVES  (200000)   /* Half buffers timed per path */
+#define RMSBENCH_HALF    ( ADC_DMA_BUFF_SIZE / 2 )
+
+GPIO_TypeDef        host_gpioa;
+DMA_Channel_TypeDef host_dma1_ch1;
+ADC_TypeDef         host_adc1;
+DWT_Type            host_dwt;
+
+static ADC_HandleTypeDef* rmsbench_hdl;
+static uint16_t*          rmsbench_dma;
+static uint32_t           rmsbench_rate = ADC_RATE_DEF;
+static Time_t             rmsbench_time;
+
+typedef struct
+{
+    double   ns;
+    uint64_t tsc;
+} Rmsbench_Time_t;
+
+/* HAL and board stand-ins, the DMA buffer of adc_start() is kept to be
+ * filled by the harness
+ */
+void HAL_NVIC_SetPriority( IRQn_Type irq, uint32_t prio, uint32_t sub )
+{
+    (void) irq;
+    (void) prio;
+    (void) sub;
+}
+
+void HAL_NVIC_EnableIRQ( IRQn_Type irq )
+{
+    (void) irq;
+}
+
+void HAL_GPIO_Init( GPIO_TypeDef* port, GPIO_InitTypeDef* init )
+{
+    (void) port;
+    (void) init;
+}
+
+HAL_StatusTypeDef HAL_DMA_Init( DMA_HandleTypeDef* hdma )
+{
+    (void) hdma;
+
+    return HAL_OK;
+}
+
+void HAL_DMA_IRQHandler( DMA_HandleTypeDef* hdma )
+{
+    (void) hdma;
+}
+
+HAL_StatusTypeDef HAL_ADC_Init( ADC_HandleTypeDef* adc )
+{
+    rmsbench_hdl = adc;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_ConfigChannel( ADC_HandleTypeDef*      adc
+                                       , ADC_ChannelConfTypeDef* cfg
+                                       )
+{
+    (void) adc;
+    (void) cfg;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start( ADC_HandleTypeDef* adc )
+{
+    (void) adc;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA( ADC_HandleTypeDef* adc
+                                   , uint32_t*          data
+                                   , uint32_t           len
+                                   )
+{
+    (void) adc;
+    (void) len;
+
+    rmsbench_dma = (uint16_t*) data;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Stop_DMA( ADC_HandleTypeDef* adc )
+{
+    (void) adc;
+
+    return HAL_OK;
+}
+
+status_t tmr_adc_init( void )
+{
+    return STATUS_OK;
+}
+
+status_t tmr_adc_start( void )
+{
+    return STATUS_OK;
+}
+
+status_t tmr_adc_set_rate( uint32_t rate )
+{
+    rmsbench_rate = rate;
+
+    return STATUS_OK;
+}
+
+uint32_t tmr_adc_get_rate( void )
+{
+    return rmsbench_rate;
+}
+
+void get_time( Time_t* tv )
+{
+    *tv = rmsbench_time;
+}
+
+void wait( Time_t time, Time_Base_t base )
+{
+    (void) time;
+    (void) base;
+}
+
+void event_post( Event_Id_t id )
+{
+    (void) id;
+}
+
+/* No stored settings, the pipeline runs on its defaults */
+status_t flash_read( void* buff, uint32_t size, uint32_t offset )
+{
+    (void) buff;
+    (void) size;
+    (void) offset;
+
+    return STATUS_ERROR;
+}
+
+status_t flash_write( void* buff, uint32_t size, uint32_t offset )
+{
+    (void) buff;
+    (void) size;
+    (void) offset;
+
+    return STATUS_OK;
+}
+
+/* Hand a DMA half to the pipeline the way the DMA interrupt does */
+static void rmsbench_half( uint32_t half )
+{
+    rmsbench_time += 1000;
+
+    if ( 0 == half )
+    {
+        HAL_ADC_ConvHalfCpltCallback( rmsbench_hdl );
+    }
+    else
+    {
+        HAL_ADC_ConvCpltCallback( rmsbench_hdl );
+    }
+
+    adc_calc_rms();
+}
+
+static void rmsbench_window( Adc_Base_Rms_t* base, uint16_t len )
+{
+    uint8_t ch;
+
+    memset( base, 0, ADC_CH_NUM * sizeof( Adc_Base_Rms_t ));
+
+    for ( ch = 0; ch < ADC_CH_NUM; ch++ )
+    {
+        base[ch].req_samples = len;
+    }
+
+    adc_base_reset();
+    (void) adc_set_mode( ADC_MODE_DC, len );
+}
+
+/* Window lengths over the whole range, short ones more often */
+static uint16_t rmsbench_len( void )
+{
+    const uint32_t pick = (uint32_t) rand() % 100;
+    uint32_t       ret;
+
+    if ( pick < 50 )
+    {
+        ret = 1 + (uint32_t) rand() % 300;
+    }
+    else if ( pick < 85 )
+    {
+        ret = 301 + (uint32_t) rand() % ( 4096 - 300 );
+    }
+    else
+    {
+        ret = 4097 + (uint32_t) rand() % ( ADC_WIN_MAX - 4096 );
+    }
+
+    return (uint16_t) ret;
+}
+
+/* Uniform samples within a random band per channel, full scale at times */
+static void rmsbench_fill( uint16_t* frame, const uint16_t* lo
+                         , const uint16_t* hi
+                         )
+{
+    uint32_t i;
+    uint8_t  ch;
+
+    for ( i = 0; i < RMSBENCH_HALF; i += ADC_CH_NUM )
+    {
+        for ( ch = 0; ch < ADC_CH_NUM; ch++ )
+        {
+            frame[i + ch] = (uint16_t)( lo[ch] + (uint32_t) rand()
+                                        % ( hi[ch] - lo[ch] + 1U ));
+        }
+    }
+}
+
+static uint32_t rmsbench_compare( const Adc_Base_Rms_t* base
+                                , uint32_t              cfg
+                                , uint32_t              half
+                                )
+{
+    const Adc_Rms_t* rms;
+    uint32_t         ret = 0;
+    uint8_t          ch;
+
+    for ( ch = 0; ch < ADC_CH_NUM; ch++ )
+    {
+        rms = adc_get_rms( ch );
+
+        if (( base[ch].last     != rms->last     )
+         || ( base[ch].sum      != rms->sum      )
+         || ( base[ch].curr_cnt != rms->curr_cnt ))
+        {
+            printf( "mismatch: config %u, window %u, half %u, ch %u: "
+                    "last %u/%u sum %llu/%llu curr_cnt %u/%u\n"
+                  , (unsigned) cfg
+                  , (unsigned) base[ch].req_samples
+                  , (unsigned) half
+                  , (unsigned) ch
+                  , (unsigned) base[ch].last
+                  , (unsigned) rms->last
+                  , (unsigned long long) base[ch].sum
+                  , (unsigned long long) rms->sum
+                  , (unsigned) base[ch].curr_cnt
+                  , (unsigned) rms->curr_cnt
+                  );
+            ret++;
+        }
+    }
+
+    return ret;
+}
+
+/* Both paths on the same samples after every half buffer */
+static uint32_t rmsbench_check( uint32_t* halves, uint32_t* windows )
+{
+    Adc_Base_Rms_t base[ADC_CH_NUM];
+    uint16_t       lo[ADC_CH_NUM];
+    uint16_t       hi[ADC_CH_NUM];
+    uint32_t       ret = 0;
+    uint32_t       cfg;
+    uint32_t       num;
+    uint32_t       half;
+    uint32_t       last;
+    uint16_t       len;
+    uint16_t*      frame;
+    uint8_t        ch;
+
+    *halves  = 0;
+    *windows = 0;
+
+    for ( cfg = 0; ( cfg < RMSBENCH_CONFIGS ) && ( 0 == ret ); cfg++ )
+    {
+        len = rmsbench_len();
+        num = (( 2 * (uint32_t) len ) / ( RMSBENCH_HALF / ADC_CH_NUM )) + 1
+            + (uint32_t) rand() % RMSBENCH_EXTRA;
+
+        for ( ch = 0; ch < ADC_CH_NUM; ch++ )
+        {
+            lo[ch] = (uint16_t)( rand() % 4096 );
+            hi[ch] = (uint16_t)( lo[ch] + rand() % ( 4096 - lo[ch] ));
+
+            if ( 0 == ( rand() % 10 ))
+            {
+                lo[ch] = 0;
+                hi[ch] = 4095;
+            }
+        }
+
+        rmsbench_window( base, len );
+
+        for ( half = 0; ( half < num ) && ( 0 == ret ); half++ )
+        {
+            frame = &rmsbench_dma[( half & 1 ) * RMSBENCH_HALF];
+            last  = base[0].curr_cnt;
+
+            rmsbench_fill( frame, lo, hi );
+
+            adc_base_calc_rms( frame, base );
+            rmsbench_half( half & 1 );
+
+            ret += rmsbench_compare( base, cfg, half );
+
+            *windows += ( base[0].curr_cnt < last ) ? 1 : 0;
+        }
+
+        *halves += half;
+    }
+
+    return ret;
+}
+
+static void rmsbench_elapsed( const struct timespec* start
+                            , const struct timespec* stop
+                            , uint64_t               tsc
+                            , Rmsbench_Time_t*       t
+                            )
+{
+    t->ns  = ((double)( stop->tv_sec - start->tv_sec ) * 1e9
+           +  (double)( stop->tv_nsec - start->tv_nsec )) / RMSBENCH_HALVES;
+    t->tsc = tsc / RMSBENCH_HALVES;
+}
+
+/* Default window on full scale noise, both DMA halves stay as they are */
+static void rmsbench_time_paths( Rmsbench_Time_t* base_t
+                               , Rmsbench_Time_t* rms_t
+                               )
+{
+    static const uint16_t lo[ADC_CH_NUM] = { 0, 0 };
+    static const uint16_t hi[ADC_CH_NUM] = { 4095, 4095 };
+    Adc_Base_Rms_t        base[ADC_CH_NUM];
+    struct timespec       start;
+    struct timespec       stop;
+    uint64_t              tsc;
+    uint32_t              half;
+
+    rmsbench_fill( &rmsbench_dma[0], lo, hi );
+    rmsbench_fill( &rmsbench_dma[RMSBENCH_HALF], lo, hi );
+    rmsbench_window( base, ADC_DC_SAMPLES_DEF );
+
+    clock_gettime( CLOCK_MONOTONIC, &start );
+    tsc = RMSBENCH_TSC();
+
+    for ( half = 0; half < RMSBENCH_HALVES; half++ )
+    {
+        adc_base_calc_rms( &rmsbench_dma[( half & 1 ) * RMSBENCH_HALF], base );
+    }
+
+    tsc = RMSBENCH_TSC() - tsc;
+    clock_gettime( CLOCK_MONOTONIC, &stop );
+    rmsbench_elapsed( &start, &stop, tsc, base_t );
+
+    clock_gettime( CLOCK_MONOTONIC, &start );
+    tsc = RMSBENCH_TSC();
+
+    for ( half = 0; half < RMSBENCH_HALVES; half++ )
+    {
+        rmsbench_half( half & 1 );
+    }
+
+    tsc = RMSBENCH_TSC() - tsc;
+    clock_gettime( CLOCK_MONOTONIC, &stop );
+    rmsbench_elapsed( &start, &stop, tsc, rms_t );
+
+    /* Keeps the baseline loop from being dropped */
+    if ( base[0].last > 4096 )
+    {
+        printf( "baseline RMS out of range\n" );
+    }
+}
+
+int main( void )
+{
+    Rmsbench_Time_t base_t;
+    Rmsbench_Time_t rms_t;
+    uint32_t        halves;
+    uint32_t        windows;
+    uint32_t        fail;
+
+    srand( 1 );
+
+    if (( STATUS_OK != adc_init() ) || ( STATUS_OK != adc_start() ))
+    {
+        fprintf( stderr, "rmsbench: ADC start failed\n" );
+        return EXIT_FAILURE;
+    }
+
+    fail = rmsbench_check( &halves, &windows );
+
+    printf( "%u configurations, %u half buffers, %u windows: %s\n"
+          , (unsigned) RMSBENCH_CONFIGS
+          , (unsigned) halves
+          , (unsigned) windows
+          , ( 0 == fail ) ? "last/sum/curr_cnt identical" : "MISMATCH"
+          );
+
+    if ( 0 == fail )
+    {
+        rmsbench_time_paths( &base_t, &rms_t );
+
+        printf( "per %u sample half buffer, %u sample window:\n"
+              , (unsigned) RMSBENCH_HALF
+              , (unsigned) ADC_DC_SAMPLES_DEF
+              );
+        printf( "  double/sqrt() %8.1f ns %8llu TSC cycles\n"
+              , base_t.ns
+              , (unsigned long long) base_t.tsc
+              );
+        printf( "  isqrt pipeline %7.1f ns %8llu TSC cycles\n"
+              , rms_t.ns
+              , (unsigned long long) rms_t.tsc
+              );
+    }
+
+    return ( 0 == fail ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
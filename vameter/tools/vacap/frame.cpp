@@ -0,0 +1,132 @@
+/**
+ ** Name
+ **   frame.cpp
+ **
+ ** Purpose
+ **   Stream frame layout, CRC and COBS of the vameter sample stream
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "frame.h"
+
+#include <array>
+
+/* Byte table, the host runs far above line rate and has the memory */
+static const std::array<uint16_t, 256> frame_crc_tbl = []
+{
+    std::array<uint16_t, 256> tbl {};
+    uint16_t                  crc;
+
+    for ( unsigned i = 0; i < 256; i++ )
+    {
+        crc = (uint16_t)( i << 8 );
+
+        for ( int bit = 0; bit < 8; bit++ )
+        {
+            crc = ( crc & 0x8000 ) ? (uint16_t)(( crc << 1 ) ^ 0x1021 )
+                                   : (uint16_t)( crc << 1 );
+        }
+
+        tbl[i] = crc;
+    }
+
+    return tbl;
+}();
+
+uint16_t frame_crc16( const uint8_t* data, size_t size )
+{
+    uint16_t crc = 0xFFFF;
+
+    while ( size-- > 0 )
+    {
+        crc = (uint16_t)(( crc << 8 ) ^ frame_crc_tbl[( crc >> 8 ) ^ *data++] );
+    }
+
+    return crc;
+}
+
+long frame_cobs_decode( uint8_t* data, size_t size )
+{
+    long    ret = 0;
+    size_t  in  = 0;
+    size_t  out = 0;
+    uint8_t code;
+
+    while (( in < size ) && ( ret >= 0 ))
+    {
+        code = data[in++];
+
+        if (( 0 == code ) || (( in + code - 1 ) > size ))
+        {
+            ret = -1;
+        }
+        else
+        {
+            memmove( &data[out], &data[in], code - 1 );
+            out += code - 1;
+            in  += code - 1;
+
+            /* Implied zero, except after a full run and at the end */
+            if (( 0xFF != code ) && ( in < size ))
+            {
+                data[out++] = 0;
+            }
+        }
+    }
+
+    return ( ret < 0 ) ? ret : (long) out;
+}
+
+size_t frame_cobs_encode( const uint8_t* in, size_t size, uint8_t* out )
+{
+    size_t  code_pos = 0;
+    size_t  pos      = 1;
+    uint8_t code     = 1;
+
+    for ( size_t i = 0; i < size; i++ )
+    {
+        if ( 0 != in[i] )
+        {
+            out[pos++] = in[i];
+            code++;
+        }
+
+        if (( 0 == in[i] ) || ( 0xFF == code ))
+        {
+            out[code_pos] = code;
+            code_pos      = pos++;
+            code          = 1;
+        }
+    }
+
+    out[code_pos] = code;
+
+    return pos;
+}
+
+size_t frame_build( const Frame_Hdr& hdr, const uint16_t* samples, uint8_t* out )
+{
+    uint8_t  raw[FRAME_WIRE_MAX];
+    size_t   size = FRAME_HDR_SIZE;
+    size_t   n    = (size_t) hdr.count * hdr.ch_num;
+    uint16_t crc;
+
+    memcpy( raw, &hdr, FRAME_HDR_SIZE );
+
+    for ( size_t i = 0; i < n; i++ )
+    {
+        raw[size++] = (uint8_t) samples[i];
+        raw[size++] = (uint8_t)( samples[i] >> 8 );
+    }
+
+    crc         = frame_crc16( raw, size );
+    raw[size++] = (uint8_t) crc;
+    raw[size++] = (uint8_t)( crc >> 8 );
+
+    size        = frame_cobs_encode( raw, size, out );
+    out[size++] = 0;
+
+    return size;
+}
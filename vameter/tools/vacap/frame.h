@@ -0,0 +1,76 @@
+/**
+ ** Name
+ **   frame.h
+ **
+ ** Purpose
+ **   Stream frame layout, CRC and COBS of the vameter sample stream
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#ifndef __FRAME_H__
+#define __FRAME_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/* Mirrors Stream_Hdr_t of source/application/include/stream.h, all fields
+ * little endian. A frame is header, count x ch_num uint16_t samples and
+ * the CRC16 of both. On the wire it is COBS encoded and ends with 0x00.
+ */
+constexpr uint8_t  FRAME_VER      = 1;
+constexpr size_t   FRAME_HDR_SIZE = 12;
+constexpr size_t   FRAME_CH_MAX   = 2;
+constexpr size_t   FRAME_WIRE_MAX = 2048;   /* Longer segments are junk */
+
+struct Frame_Hdr
+{
+    uint8_t  ver;
+    uint8_t  ch_num;
+    uint16_t seq;
+    uint32_t fs;            /* ADC output rate, pairs/s, before dec */
+    uint8_t  shift;         /* Fractional bits of the samples */
+    uint8_t  dec;           /* Stream decimation ratio */
+    uint16_t count;         /* Sample pairs in the frame */
+};
+
+static_assert( sizeof( Frame_Hdr ) == FRAME_HDR_SIZE, "frame header layout" );
+
+/* Decoded frame, samples point into the read buffer */
+struct Frame
+{
+    Frame_Hdr      hdr;
+    const uint8_t* samples;
+
+    uint16_t sample( size_t pair, size_t ch ) const
+    {
+        const uint8_t* p = samples + ( pair * hdr.ch_num + ch ) * 2;
+
+        return (uint16_t)( p[0] | ( p[1] << 8 ));
+    }
+};
+
+/*
+ * CRC-16/CCITT, poly 0x1021, init 0xFFFF, same as crc16() on the device
+ */
+uint16_t frame_crc16( const uint8_t* data, size_t size );
+
+/*
+ * COBS decode in place, returns decoded size or -1 on a malformed segment.
+ * Decoded data is never longer than the input, so it can overwrite it.
+ */
+long frame_cobs_decode( uint8_t* data, size_t size );
+
+/*
+ * COBS encode, out needs size + size / 254 + 1 bytes. Returns encoded size.
+ */
+size_t frame_cobs_encode( const uint8_t* in, size_t size, uint8_t* out );
+
+/*
+ * Build a complete wire frame, delimiter included, returns its size
+ */
+size_t frame_build( const Frame_Hdr& hdr, const uint16_t* samples, uint8_t* out );
+
+#endif /* __FRAME_H__ */
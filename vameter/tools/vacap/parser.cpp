@@ -0,0 +1,116 @@
+/**
+ ** Name
+ **   parser.cpp
+ **
+ ** Purpose
+ **   Frame parser working in place on a large read buffer
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "parser.h"
+
+#include <cstring>
+
+Parser::Parser( size_t size, Frame_Cb cb )
+    : buff_( size )
+    , cb_( std::move( cb ))
+{
+}
+
+void Parser::segment( uint8_t* data, size_t size )
+{
+    Frame    frame;
+    long     len;
+    uint16_t gap;
+    bool     ok;
+
+    len = frame_cobs_decode( data, size );
+    ok  = ( len >= (long)( FRAME_HDR_SIZE + 2 ));
+
+    if ( ok )
+    {
+        memcpy( &frame.hdr, data, FRAME_HDR_SIZE );
+        frame.samples = data + FRAME_HDR_SIZE;
+
+        ok = ( FRAME_VER == frame.hdr.ver )
+          && ( 0 != frame.hdr.ch_num )
+          && ( frame.hdr.ch_num <= FRAME_CH_MAX )
+          && ( 0 != frame.hdr.dec )
+          && ( len == (long)( FRAME_HDR_SIZE + 2
+                            + (size_t) frame.hdr.count * frame.hdr.ch_num * 2 ));
+    }
+
+    if ( !ok )
+    {
+        stats_.fmt_err++;
+    }
+    else if ( frame_crc16( data, (size_t) len - 2 )
+           != (uint16_t)( data[len - 2] | ( data[len - 1] << 8 )))
+    {
+        stats_.crc_err++;
+    }
+    else
+    {
+        /* Frames of a gap are assumed to be as long as this one */
+        if ( have_seq_ )
+        {
+            gap = (uint16_t)( frame.hdr.seq - next_seq_ );
+
+            stats_.lost += gap;
+            index_      += (uint64_t) gap * frame.hdr.count;
+        }
+
+        have_seq_ = true;
+        next_seq_ = (uint16_t)( frame.hdr.seq + 1 );
+
+        stats_.frames++;
+        stats_.pairs += frame.hdr.count;
+
+        cb_( frame, index_ );
+
+        index_ += frame.hdr.count;
+    }
+}
+
+void Parser::commit( size_t n )
+{
+    uint8_t* start = buff_.data();
+    uint8_t* end   = start + fill_ + n;
+    uint8_t* scan  = start + fill_;
+    uint8_t* delim;
+
+    stats_.bytes += n;
+
+    while ( nullptr != ( delim = (uint8_t*) memchr( scan, 0, end - scan )))
+    {
+        if ( !synced_ )
+        {
+            /* Whatever came before the stream, CLI text for instance */
+            stats_.skipped += delim - start;
+            synced_         = true;
+        }
+        else if ( delim > start )
+        {
+            segment( start, delim - start );
+        }
+
+        start = delim + 1;
+        scan  = start;
+    }
+
+    fill_ = end - start;
+
+    /* A segment filling the buffer is no frame, drop it */
+    if ( fill_ > FRAME_WIRE_MAX )
+    {
+        stats_.fmt_err += synced_ ? 1 : 0;
+        stats_.skipped += synced_ ? 0 : fill_;
+        fill_           = 0;
+    }
+    else if ( start != buff_.data())
+    {
+        memmove( buff_.data(), start, fill_ );
+    }
+}
@@ -0,0 +1,66 @@
+/**
+ ** Name
+ **   parser.h
+ **
+ ** Purpose
+ **   Frame parser working in place on a large read buffer
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#ifndef __PARSER_H__
+#define __PARSER_H__
+
+#include "frame.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+struct Parser_Stats
+{
+    uint64_t bytes   = 0;   /* Bytes received */
+    uint64_t frames  = 0;   /* Valid frames */
+    uint64_t pairs   = 0;   /* Sample pairs in valid frames */
+    uint64_t lost    = 0;   /* Frames missing by sequence number */
+    uint64_t crc_err = 0;
+    uint64_t fmt_err = 0;   /* Bad COBS, length or version */
+    uint64_t skipped = 0;   /* Bytes ahead of the first delimiter */
+};
+
+/* Data is read straight into the buffer. Complete segments are COBS
+ * decoded where they are and handed out as views, only the incomplete
+ * tail of a read is moved to the front for the next one.
+ */
+class Parser
+{
+public:
+    using Frame_Cb = std::function<void ( const Frame& frame, uint64_t index )>;
+
+    Parser( size_t size, Frame_Cb cb );
+
+    uint8_t* space( void )      { return &buff_[fill_]; }
+    size_t   space_size( void ) { return buff_.size() - fill_; }
+
+    /*
+     * Parse n more bytes written to space()
+     */
+    void commit( size_t n );
+
+    const Parser_Stats& stats( void ) const { return stats_; }
+
+private:
+    void segment( uint8_t* data, size_t size );
+
+    std::vector<uint8_t> buff_;
+    size_t               fill_     = 0;
+    bool                 synced_   = false; /* First delimiter seen */
+    bool                 have_seq_ = false;
+    uint16_t             next_seq_ = 0;
+    uint64_t             index_    = 0;     /* Output pairs incl. lost */
+    Frame_Cb             cb_;
+    Parser_Stats         stats_;
+};
+
+#endif /* __PARSER_H__ */
@@ -0,0 +1,407 @@
+/**
+ ** Name
+ **   vacap.cpp
+ **
+ ** Purpose
+ **   Capture of the vameter sample stream, see "stream start" on the device
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "frame.h"
+#include "parser.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define VACAP_BUFF_SIZE (4u << 20)  /* Read buffer */
+#define VACAP_FILE_BUFF (1u << 20)  /* stdio buffer per output file */
+
+/* Channel zero and scale as used by the device, see adc.h */
+struct Vacap_Ch
+{
+    const char* name;
+    const char* unit;
+    double      zero;       /* ADC counts */
+    double      scale;      /* Unit per count */
+};
+
+static const Vacap_Ch vacap_ch[FRAME_CH_MAX] =
+{
+    { "I", "A", 2048.0, 18311e-6 },
+    { "V", "V", 0.0,    8057e-6  }
+};
+
+/* Samples and RMS accumulators of one statistics interval */
+struct Vacap_Acc
+{
+    uint64_t pairs = 0;
+    double   sum2[FRAME_CH_MAX] = {};
+};
+
+enum class Vacap_Fmt
+{
+    NONE,
+    CSV,
+    COL
+};
+
+struct Vacap_Out
+{
+    Vacap_Fmt fmt  = Vacap_Fmt::NONE;
+    FILE*     file = nullptr;                 /* CSV or frame table */
+    FILE*     col[FRAME_CH_MAX] = {};         /* One column per channel */
+};
+
+static void vacap_usage( void )
+{
+    fprintf( stderr
+           , "usage: vacap [-b baud] [-o prefix] [-f csv|col] [-i s] [-t s]\n"
+             "             [-q] <tty|file|->\n"
+             "  -b  baud rate when reading a tty, 115200 by default\n"
+             "  -o  output prefix, <prefix>.csv or <prefix>.frm/.ch<n>\n"
+             "  -f  csv rows or columnar binary, csv by default\n"
+             "  -i  statistics interval, 1 s by default\n"
+             "  -t  stop after s seconds\n"
+             "  -q  summary only, no live statistics\n"
+           );
+}
+
+static speed_t vacap_baud( long baud )
+{
+    switch ( baud )
+    {
+        case 9600:   return B9600;
+        case 19200:  return B19200;
+        case 38400:  return B38400;
+        case 57600:  return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+        case 460800: return B460800;
+        case 921600: return B921600;
+        default:     return B0;
+    }
+}
+
+static int vacap_open( const char* path, long baud )
+{
+    struct termios tio;
+    int            fd;
+
+    if ( 0 == strcmp( path, "-" ))
+    {
+        return STDIN_FILENO;
+    }
+
+    fd = open( path, O_RDONLY | O_NOCTTY );
+
+    if (( fd >= 0 ) && isatty( fd ))
+    {
+        if (( 0 != tcgetattr( fd, &tio ))
+         || ( B0 == vacap_baud( baud )))
+        {
+            fprintf( stderr, "vacap: %s: can't set %ld baud\n", path, baud );
+            close( fd );
+            fd = -1;
+        }
+        else
+        {
+            cfmakeraw( &tio );
+            cfsetispeed( &tio, vacap_baud( baud ));
+            cfsetospeed( &tio, vacap_baud( baud ));
+            tio.c_cc[VMIN]  = 1;
+            tio.c_cc[VTIME] = 0;
+            tcsetattr( fd, TCSANOW, &tio );
+            tcflush( fd, TCIFLUSH );
+        }
+    }
+
+    return fd;
+}
+
+static FILE* vacap_fopen( const std::string& name )
+{
+    FILE* file = fopen( name.c_str(), "wb" );
+
+    if ( nullptr == file )
+    {
+        perror( name.c_str());
+        exit( EXIT_FAILURE );
+    }
+
+    setvbuf( file, nullptr, _IOFBF, VACAP_FILE_BUFF );
+
+    return file;
+}
+
+/* Columnar layout: <prefix>.frm holds one row per frame, index of the
+ * first pair (u64), seq (u16), count (u16), fs (u32), shift (u8), dec (u8)
+ * and 2 pad bytes. <prefix>.ch<n> hold the samples of channel n as u16,
+ * pairs of lost frames are not filled in.
+ */
+static void vacap_write( Vacap_Out& out, const Frame& frame, uint64_t index )
+{
+    uint16_t buff[256];
+    uint8_t  row[20] = {};
+    size_t   n;
+
+    if ( Vacap_Fmt::CSV == out.fmt )
+    {
+        for ( size_t i = 0; i < frame.hdr.count; i++ )
+        {
+            fprintf( out.file
+                   , "%llu,%.6f"
+                   , (unsigned long long)( index + i )
+                   , (double)( index + i ) * frame.hdr.dec / frame.hdr.fs
+                   );
+
+            for ( size_t ch = 0; ch < frame.hdr.ch_num; ch++ )
+            {
+                fprintf( out.file, ",%u", frame.sample( i, ch ));
+            }
+
+            fputc( '\n', out.file );
+        }
+    }
+    else if ( Vacap_Fmt::COL == out.fmt )
+    {
+        memcpy( &row[0],  &index,            8 );
+        memcpy( &row[8],  &frame.hdr.seq,    2 );
+        memcpy( &row[10], &frame.hdr.count,  2 );
+        memcpy( &row[12], &frame.hdr.fs,     4 );
+        memcpy( &row[16], &frame.hdr.shift,  1 );
+        memcpy( &row[17], &frame.hdr.dec,    1 );
+        fwrite( row, sizeof( row ), 1, out.file );
+
+        for ( size_t ch = 0; ch < frame.hdr.ch_num; ch++ )
+        {
+            for ( size_t i = 0; i < frame.hdr.count; i += n )
+            {
+                n = frame.hdr.count - i;
+                n = ( n > 256 ) ? 256 : n;
+
+                for ( size_t k = 0; k < n; k++ )
+                {
+                    buff[k] = frame.sample( i + k, ch );
+                }
+
+                fwrite( buff, sizeof( uint16_t ), n, out.col[ch] );
+            }
+        }
+    }
+}
+
+static void vacap_print( const Parser_Stats& now
+                       , const Parser_Stats& last
+                       , const Vacap_Acc&    acc
+                       , double              secs
+                       , const char*         end
+                       )
+{
+    const uint64_t expected = ( now.frames + now.lost )
+                            - ( last.frames + last.lost );
+    double         loss     = 0.0;
+
+    if ( 0 != expected )
+    {
+        loss = 100.0 * (double)( now.lost - last.lost ) / (double) expected;
+    }
+
+    fprintf( stderr
+           , "%8.1f kB/s %7.0f frm/s %8.0f pairs/s loss %5.2f %% "
+             "crc %llu fmt %llu"
+           , (double)( now.bytes - last.bytes ) / secs / 1000.0
+           , (double)( now.frames - last.frames ) / secs
+           , (double)( now.pairs - last.pairs ) / secs
+           , loss
+           , (unsigned long long) now.crc_err
+           , (unsigned long long) now.fmt_err
+           );
+
+    for ( size_t ch = 0; ( ch < FRAME_CH_MAX ) && ( 0 != acc.pairs ); ch++ )
+    {
+        fprintf( stderr
+               , " %s %.3f %s"
+               , vacap_ch[ch].name
+               , std::sqrt( acc.sum2[ch] / (double) acc.pairs )
+                 * vacap_ch[ch].scale
+               , vacap_ch[ch].unit
+               );
+    }
+
+    fputs( end, stderr );
+}
+
+int main( int argc, char** argv )
+{
+    using Clock = std::chrono::steady_clock;
+
+    Vacap_Out    out;
+    Vacap_Acc    acc;
+    Vacap_Acc    total;
+    Parser_Stats last;
+    std::string  prefix;
+    const char*  fmt      = "csv";
+    long         baud     = 115200;
+    double       interval = 1.0;
+    double       limit    = 0.0;
+    bool         quiet    = false;
+    int          fd;
+    int          opt;
+    ssize_t      n;
+
+    while ( -1 != ( opt = getopt( argc, argv, "b:o:f:i:t:qh" )))
+    {
+        switch ( opt )
+        {
+            case 'b': baud     = strtol( optarg, nullptr, 10 ); break;
+            case 'o': prefix   = optarg;                        break;
+            case 'f': fmt      = optarg;                        break;
+            case 'i': interval = strtod( optarg, nullptr );     break;
+            case 't': limit    = strtod( optarg, nullptr );     break;
+            case 'q': quiet    = true;                          break;
+            default:  vacap_usage(); return EXIT_FAILURE;
+        }
+    }
+
+    if (( optind + 1 != argc ) || ( interval <= 0.0 ))
+    {
+        vacap_usage();
+        return EXIT_FAILURE;
+    }
+
+    fd = vacap_open( argv[optind], baud );
+
+    if ( fd < 0 )
+    {
+        perror( argv[optind] );
+        return EXIT_FAILURE;
+    }
+
+    if ( !prefix.empty())
+    {
+        if ( 0 == strcmp( fmt, "csv" ))
+        {
+            out.fmt  = Vacap_Fmt::CSV;
+            out.file = vacap_fopen( prefix + ".csv" );
+            fprintf( out.file, "index,time_s,ch0,ch1\n" );
+        }
+        else if ( 0 == strcmp( fmt, "col" ))
+        {
+            out.fmt  = Vacap_Fmt::COL;
+            out.file = vacap_fopen( prefix + ".frm" );
+
+            for ( size_t ch = 0; ch < FRAME_CH_MAX; ch++ )
+            {
+                out.col[ch] = vacap_fopen( prefix + ".ch" + std::to_string( ch ));
+            }
+        }
+        else
+        {
+            vacap_usage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    Parser parser( VACAP_BUFF_SIZE, [&]( const Frame& frame, uint64_t index )
+    {
+        double val;
+
+        vacap_write( out, frame, index );
+
+        for ( size_t i = 0; i < frame.hdr.count; i++ )
+        {
+            for ( size_t ch = 0; ch < frame.hdr.ch_num; ch++ )
+            {
+                val = std::ldexp( frame.sample( i, ch ), -frame.hdr.shift )
+                    - vacap_ch[ch].zero;
+
+                acc.sum2[ch]   += val * val;
+                total.sum2[ch] += val * val;
+            }
+        }
+
+        acc.pairs   += frame.hdr.count;
+        total.pairs += frame.hdr.count;
+    });
+
+    const Clock::time_point start = Clock::now();
+    Clock::time_point       tick  = start;
+    struct pollfd           pfd   = { fd, POLLIN, 0 };
+    double                  secs;
+
+    for ( ;; )
+    {
+        n = 0;
+
+        if ( poll( &pfd, 1, 100 ) > 0 )
+        {
+            n = read( fd, parser.space(), parser.space_size());
+
+            if ( n <= 0 )
+            {
+                break;
+            }
+
+            parser.commit( (size_t) n );
+        }
+
+        secs = std::chrono::duration<double>( Clock::now() - tick ).count();
+
+        if ( !quiet && ( secs >= interval ))
+        {
+            vacap_print( parser.stats(), last, acc, secs, "\n" );
+
+            last = parser.stats();
+            acc  = Vacap_Acc();
+            tick = Clock::now();
+        }
+
+        if (( limit > 0.0 )
+         && ( std::chrono::duration<double>( Clock::now() - start ).count()
+                >= limit ))
+        {
+            break;
+        }
+    }
+
+    secs = std::chrono::duration<double>( Clock::now() - start ).count();
+
+    fprintf( stderr
+           , "total %llu bytes, %llu frames, %llu lost, %llu crc, %llu fmt, "
+             "%llu skipped in %.2f s\n"
+           , (unsigned long long) parser.stats().bytes
+           , (unsigned long long) parser.stats().frames
+           , (unsigned long long) parser.stats().lost
+           , (unsigned long long) parser.stats().crc_err
+           , (unsigned long long) parser.stats().fmt_err
+           , (unsigned long long) parser.stats().skipped
+           , secs
+           );
+    vacap_print( parser.stats(), Parser_Stats(), total, secs, "\n" );
+
+    if ( nullptr != out.file )
+    {
+        fclose( out.file );
+    }
+
+    for ( size_t ch = 0; ch < FRAME_CH_MAX; ch++ )
+    {
+        if ( nullptr != out.col[ch] )
+        {
+            fclose( out.col[ch] );
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,207 @@
+/**
+ ** Name
+ **   vagen.cpp
+ **
+ ** Purpose
+ **   Synthetic vameter sample stream for load tests of vacap
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include "frame.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#define VAGEN_PAIRS     (48)        /* Pairs per frame, as the device */
+#define VAGEN_CHUNK     (1u << 16)  /* Bytes per write */
+#define VAGEN_LINE_HZ   (50.0)
+
+static void vagen_usage( void )
+{
+    fprintf( stderr
+           , "usage: vagen [-n frames] [-r pairs/s] [-s fs] [-d dec]\n"
+             "             [-l loss] [-e errors] [-p] [-o file]\n"
+             "  -n  frames to send, endless by default\n"
+             "  -r  pace to pairs/s, as fast as possible by default\n"
+             "  -s  ADC rate in the headers, 2400 by default\n"
+             "  -d  stream decimation in the headers, 1 by default\n"
+             "  -l  frames per mille to skip, counted as lost by vacap\n"
+             "  -e  frames per mille with a flipped bit\n"
+             "  -p  write to a new pty and print its name\n"
+             "  -o  output file, stdout by default\n"
+           );
+}
+
+static int vagen_pty( void )
+{
+    int fd = posix_openpt( O_RDWR | O_NOCTTY );
+
+    if (( fd < 0 ) || ( 0 != grantpt( fd )) || ( 0 != unlockpt( fd )))
+    {
+        perror( "vagen: pty" );
+        exit( EXIT_FAILURE );
+    }
+
+    fprintf( stderr, "vagen: writing to %s\n", ptsname( fd ));
+
+    return fd;
+}
+
+static void vagen_write( int fd, const uint8_t* data, size_t size )
+{
+    ssize_t n;
+
+    while ( size > 0 )
+    {
+        n = write( fd, data, size );
+
+        if ( n <= 0 )
+        {
+            exit( EXIT_SUCCESS );   /* Reader went away */
+        }
+
+        data += n;
+        size -= (size_t) n;
+    }
+}
+
+int main( int argc, char** argv )
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<uint8_t>               out;
+    std::mt19937                       rng( 1 );
+    std::uniform_int_distribution<int> permille( 0, 999 );
+    Frame_Hdr                          hdr {};
+    uint16_t                           samples[VAGEN_PAIRS * 2];
+    uint8_t                            wire[FRAME_WIRE_MAX];
+    uint64_t                           frames = 0;
+    uint64_t                           limit  = 0;
+    uint64_t                           sent   = 0;
+    double                             rate   = 0.0;
+    double                             phase  = 0.0;
+    double                             step;
+    long                               fs     = 2400;
+    long                               dec    = 1;
+    int                                loss   = 0;
+    int                                errors = 0;
+    int                                fd     = STDOUT_FILENO;
+    int                                opt;
+    size_t                             size;
+
+    while ( -1 != ( opt = getopt( argc, argv, "n:r:s:d:l:e:po:h" )))
+    {
+        switch ( opt )
+        {
+            case 'n': limit  = strtoull( optarg, nullptr, 10 ); break;
+            case 'r': rate   = strtod( optarg, nullptr );       break;
+            case 's': fs     = strtol( optarg, nullptr, 10 );   break;
+            case 'd': dec    = strtol( optarg, nullptr, 10 );   break;
+            case 'l': loss   = atoi( optarg );                  break;
+            case 'e': errors = atoi( optarg );                  break;
+            case 'p': fd     = vagen_pty();                     break;
+            case 'o':
+                fd = open( optarg, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+
+                if ( fd < 0 )
+                {
+                    perror( optarg );
+                    return EXIT_FAILURE;
+                }
+                break;
+            default: vagen_usage(); return EXIT_FAILURE;
+        }
+    }
+
+    if (( fs <= 0 ) || ( dec <= 0 ) || ( dec > 255 ))
+    {
+        vagen_usage();
+        return EXIT_FAILURE;
+    }
+
+    hdr.ver    = FRAME_VER;
+    hdr.ch_num = 2;
+    hdr.fs     = (uint32_t) fs;
+    hdr.dec    = (uint8_t) dec;
+    hdr.count  = VAGEN_PAIRS;
+
+    step = 2.0 * M_PI * VAGEN_LINE_HZ * (double) dec / (double) fs;
+
+    /* Stream starts after a delimiter, junk ahead of it is ignored */
+    out.reserve( VAGEN_CHUNK + FRAME_WIRE_MAX );
+    out.push_back( 0 );
+
+    const Clock::time_point start = Clock::now();
+
+    while (( 0 == limit ) || ( frames < limit ))
+    {
+        /* Current through the ACS71240 around mid scale, voltage rectified
+         * by the divider
+         */
+        for ( size_t i = 0; i < VAGEN_PAIRS; i++ )
+        {
+            const double s = std::sin( phase );
+
+            samples[2 * i]     = (uint16_t)( 2048.0 + 800.0 * s );
+            samples[2 * i + 1] = (uint16_t)( 1500.0 * std::fabs( s ));
+            phase             += step;
+        }
+
+        phase = std::fmod( phase, 2.0 * M_PI );
+
+        hdr.seq = (uint16_t) frames++;
+
+        if (( 0 != loss ) && ( permille( rng ) < loss ))
+        {
+            continue;
+        }
+
+        size = frame_build( hdr, samples, wire );
+
+        if (( 0 != errors ) && ( permille( rng ) < errors ))
+        {
+            wire[1 + ( rng() % ( size - 3 ))] ^= 0x10;
+        }
+
+        out.insert( out.end(), wire, wire + size );
+
+        if ( out.size() >= VAGEN_CHUNK )
+        {
+            vagen_write( fd, out.data(), out.size());
+            sent += out.size();
+            out.clear();
+
+            if ( rate > 0.0 )
+            {
+                std::this_thread::sleep_until
+                    ( start
+                    + std::chrono::duration_cast<Clock::duration>
+                        ( std::chrono::duration<double>
+                            ((double)( frames * VAGEN_PAIRS ) / rate )));
+            }
+        }
+    }
+
+    vagen_write( fd, out.data(), out.size());
+    sent += out.size();
+
+    fprintf( stderr
+           , "vagen: %llu frames, %llu bytes in %.2f s\n"
+           , (unsigned long long) frames
+           , (unsigned long long) sent
+           , std::chrono::duration<double>( Clock::now() - start ).count()
+           );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,252 @@
+/**
+ ** Name
+ **   vatrace.c
+ **
+ ** Purpose
+ **   Convert a vameter "trace dump" into Chrome trace event JSON
+ **
+ ** Revision
+ **   18-Oct-2026 (SSB) [] Initial
+ **/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Mirrors Trace_Hdr_t and Trace_Rec_t of source/application/include/trace.h,
+ * little endian
+ */
+#define VATRACE_MAGIC    (0x43525456)   /* "VTRC" */
+#define VATRACE_VER      (1)
+#define VATRACE_HDR_SIZE (12)
+#define VATRACE_REC_SIZE (8)
+
+#define VATRACE_TYPE_MARK  (0)
+#define VATRACE_TYPE_BEGIN (1)
+#define VATRACE_TYPE_END   (2)
+
+#define VATRACE_TID_MAIN (0)
+#define VATRACE_TID_IRQ  (1)
+
+typedef struct
+{
+    const char* name;
+    int         tid;
+} Vatrace_Id_t;
+
+/* Trace_Id_t, same order */
+static const Vatrace_Id_t vatrace_id[] =
+{
+    { "sleep",     VATRACE_TID_MAIN },
+    { "event",     VATRACE_TID_MAIN },
+    { "adc half",  VATRACE_TID_IRQ  },
+    { "disp irq",  VATRACE_TID_IRQ  },
+    { "uart1 irq", VATRACE_TID_IRQ  },
+    { "uart2 irq", VATRACE_TID_IRQ  },
+    { "uart1 tx",  VATRACE_TID_IRQ  }
+};
+
+#define VATRACE_ID_NUM ( sizeof( vatrace_id ) / sizeof( vatrace_id[0] ))
+
+/* Event_Id_t of event.h, names the TRACE_EVENT slices */
+static const char* const vatrace_event[] =
+{
+    "adc",
+    "uart1 rx",
+    "uart2 rx",
+    "tick"
+};
+
+#define VATRACE_EVENT_NUM \
+    ( sizeof( vatrace_event ) / sizeof( vatrace_event[0] ))
+
+static uint32_t vatrace_u32( const uint8_t* p )
+{
+    return (uint32_t) p[0]
+         | ((uint32_t) p[1] << 8 )
+         | ((uint32_t) p[2] << 16 )
+         | ((uint32_t) p[3] << 24 );
+}
+
+static uint16_t vatrace_u16( const uint8_t* p )
+{
+    return (uint16_t)( p[0] | ( p[1] << 8 ));
+}
+
+static uint8_t* vatrace_read( FILE* in, size_t* size )
+{
+    uint8_t* data = NULL;
+    size_t   cap  = 0;
+    size_t   n;
+
+    *size = 0;
+
+    do
+    {
+        if ( *size == cap )
+        {
+            cap  = ( 0 == cap ) ? 4096 : 2 * cap;
+            data = realloc( data, cap );
+
+            if ( NULL == data )
+            {
+                perror( "vatrace" );
+                exit( EXIT_FAILURE );
+            }
+        }
+
+        n      = fread( data + *size, 1, cap - *size, in );
+        *size += n;
+    } while ( 0 != n );
+
+    return data;
+}
+
+/* The dump follows the CLI echo, find its header */
+static const uint8_t* vatrace_find( const uint8_t* data, size_t size )
+{
+    const uint8_t* ret = NULL;
+    size_t         i;
+
+    for ( i = 0; ( i + VATRACE_HDR_SIZE ) <= size; i++ )
+    {
+        if (( VATRACE_MAGIC == vatrace_u32( &data[i] ))
+         && ( VATRACE_VER == vatrace_u16( &data[i + 4] )))
+        {
+            ret = &data[i];
+            break;
+        }
+    }
+
+    return ret;
+}
+
+static void vatrace_name( const uint8_t* rec, char* name, size_t size )
+{
+    const uint8_t  id  = rec[4];
+    const uint16_t arg = vatrace_u16( &rec[6] );
+
+    if (( 1 == id ) && ( arg < VATRACE_EVENT_NUM ))
+    {
+        snprintf( name, size, "event %s", vatrace_event[arg] );
+    }
+    else if ( id < VATRACE_ID_NUM )
+    {
+        snprintf( name, size, "%s", vatrace_id[id].name );
+    }
+    else
+    {
+        snprintf( name, size, "id %u", id );
+    }
+}
+
+int main( int argc, char** argv )
+{
+    static const char ph[] = { 'i', 'B', 'E' };
+    const uint8_t*    hdr;
+    const uint8_t*    rec;
+    uint8_t*          data;
+    FILE*             in  = stdin;
+    FILE*             out = stdout;
+    size_t            size;
+    uint32_t          count;
+    uint32_t          hz;
+    uint32_t          i;
+    uint32_t          prev = 0;
+    int64_t           time = 0;
+    char              name[32];
+
+    if ( argc > 3 )
+    {
+        fprintf( stderr, "usage: vatrace [dump|-] [out.json]\n" );
+        return EXIT_FAILURE;
+    }
+
+    if (( argc > 1 ) && ( 0 != strcmp( argv[1], "-" )))
+    {
+        in = fopen( argv[1], "rb" );
+    }
+
+    if (( argc > 2 ) && ( NULL != in ))
+    {
+        out = fopen( argv[2], "w" );
+    }
+
+    if (( NULL == in ) || ( NULL == out ))
+    {
+        perror( "vatrace" );
+        return EXIT_FAILURE;
+    }
+
+    data = vatrace_read( in, &size );
+    hdr  = vatrace_find( data, size );
+
+    if ( NULL == hdr )
+    {
+        fprintf( stderr, "vatrace: no trace header found\n" );
+        return EXIT_FAILURE;
+    }
+
+    count = vatrace_u16( &hdr[6] );
+    hz    = vatrace_u32( &hdr[8] );
+
+    if (( 0 == hz )
+     || ((size_t)( hdr - data ) + VATRACE_HDR_SIZE + ( count * VATRACE_REC_SIZE )
+            > size ))
+    {
+        fprintf( stderr, "vatrace: dump truncated\n" );
+        return EXIT_FAILURE;
+    }
+
+    fprintf( out
+           , "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+             "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,"
+             "\"args\":{\"name\":\"main\"}},\n"
+             "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,"
+             "\"args\":{\"name\":\"irq\"}}"
+           , VATRACE_TID_MAIN
+           , VATRACE_TID_IRQ
+           );
+
+    rec = hdr + VATRACE_HDR_SIZE;
+
+    for ( i = 0; i < count; i++, rec += VATRACE_REC_SIZE )
+    {
+        /* Wrapping 32-bit ticks, records may be out of order by a
+         * preempting interrupt, so the step is signed
+         */
+        if ( 0 != i )
+        {
+            time += (int32_t)( vatrace_u32( rec ) - prev );
+        }
+
+        prev = vatrace_u32( rec );
+
+        vatrace_name( rec, name, sizeof( name ));
+
+        fprintf( out
+               , ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":0,"
+                 "\"tid\":%d%s\"args\":{\"arg\":%u}}"
+               , name
+               , ( rec[5] <= VATRACE_TYPE_END ) ? ph[rec[5]] : 'i'
+               , (double) time * 1e6 / hz
+               , ( rec[4] < VATRACE_ID_NUM ) ? vatrace_id[rec[4]].tid
+                                              : VATRACE_TID_IRQ
+               , ( VATRACE_TYPE_MARK == rec[5] ) ? ",\"s\":\"t\"," : ","
+               , vatrace_u16( &rec[6] )
+               );
+    }
+
+    fprintf( out, "\n]}\n" );
+    fprintf( stderr
+           , "vatrace: %u records, %.3f ms at %u Hz\n"
+           , count
+           , (double) time * 1e3 / hz
+           , hz
+           );
+
+    free( data );
+
+    return EXIT_SUCCESS;
+}